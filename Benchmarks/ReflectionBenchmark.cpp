@@ -0,0 +1,474 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+/**
+ * Reflection serialization benchmark
+ *
+ * Serializes and deserializes representative reflected types, in binary and JSON
+ * form, against a MemoryStream and a FileStream. Reports MB/s, ns per object and
+ * allocation counts, and writes the results as JSON so runs can be compared.
+ *
+ * Usage: CoreReflectionBenchmark [objectCount] [iterations] [results.json]
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <cstdio>
+#include <new>
+
+/* Every allocation done through greaper allocators, cJSON and operator new is counted */
+static std::atomic<unsigned long long> gAllocationCount{ 0 };
+
+static void* CountedAlloc(size_t bytes)
+{
+	gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+	return ::malloc(bytes);
+}
+
+#define PlatformAlloc(bytes) CountedAlloc(bytes)
+#define PlatformDealloc(mem) ::free(mem)
+
+void* operator new(size_t bytes)
+{
+	void* mem = CountedAlloc(bytes == 0 ? 1 : bytes);
+	if (mem == nullptr)
+		throw std::bad_alloc();
+	return mem;
+}
+void operator delete(void* mem)noexcept { ::free(mem); }
+void operator delete(void* mem, size_t)noexcept { ::free(mem); }
+
+#include "../Public/Reflection/Serialization.h"
+#include "../Public/FileStream.h"
+#include <filesystem>
+
+using namespace greaper;
+
+/***********************************************************************************
+*                                 BENCHMARK TYPES                                  *
+***********************************************************************************/
+
+struct BenchPlainStruct
+{
+	int32 ID = 0;
+	float X = 0.f, Y = 0.f, Z = 0.f;
+	uint64 Flags = 0;
+	double Weight = 0.0;
+};
+
+using BenchNestedVector = Vector<Vector<int32>>;
+using BenchStringMap = Map<String, String>;
+using BenchArray = std::array<float, 16>;
+
+CREATE_TYPEINFO(BenchPlainStruct, (greaper::refl::CoreReflectedTypeID)1000, ComplexType);
+
+#define BENCH_FIELD(type, member)\
+	(SPtr<refl::IField>)ConstructShared<refl::TField<type>>(#member##sv,\
+	(std::function<const void* (const void*)>)[](const void* obj) -> const void* { return &(((const BenchPlainStruct*)obj)->member); },\
+	(std::function<void(void*, const void*)>)[](void* obj, const void* value) { ((BenchPlainStruct*)obj)->member = *((const type*)value); })
+
+namespace greaper::refl
+{
+	template<>
+	const Vector<SPtr<IField>> ComplexType<BenchPlainStruct>::Fields = Vector<SPtr<IField>>({
+		BENCH_FIELD(int32, ID),
+		BENCH_FIELD(float, X),
+		BENCH_FIELD(float, Y),
+		BENCH_FIELD(float, Z),
+		BENCH_FIELD(uint64, Flags),
+		BENCH_FIELD(double, Weight),
+	});
+}
+
+/***********************************************************************************
+*                                  DATA GENERATION                                 *
+***********************************************************************************/
+
+static uint64 gRandomState = 0x9E3779B97F4A7C15ull;
+
+static uint32 NextRandom()
+{
+	gRandomState = gRandomState * 6364136223846793005ull + 1442695040888963407ull;
+	return (uint32)(gRandomState >> 33);
+}
+
+static String RandomString(sizet minLength, sizet maxLength)
+{
+	const sizet length = minLength + NextRandom() % (maxLength - minLength + 1);
+	String str(length, ' ');
+	for (auto& c : str)
+		c = (achar)('a' + NextRandom() % 26);
+	return str;
+}
+
+static void Generate(BenchPlainStruct& obj)
+{
+	obj.ID = (int32)NextRandom();
+	obj.X = (float)NextRandom() / 1000.f;
+	obj.Y = (float)NextRandom() / 1000.f;
+	obj.Z = (float)NextRandom() / 1000.f;
+	obj.Flags = ((uint64)NextRandom() << 32) | NextRandom();
+	obj.Weight = (double)NextRandom() / 3.0;
+}
+
+static void Generate(BenchNestedVector& obj)
+{
+	obj.resize(4 + NextRandom() % 8);
+	for (auto& inner : obj)
+	{
+		inner.resize(8 + NextRandom() % 24);
+		for (auto& v : inner)
+			v = (int32)NextRandom();
+	}
+}
+
+static void Generate(BenchStringMap& obj)
+{
+	const sizet count = 4 + NextRandom() % 12;
+	for (sizet i = 0; i < count; ++i)
+		obj.insert_or_assign(RandomString(4, 16), RandomString(8, 48));
+}
+
+static void Generate(BenchArray& obj)
+{
+	for (auto& v : obj)
+		v = (float)NextRandom() / 7.f;
+}
+
+/***********************************************************************************
+*                                  MEASUREMENTS                                    *
+***********************************************************************************/
+
+struct BenchPhase
+{
+	double Nanoseconds = 0.0;
+	int64 Bytes = 0;
+	uint64 Allocations = 0;
+};
+
+struct BenchResult
+{
+	String TypeName;
+	String Format;
+	String Stream;
+	sizet ObjectCount = 0;
+	BenchPhase Write;
+	BenchPhase Read;
+	bool Valid = true;
+	String FailMessage;
+};
+
+static const std::filesystem::path& GetBenchFilePath()
+{
+	static const std::filesystem::path path = std::filesystem::temp_directory_path() / "greaper_refl_bench.bin";
+	return path;
+}
+
+/* Measures fn and stores the minimum time among all iterations */
+template<class Fn>
+static void MeasurePhase(BenchPhase& phase, sizet iterations, Fn&& fn)
+{
+	phase.Nanoseconds = -1.0;
+	for (sizet i = 0; i < iterations; ++i)
+	{
+		const auto allocsBefore = gAllocationCount.load(std::memory_order_relaxed);
+		const auto start = Clock_t::now();
+		const int64 bytes = fn();
+		const auto end = Clock_t::now();
+		const auto allocs = gAllocationCount.load(std::memory_order_relaxed) - allocsBefore;
+		const double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+		if (phase.Nanoseconds < 0.0 || ns < phase.Nanoseconds)
+		{
+			phase.Nanoseconds = ns;
+			phase.Allocations = allocs;
+		}
+		phase.Bytes = bytes;
+	}
+}
+
+/* Stream factories, writing streams start empty, reading streams expose what was written */
+struct MemoryStreamTarget
+{
+	static constexpr StringView Name = "MemoryStream"sv;
+	MemoryStream Stream;
+
+	IStream& BeginWrite() { Stream = MemoryStream(); return Stream; }
+	IStream& BeginRead() { Stream.Seek(0); return Stream; }
+	void EndRead() { }
+};
+
+struct FileStreamTarget
+{
+	static constexpr StringView Name = "FileStream"sv;
+	UPtr<FileStream> Stream;
+
+	IStream& BeginWrite()
+	{
+		Stream.Reset(nullptr);
+		std::error_code ec;
+		std::filesystem::remove(GetBenchFilePath(), ec);
+		Stream.Reset(Construct<FileStream>(GetBenchFilePath(), IStream::READ | IStream::WRITE));
+		return *Stream;
+	}
+	IStream& BeginRead()
+	{
+		Stream.Reset(Construct<FileStream>(GetBenchFilePath(), IStream::READ));
+		return *Stream;
+	}
+	void EndRead() { Stream.Reset(nullptr); }
+};
+
+template<class T>
+struct BinaryFormat
+{
+	static constexpr StringView Name = "Binary"sv;
+	using Cat = typename refl::TypeInfo<T>::Type;
+
+	static TResult<ssizet> Write(const T& obj, IStream& stream) { return Cat::ToStream(obj, stream); }
+	static TResult<ssizet> Read(T& obj, IStream& stream) { return Cat::FromStream(obj, stream); }
+};
+
+/* Binary with the exact size pass, only meaningful for MemoryStream */
+template<class T>
+struct PresizedBinaryFormat
+{
+	static constexpr StringView Name = "BinaryPresized"sv;
+	using Cat = typename refl::TypeInfo<T>::Type;
+
+	static TResult<ssizet> Write(const T& obj, IStream& stream) { return refl::SerializeToBuffer(obj, (MemoryStream&)stream); }
+	static TResult<ssizet> Read(T& obj, IStream& stream) { return Cat::FromStream(obj, stream); }
+};
+
+/* Each object is stored as an int64 length followed by its unformatted JSON text */
+template<class T>
+struct JSONFormat
+{
+	static constexpr StringView Name = "JSON"sv;
+	using Cat = typename refl::TypeInfo<T>::Type;
+
+	static TResult<ssizet> Write(const T& obj, IStream& stream)
+	{
+		SPtr<cJSON> json = Cat::CreateJSON(obj, "obj"sv);
+		char* text = cJSON_PrintUnformatted(json.get());
+		if (text == nullptr)
+			return Result::CreateFailure<ssizet>("[Benchmark]::JSONFormat couldn't print the JSON."sv);
+		const int64 length = (int64)strlen(text);
+		ssizet size = stream.Write(&length, sizeof(length));
+		size += stream.Write(text, length);
+		cJSON_free(text);
+		return Result::CreateSuccess(size);
+	}
+	static TResult<ssizet> Read(T& obj, IStream& stream)
+	{
+		int64 length = 0;
+		ssizet size = stream.Read(&length, sizeof(length));
+		String text((sizet)length, '\0');
+		size += stream.Read(text.data(), length);
+		SPtr<cJSON> json = SPtr<cJSON>(cJSON_ParseWithLength(text.data(), text.size()), cJSON_Delete);
+		if (json == nullptr)
+			return Result::CreateFailure<ssizet>("[Benchmark]::JSONFormat couldn't parse the JSON."sv);
+		EmptyResult res = Cat::FromJSON(obj, json.get(), "obj"sv);
+		if (res.HasFailed())
+			return Result::CopyFailure<ssizet>(res);
+		return Result::CreateSuccess(size);
+	}
+};
+
+template<class T, template<class> class FormatT, class Target>
+static BenchResult RunCase(StringView typeName, const Vector<T>& objects, sizet iterations)
+{
+	using Fmt = FormatT<T>;
+	using Cat = typename refl::TypeInfo<T>::Type;
+	BenchResult result;
+	result.TypeName.assign(typeName);
+	result.Format.assign(Fmt::Name);
+	result.Stream.assign(Target::Name);
+	result.ObjectCount = objects.size();
+
+	Target target;
+	MeasurePhase(result.Write, iterations, [&]() -> int64
+		{
+			IStream& stream = target.BeginWrite();
+			int64 total = 0;
+			for (const T& obj : objects)
+			{
+				TResult<ssizet> res = Fmt::Write(obj, stream);
+				if (res.HasFailed())
+				{
+					result.Valid = false;
+					result.FailMessage = res.GetFailMessage();
+					break;
+				}
+				total += res.GetValue();
+			}
+			return total;
+		});
+	if (!result.Valid)
+		return result;
+
+	Vector<T> readBack(objects.size());
+	MeasurePhase(result.Read, iterations, [&]() -> int64
+		{
+			IStream& stream = target.BeginRead();
+			int64 total = 0;
+			for (T& obj : readBack)
+			{
+				TResult<ssizet> res = Fmt::Read(obj, stream);
+				if (res.HasFailed())
+				{
+					result.Valid = false;
+					result.FailMessage = res.GetFailMessage();
+					break;
+				}
+				total += res.GetValue();
+			}
+			target.EndRead();
+			return total;
+		});
+
+	if (result.Valid)
+	{
+		for (sizet i = 0; i < objects.size(); ++i)
+		{
+			if (!Cat::Equals(objects[i], readBack[i]))
+			{
+				result.Valid = false;
+				result.FailMessage = Format("Object %" PRIuPTR " differs after the round trip.", i);
+				break;
+			}
+		}
+	}
+	return result;
+}
+
+template<class T>
+static void RunType(Vector<BenchResult>& results, StringView typeName, sizet objectCount, sizet iterations)
+{
+	Vector<T> objects(objectCount);
+	for (T& obj : objects)
+		Generate(obj);
+
+	results.push_back(RunCase<T, BinaryFormat, MemoryStreamTarget>(typeName, objects, iterations));
+	results.push_back(RunCase<T, PresizedBinaryFormat, MemoryStreamTarget>(typeName, objects, iterations));
+	results.push_back(RunCase<T, BinaryFormat, FileStreamTarget>(typeName, objects, iterations));
+	results.push_back(RunCase<T, JSONFormat, MemoryStreamTarget>(typeName, objects, iterations));
+	results.push_back(RunCase<T, JSONFormat, FileStreamTarget>(typeName, objects, iterations));
+}
+
+/***********************************************************************************
+*                                     REPORT                                       *
+***********************************************************************************/
+
+static double ToMBs(const BenchPhase& phase)
+{
+	if (phase.Nanoseconds <= 0.0)
+		return 0.0;
+	return ((double)phase.Bytes / (1024.0 * 1024.0)) / (phase.Nanoseconds * 1e-9);
+}
+
+static double ToNsPerObject(const BenchPhase& phase, sizet objectCount)
+{
+	return objectCount > 0 ? phase.Nanoseconds / (double)objectCount : 0.0;
+}
+
+static void PrintResults(const Vector<BenchResult>& results)
+{
+	printf("%-18s %-15s %-13s %12s %12s %12s %12s %12s %12s\n", "Type", "Format", "Stream",
+		"W MB/s", "W ns/obj", "W allocs", "R MB/s", "R ns/obj", "R allocs");
+	for (const auto& r : results)
+	{
+		if (!r.Valid)
+		{
+			printf("%-18s %-15s %-13s FAILED: %s\n", r.TypeName.c_str(), r.Format.c_str(), r.Stream.c_str(), r.FailMessage.c_str());
+			continue;
+		}
+		printf("%-18s %-15s %-13s %12.2f %12.1f %12llu %12.2f %12.1f %12llu\n", r.TypeName.c_str(), r.Format.c_str(), r.Stream.c_str(),
+			ToMBs(r.Write), ToNsPerObject(r.Write, r.ObjectCount), (unsigned long long)r.Write.Allocations,
+			ToMBs(r.Read), ToNsPerObject(r.Read, r.ObjectCount), (unsigned long long)r.Read.Allocations);
+	}
+}
+
+static void AddPhaseJSON(cJSON* obj, const char* name, const BenchPhase& phase, sizet objectCount)
+{
+	cJSON* item = cJSON_AddObjectToObject(obj, name);
+	cJSON_AddNumberToObject(item, "bytes", (double)phase.Bytes);
+	cJSON_AddNumberToObject(item, "ns", phase.Nanoseconds);
+	cJSON_AddNumberToObject(item, "mb_per_s", ToMBs(phase));
+	cJSON_AddNumberToObject(item, "ns_per_object", ToNsPerObject(phase, objectCount));
+	cJSON_AddNumberToObject(item, "allocations", (double)phase.Allocations);
+}
+
+static bool WriteResultsJSON(const Vector<BenchResult>& results, const char* path, sizet iterations)
+{
+	SPtr<cJSON> root = SPtr<cJSON>(cJSON_CreateObject(), cJSON_Delete);
+	cJSON_AddStringToObject(root.get(), "benchmark", "reflection_serialization");
+	cJSON_AddNumberToObject(root.get(), "iterations", (double)iterations);
+	cJSON* arr = cJSON_AddArrayToObject(root.get(), "results");
+	for (const auto& r : results)
+	{
+		cJSON* obj = cJSON_CreateObject();
+		cJSON_AddStringToObject(obj, "type", r.TypeName.c_str());
+		cJSON_AddStringToObject(obj, "format", r.Format.c_str());
+		cJSON_AddStringToObject(obj, "stream", r.Stream.c_str());
+		cJSON_AddNumberToObject(obj, "objects", (double)r.ObjectCount);
+		cJSON_AddBoolToObject(obj, "valid", r.Valid);
+		if (r.Valid)
+		{
+			AddPhaseJSON(obj, "write", r.Write, r.ObjectCount);
+			AddPhaseJSON(obj, "read", r.Read, r.ObjectCount);
+		}
+		else
+		{
+			cJSON_AddStringToObject(obj, "error", r.FailMessage.c_str());
+		}
+		cJSON_AddItemToArray(arr, obj);
+	}
+
+	char* text = cJSON_Print(root.get());
+	if (text == nullptr)
+		return false;
+	FILE* file = fopen(path, "w");
+	if (file != nullptr)
+	{
+		fputs(text, file);
+		fclose(file);
+	}
+	cJSON_free(text);
+	return file != nullptr;
+}
+
+int main(int argc, char* argv[])
+{
+	const sizet objectCount = argc > 1 ? (sizet)std::strtoull(argv[1], nullptr, 10) : 10000;
+	const sizet iterations = argc > 2 ? (sizet)std::strtoull(argv[2], nullptr, 10) : 5;
+	const char* outputPath = argc > 3 ? argv[3] : "ReflectionBenchmark.json";
+
+	cJSON_Hooks hooks{ &CountedAlloc, &::free };
+	cJSON_InitHooks(&hooks);
+
+	Vector<BenchResult> results;
+	RunType<BenchPlainStruct>(results, "PlainStruct"sv, objectCount, iterations);
+	RunType<BenchNestedVector>(results, "NestedVector"sv, objectCount, iterations);
+	RunType<BenchStringMap>(results, "StringMap"sv, objectCount, iterations);
+	RunType<BenchArray>(results, "FloatArray16"sv, objectCount, iterations);
+
+	std::error_code ec;
+	std::filesystem::remove(GetBenchFilePath(), ec);
+
+	PrintResults(results);
+	if (!WriteResultsJSON(results, outputPath, iterations))
+	{
+		fprintf(stderr, "Couldn't write the results to '%s'.\n", outputPath);
+		return EXIT_FAILURE;
+	}
+	printf("Results written to '%s'.\n", outputPath);
+
+	for (const auto& r : results)
+	{
+		if (!r.Valid)
+			return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
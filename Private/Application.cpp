@@ -6,6 +6,7 @@
 #include "Application.h"
 #include "../Public/Library.h"
 #include "../Public/Platform.h"
+#include "../Public/MPMCTaskScheduler.h"
 
 using namespace greaper;
 using namespace greaper::core;
@@ -14,15 +15,14 @@ SPtr<Application> gApplication = {};
 
 EmptyResult Application::RegisterGreaperLibrary(const PGreaperLib& gLib)
 {
-	auto uLib = GetGreaperLibrary(gLib->GetLibraryUuid());
-	if (uLib.IsOk() && uLib.GetValue() != nullptr)
+	LOCK(m_LibraryMutex);
+	if (m_LibraryUuidMap.find(gLib->GetLibraryUuid()) != m_LibraryUuidMap.end())
 	{
 		return Result::CreateFailure(Format(
 			"Trying to register a GreaperLibrary, but its UUID '%s' its already registered.",
 			gLib->GetLibraryUuid().ToString().c_str()));
 	}
-	auto nLib = GetGreaperLibrary(gLib->GetLibraryName());
-	if (nLib.IsOk() && nLib.GetValue() != nullptr)
+	if (m_LibraryNameMap.find(gLib->GetLibraryName()) != m_LibraryNameMap.end())
 	{
 		return Result::CreateFailure(Format(
 			"Trying to register a GreaperLibrary, but its name '%s' its already registered.",
@@ -50,6 +50,7 @@ void Application::UpdateActiveInterfaceList()noexcept
 			continue; // Not in vector
 
 		m_ActiveInterfaces[ifaceIDX].reset();
+		PublishActiveInterfaces();
 		iface->Deactivate(PInterface());
 	}
 	m_InterfacesToRemove.clear();
@@ -70,6 +71,7 @@ void Application::UpdateActiveInterfaceList()noexcept
 			ifaceIDX = uuidIT->second;
 		}
 		m_ActiveInterfaces[ifaceIDX] = iface;
+		PublishActiveInterfaces();
 		iface->Activate(PInterface());
 		m_OnInterfaceActivation.Trigger(iface);
 	}
@@ -83,12 +85,26 @@ void Application::UpdateActiveInterfaceList()noexcept
 		auto& oiFace = m_ActiveInterfaces[ifaceIDX];
 		iface->Activate(oiFace);
 		m_OnInterfaceActivation.Trigger(iface);
-		m_ActiveInterfaces[ifaceIDX] = iface;
-		oiFace->Deactivate(iface);
+		auto oldIface = std::exchange(m_ActiveInterfaces[ifaceIDX], iface);
+		PublishActiveInterfaces();
+		oldIface->Deactivate(iface);
 	}
 	m_InterfaceToChange.clear();
 }
 
+void Application::PublishActiveInterfaces()noexcept
+{
+	Vector<ActiveEntry> snapshot;
+	snapshot.reserve(m_ActiveInterfaces.size());
+	for (const auto& iface : m_ActiveInterfaces)
+	{
+		if (iface != nullptr)
+			snapshot.push_back(ActiveEntry{ iface->GetInterfaceUUID(), iface->GetInterfaceName(), iface });
+	}
+	m_ActiveSnapshot.Publish(std::move(snapshot));
+	m_ActiveGeneration.fetch_add(1, std::memory_order_release);
+}
+
 Application::Application()
 	:m_OnInterfaceActivation("OnInterfaceActivation"sv)
 {
@@ -105,6 +121,10 @@ void Application::OnInitialization() noexcept
 	VerifyNot(m_Library.expired(), "Trying to initialize an application with an expired GreaperLib.");
 	auto lib = m_Library.lock();
 
+	{
+		LOCK(m_BackgroundMutex);
+		m_BackgroundStopped = false;
+	}
 	RegisterGreaperLibrary(lib);
 }
 
@@ -113,6 +133,18 @@ void Application::OnDeinitialization() noexcept
 	VerifyNot(m_Library.expired(), "Trying to deinitialize Application but its GreaperLibrary is expired.");
 	auto ownLib = m_Library.lock();
 
+	// Its worker comes from the ThreadManager, which is deactivated below, the exports of the
+	// libraries deinitialized after this are written on this thread
+	PTaskScheduler background;
+	{
+		LOCK(m_BackgroundMutex);
+		m_BackgroundStopped = true;
+		background = std::move(m_BackgroundScheduler);
+	}
+	if (background != nullptr)
+		background->WaitUntilAllTasksFinished();
+	background.reset();
+
 	{
 		LOCK(m_ActiveMutex);
 		for (auto& mgr : m_ActiveInterfaces)
@@ -125,33 +157,38 @@ void Application::OnDeinitialization() noexcept
 		m_ActiveInterfaces.clear();
 		m_ActiveInterfaceNameMap.clear();
 		m_ActiveInterfaceUuidMap.clear();
+		PublishActiveInterfaces();
+		m_UpdateInterfaces.clear();
+		m_UpdateGeneration = 0;
 
 		m_InterfacesToAdd.clear();
 		m_InterfacesToRemove.clear();
 		m_InterfaceToChange.clear();
 	}
 
-	for (auto& lib : m_Libraries)
+	// Deinitialized without the registry lock, the libraries unregister their interfaces through us
+	Vector<PGreaperLib> libraries;
+	{
+		SHAREDLOCK(m_LibraryMutex);
+		libraries.reserve(m_Libraries.size());
+		for (const auto& lib : m_Libraries)
+			libraries.push_back(lib.Lib);
+	}
+	for (const auto& gLib : libraries)
 	{
-		auto& gLib = lib.Lib;
 		if (gLib->GetLibraryUuid() == ownLib->GetLibraryUuid())
-		{
-			lib.IntefaceNameMap.clear();
-			lib.InterfaceUuidMap.clear();
-			lib.Interfaces.clear();
 			continue;
-		}
 
 		if (gLib->GetInitializationState() == InitState_t::Started)
 			gLib->DeinitLibrary();
+	}
 
-		lib.IntefaceNameMap.clear();
-		lib.InterfaceUuidMap.clear();
-		lib.Interfaces.clear();
+	{
+		LOCK(m_LibraryMutex);
+		m_Libraries.clear();
+		m_LibraryNameMap.clear();
+		m_LibraryUuidMap.clear();
 	}
-	m_Libraries.clear();
-	m_LibraryNameMap.clear();
-	m_LibraryUuidMap.clear();
 
 	gApplication.reset();
 }
@@ -247,14 +284,220 @@ void Application::InitProperties()noexcept
 		loadedLibrariesProp = (WPtr<LoadedLibrariesProp_t>)loadedLibrariesResult.GetValue();
 	}
 	m_Properties[(sizet)LoadedLibraries] = (WPtr<LoadedLibrariesProp_t>)std::move(loadedLibrariesProp);
+
+	WPtr<UpdateMaxRateProp_t> updateMaxRateProp;
+	result = lib->GetProperty(UpdateMaxRateName);
+	if (result.IsOk())
+		updateMaxRateProp = result.GetValue();
+
+	if (updateMaxRateProp.expired())
+	{
+		auto updateMaxRateResult = CreateProperty<uint32>(m_Library, UpdateMaxRateName, 60, "Maximum amount of updates per second, 0 means unlimited."sv, false, false, {});
+		Verify(updateMaxRateResult.IsOk(), "Couldn't create the property '%s' msg: %s", UpdateMaxRateName.data(), updateMaxRateResult.GetFailMessage().c_str());
+		updateMaxRateProp = (WPtr<UpdateMaxRateProp_t>)updateMaxRateResult.GetValue();
+	}
+	m_UpdateMaxRateAccessor = TPropertyAccessor<uint32>(updateMaxRateProp);
+	m_Properties[(sizet)UpdateMaxRate] = std::move(updateMaxRateProp);
+
+	WPtr<FixedUpdateMaxRateProp_t> fixedUpdateMaxRateProp;
+	result = lib->GetProperty(FixedUpdateMaxRateName);
+	if (result.IsOk())
+		fixedUpdateMaxRateProp = result.GetValue();
+
+	if (fixedUpdateMaxRateProp.expired())
+	{
+		auto fixedUpdateMaxRateResult = CreateProperty<uint32>(m_Library, FixedUpdateMaxRateName, 50, "Amount of fixed updates per second, 0 disables FixedUpdate."sv, false, false, {});
+		Verify(fixedUpdateMaxRateResult.IsOk(), "Couldn't create the property '%s' msg: %s", FixedUpdateMaxRateName.data(), fixedUpdateMaxRateResult.GetFailMessage().c_str());
+		fixedUpdateMaxRateProp = (WPtr<FixedUpdateMaxRateProp_t>)fixedUpdateMaxRateResult.GetValue();
+	}
+	m_FixedUpdateMaxRateAccessor = TPropertyAccessor<uint32>(fixedUpdateMaxRateProp);
+	m_Properties[(sizet)FixedUpdateMaxRate] = std::move(fixedUpdateMaxRateProp);
 }
 
 void Application::DeinitProperties()noexcept
 {
+	m_UpdateMaxRateAccessor.Reset();
+	m_FixedUpdateMaxRateAccessor.Reset();
 	for (auto& prop : m_Properties)
 		prop.reset();
 }
 
+void Application::RefreshUpdateInterfaces()noexcept
+{
+	// Only rebuilt when the active interfaces change, so a tick does not copy them
+	const auto generation = m_ActiveGeneration.load(std::memory_order_acquire);
+	if (generation == m_UpdateGeneration)
+		return;
+
+	m_UpdateInterfaces.clear();
+	{
+		const auto snapshot = m_ActiveSnapshot.Read();
+		if (snapshot)
+		{
+			for (const auto& entry : *snapshot)
+				m_UpdateInterfaces.push_back(entry.Interface);
+		}
+	}
+	m_UpdateGeneration = generation;
+}
+
+static void CallUpdatePhase(IInterface& iface, UpdatePhase_t phase)noexcept
+{
+	switch (phase)
+	{
+	case UpdatePhase_t::PreUpdate: iface.PreUpdate(); break;
+	case UpdatePhase_t::FixedUpdate: iface.FixedUpdate(); break;
+	case UpdatePhase_t::Update: iface.Update(); break;
+	case UpdatePhase_t::PostUpdate: iface.PostUpdate(); break;
+	default: break;
+	}
+}
+
+void Application::DispatchPhase(UpdatePhase_t phase)noexcept
+{
+	const auto phaseStart = Clock_t::now();
+
+	m_SerialUpdateInterfaces.clear();
+	m_ParallelUpdateTasks.clear();
+	for (const auto& iface : m_UpdateInterfaces)
+	{
+		if (m_UpdateScheduler != nullptr && iface->IsUpdateThreadSafe())
+			m_ParallelUpdateTasks.emplace_back(iface->GetInterfaceName(), [this, ptr = iface.get(), phase]()
+				{
+					CallUpdatePhase(*ptr, phase);
+					m_PendingUpdateTasks.fetch_sub(1, std::memory_order_release);
+				});
+		else
+			m_SerialUpdateInterfaces.push_back(iface);
+	}
+
+	m_PendingUpdateTasks.store(m_ParallelUpdateTasks.size(), std::memory_order_relaxed);
+	// A single thread-safe interface gains nothing from being sent to another thread
+	if (m_ParallelUpdateTasks.size() == 1 || (!m_ParallelUpdateTasks.empty() && m_UpdateScheduler->AddTasks(m_ParallelUpdateTasks).HasFailed()))
+	{
+		for (auto& [name, fn] : m_ParallelUpdateTasks)
+			fn();
+	}
+
+	for (const auto& iface : m_SerialUpdateInterfaces)
+		CallUpdatePhase(*iface, phase);
+
+	// Phases are expected to be short, spin instead of paying a wake up
+	while (m_PendingUpdateTasks.load(std::memory_order_acquire) != 0)
+		THREAD_YIELD();
+
+	const auto phaseTime = Clock_t::now() - phaseStart;
+	const auto phaseIdx = (sizet)phase;
+	if (phase == UpdatePhase_t::FixedUpdate)
+		m_CurrentStats.LastPhaseTime[phaseIdx] += phaseTime; // Several fixed steps may run in a tick
+	else
+		m_CurrentStats.LastPhaseTime[phaseIdx] = phaseTime;
+	m_CurrentStats.TotalPhaseTime[phaseIdx] += phaseTime;
+}
+
+void Application::Tick()noexcept
+{
+	const auto now = Clock_t::now();
+	Duration_t delta{};
+	if (m_CurrentStats.FrameCount > 0)
+		delta = Min(now - m_LastTickTime, MaxTickDelta); // Avoids a burst of fixed steps after a stall
+	m_LastTickTime = now;
+
+	const uint32 fixedRate = m_FixedUpdateMaxRateAccessor.IsValid() ? m_FixedUpdateMaxRateAccessor.Get() : 0;
+	const auto fixedStep = fixedRate > 0
+		? std::chrono::duration_cast<Duration_t>(std::chrono::duration<double>(1.0 / fixedRate))
+		: Duration_t{};
+
+	RefreshUpdateInterfaces();
+	m_CurrentStats.LastPhaseTime[(sizet)UpdatePhase_t::FixedUpdate] = Duration_t{};
+
+	DispatchPhase(UpdatePhase_t::PreUpdate);
+
+	if (fixedStep > Duration_t{})
+	{
+		m_FixedAccumulator += delta;
+		sizet steps = 0;
+		while (m_FixedAccumulator >= fixedStep && steps < MaxFixedStepsPerTick)
+		{
+			DispatchPhase(UpdatePhase_t::FixedUpdate);
+			m_FixedAccumulator -= fixedStep;
+			++steps;
+		}
+		if (m_FixedAccumulator >= fixedStep)
+			m_FixedAccumulator = fixedStep - Duration_t{ 1 }; // Too far behind, drop the remaining steps
+		m_CurrentStats.FixedUpdateCount += steps;
+		m_CurrentStats.FixedUpdateAlpha = (float)((double)m_FixedAccumulator.count() / (double)fixedStep.count());
+	}
+	else
+	{
+		m_FixedAccumulator = Duration_t{};
+		m_CurrentStats.FixedUpdateAlpha = 0.f;
+	}
+
+	DispatchPhase(UpdatePhase_t::Update);
+	DispatchPhase(UpdatePhase_t::PostUpdate);
+
+	++m_CurrentStats.FrameCount;
+	m_CurrentStats.DeltaTime = delta;
+	m_CurrentStats.FixedDeltaTime = fixedStep;
+	m_PublishedStats.Store(m_CurrentStats);
+}
+
+void Application::WaitUntil(Timepoint_t deadline)noexcept
+{
+	// Sleep most of the remaining time and spin the tail, sleeps are not precise enough
+	auto now = Clock_t::now();
+	if (deadline - now > PacingSpinTime)
+		std::this_thread::sleep_for(deadline - now - PacingSpinTime);
+
+	while (Clock_t::now() < deadline)
+		THREAD_YIELD();
+}
+
+void Application::RunUpdateLoop()noexcept
+{
+	if (m_UpdateLoopRunning.exchange(true, std::memory_order_acq_rel))
+		return; // Already running
+
+	const auto thmgr = (PThreadManager)FindActiveInterface(IThreadManager::InterfaceUUID);
+	if (thmgr != nullptr)
+	{
+		const auto workerCount = (sizet)Max(std::thread::hardware_concurrency(), 2u) - 1;
+		auto schedulerRes = MPMCTaskScheduler::Create((WThreadManager)thmgr, "UpdateWorkers"sv, workerCount, false);
+		if (schedulerRes.IsOk())
+			m_UpdateScheduler = schedulerRes.GetValue();
+		else if (!m_Library.expired()) // Updated on this thread
+			m_Library.lock()->LogWarning("Couldn't create the UpdateWorkers scheduler, the update will run on a single thread, reason: " + schedulerRes.GetFailMessage());
+	}
+
+	auto nextFrame = Clock_t::now();
+	while (m_UpdateLoopRunning.load(std::memory_order_acquire))
+	{
+		Tick();
+
+		const uint32 maxRate = m_UpdateMaxRateAccessor.IsValid() ? m_UpdateMaxRateAccessor.Get() : 0;
+		if (maxRate == 0)
+		{
+			m_CurrentStats.LastWaitTime = Duration_t{};
+			nextFrame = Clock_t::now();
+			continue;
+		}
+
+		const auto framePeriod = std::chrono::duration_cast<Duration_t>(std::chrono::duration<double>(1.0 / maxRate));
+		nextFrame += framePeriod;
+		const auto waitStart = Clock_t::now();
+		if (waitStart - nextFrame > framePeriod)
+			nextFrame = waitStart; // More than a frame late, don't try to catch up
+		else
+			WaitUntil(nextFrame);
+		m_CurrentStats.LastWaitTime = Clock_t::now() - waitStart;
+	}
+
+	if (m_UpdateScheduler != nullptr)
+		m_UpdateScheduler->WaitUntilAllTasksFinished();
+	m_UpdateScheduler.reset();
+}
+
 TResult<PGreaperLib> greaper::core::Application::RegisterGreaperLibrary(const StringView& libPath) noexcept
 {
 	//PLibrary lib{ Construct<Library>(libPath) };
@@ -262,7 +505,7 @@ TResult<PGreaperLib> greaper::core::Application::RegisterGreaperLibrary(const St
 	return RegisterGreaperLibrary(lib);
 }
 
-TResult<PGreaperLib> greaper::core::Application::RegisterGreaperLibrary(PLibrary library) noexcept
+TResult<PGreaperLib> Application::LoadGreaperLibrary(const PLibrary& library) noexcept
 {
 	if (library == nullptr)
 	{
@@ -285,12 +528,11 @@ TResult<PGreaperLib> greaper::core::Application::RegisterGreaperLibrary(PLibrary
 		return Result::CreateFailure<PGreaperLib>(
 			"Trying to register a GreaperLibrary, but the library returned a nullptr GreaperLibrary."sv);
 	}
-	auto gLib = PGreaperLib(*gLibPtr);
-	auto res = RegisterGreaperLibrary(gLib);
-
-	if (res.HasFailed())
-		return Result::CopyFailure<PGreaperLib>(res);
+	return Result::CreateSuccess(PGreaperLib(*gLibPtr));
+}
 
+void Application::AddLoadedLibraryName(const PGreaperLib& gLib) noexcept
+{
 	auto wprop = GetLoadedLibrariesNames();
 	if (!wprop.expired())
 	{
@@ -299,14 +541,249 @@ TResult<PGreaperLib> greaper::core::Application::RegisterGreaperLibrary(PLibrary
 		loadedLibraries.push_back(String{ gLib->GetLibraryName() });
 		prop->SetValue(loadedLibraries);
 	}
+}
+
+TResult<PGreaperLib> greaper::core::Application::RegisterGreaperLibrary(PLibrary library) noexcept
+{
+	auto loadRes = LoadGreaperLibrary(library);
+	if (loadRes.HasFailed())
+		return loadRes;
+
+	auto gLib = loadRes.GetValue();
+	auto res = RegisterGreaperLibrary(gLib);
+
+	if (res.HasFailed())
+		return Result::CopyFailure<PGreaperLib>(res);
+
+	AddLoadedLibraryName(gLib);
 
 	gLib->InitLibrary(library, (PApplication)gApplication);
 
 	return Result::CreateSuccess(gLib);
 }
 
+TResult<Vector<PGreaperLib>> Application::RegisterGreaperLibraries(const Vector<StringView>& libPaths) noexcept
+{
+	Vector<PLibrary> libraries;
+	libraries.reserve(libPaths.size());
+	for (const auto& libPath : libPaths)
+		libraries.push_back(ConstructShared<Library>(libPath));
+	return RegisterGreaperLibraries(libraries);
+}
+
+TResult<Vector<PGreaperLib>> Application::RegisterGreaperLibraries(const Vector<PLibrary>& libraries) noexcept
+{
+	struct InitNode
+	{
+		PLibrary Library;
+		PGreaperLib GLib;
+		Vector<sizet> Dependents;
+		sizet PendingDependencies = 0;
+		bool Initialized = false;
+	};
+
+	const auto startTime = Clock_t::now();
+	const auto count = libraries.size();
+	Vector<InitNode> nodes;
+	nodes.reserve(count);
+	FlatMap<StringView, sizet> batchNameMap;
+	for (const auto& library : libraries)
+	{
+		auto loadRes = LoadGreaperLibrary(library);
+		if (loadRes.HasFailed())
+			return Result::CopyFailure<Vector<PGreaperLib>>(loadRes);
+
+		const auto& gLib = loadRes.GetValue();
+		if (!batchNameMap.insert({ gLib->GetLibraryName(), nodes.size() }).second)
+			return Result::CreateFailure<Vector<PGreaperLib>>(Format("Trying to register the GreaperLibrary '%s' twice.", gLib->GetLibraryName().data()));
+		nodes.push_back(InitNode{ library, gLib, {}, 0, false });
+	}
+
+	// Build the dependency graph, dependencies outside the batch must be registered already
+	for (sizet i = 0; i < count; ++i)
+	{
+		auto& node = nodes[i];
+		for (const auto& depName : node.GLib->GetLibraryDependencies())
+		{
+			if (const auto depIT = batchNameMap.find(depName); depIT != batchNameMap.end())
+			{
+				if (depIT->second == i)
+					continue;
+				nodes[depIT->second].Dependents.push_back(i);
+				++node.PendingDependencies;
+			}
+			else if (GetGreaperLibrary(depName).HasFailed())
+			{
+				return Result::CreateFailure<Vector<PGreaperLib>>(Format("The GreaperLibrary '%s' depends on '%s', which is not registered.",
+					node.GLib->GetLibraryName().data(), String(depName).c_str()));
+			}
+		}
+	}
+
+	Vector<sizet> ready;
+	{
+		Vector<sizet> pending(count);
+		for (sizet i = 0; i < count; ++i)
+		{
+			pending[i] = nodes[i].PendingDependencies;
+			if (pending[i] == 0)
+				ready.push_back(i);
+		}
+		sizet visited = 0;
+		for (Vector<sizet> wave = ready; !wave.empty(); )
+		{
+			Vector<sizet> next;
+			for (const auto idx : wave)
+			{
+				++visited;
+				for (const auto dependent : nodes[idx].Dependents)
+				{
+					if (--pending[dependent] == 0)
+						next.push_back(dependent);
+				}
+			}
+			wave = std::move(next);
+		}
+		if (visited != count)
+			return Result::CreateFailure<Vector<PGreaperLib>>("Trying to register GreaperLibraries with circular dependencies."sv);
+	}
+
+	for (const auto& node : nodes)
+	{
+		auto res = RegisterGreaperLibrary(node.GLib);
+		if (res.HasFailed())
+			return Result::CopyFailure<Vector<PGreaperLib>>(res);
+		AddLoadedLibraryName(node.GLib);
+	}
+
+	/* Initialize every library as soon as its dependencies are done. Only Initialize and the config
+	*  import run on the scheduler, registering the managers and properties and finishing the library
+	*  are done here, one library at a time */
+	PTaskScheduler scheduler;
+	const auto thmgr = (PThreadManager)FindActiveInterface(IThreadManager::InterfaceUUID);
+	if (thmgr != nullptr && count > 1)
+	{
+		const auto workerCount = Min((sizet)Max(std::thread::hardware_concurrency(), 1u), count);
+		auto schedulerRes = MPMCTaskScheduler::Create((WThreadManager)thmgr, "LibraryInit"sv, workerCount, false);
+		if (schedulerRes.IsOk())
+			scheduler = schedulerRes.GetValue();
+		else if (!m_Library.expired()) // Initialized on this thread
+			m_Library.lock()->LogWarning("Couldn't create the LibraryInit scheduler, the libraries will be initialized on this thread, reason: " + schedulerRes.GetFailMessage());
+	}
+
+	Mutex finishedMutex;
+	Signal finishedSignal;
+	Vector<sizet> finished;
+	const auto initFn = [&nodes, &finishedMutex, &finishedSignal, &finished](sizet idx)
+	{
+		auto& node = nodes[idx];
+		if (!node.Initialized)
+			node.GLib->StartInitLibrary(node.Library, (PApplication)gApplication);
+		else
+			node.GLib->ImportLibraryConfig();
+		{
+			LOCK(finishedMutex);
+			finished.push_back(idx);
+		}
+		finishedSignal.notify_one();
+	};
+
+	sizet done = 0;
+	while (done < count)
+	{
+		for (const auto idx : ready)
+		{
+			if (scheduler == nullptr || scheduler->AddTask(nodes[idx].GLib->GetLibraryName(), [&initFn, idx]() { initFn(idx); }).HasFailed())
+				initFn(idx);
+		}
+		ready.clear();
+
+		Vector<sizet> justFinished;
+		{
+			auto lck = UniqueLock<Mutex>(finishedMutex);
+			while (finished.empty())
+				finishedSignal.wait(lck);
+			justFinished.swap(finished);
+		}
+		for (const auto idx : justFinished)
+		{
+			auto& node = nodes[idx];
+			if (!node.Initialized)
+			{
+				node.Initialized = true;
+				node.GLib->RegisterLibraryContents();
+				ready.push_back(idx); // Its config import
+				continue;
+			}
+			node.GLib->FinishInitLibrary();
+			++done;
+			for (const auto dependent : node.Dependents)
+			{
+				if (--nodes[dependent].PendingDependencies == 0)
+					ready.push_back(dependent);
+			}
+		}
+	}
+	if (scheduler != nullptr)
+		scheduler->WaitUntilAllTasksFinished();
+
+	Vector<PGreaperLib> gLibs;
+	gLibs.reserve(count);
+	for (const auto& node : nodes)
+		gLibs.push_back(node.GLib);
+
+	LogStartupReport(gLibs, Clock_t::now() - startTime);
+	return Result::CreateSuccess(std::move(gLibs));
+}
+
+void Application::LogStartupReport(const Vector<PGreaperLib>& libraries, Duration_t wallTime) noexcept
+{
+	auto lib = m_Library.lock();
+	if (lib == nullptr)
+		return;
+
+	const auto toMS = [](Duration_t duration) { return std::chrono::duration<double, std::milli>(duration).count(); };
+	Duration_t serialTime{};
+	String report;
+	for (const auto& gLib : libraries)
+	{
+		const auto& timings = gLib->GetInitTimings();
+		serialTime += timings.Total;
+		report += Format("\n\t%s: %.3fms (initialize %.3fms, managers %.3fms, properties %.3fms, config %.3fms)",
+			gLib->GetLibraryName().data(), toMS(timings.Total), toMS(timings.Initialize), toMS(timings.Managers),
+			toMS(timings.Properties), toMS(timings.ImportConfig));
+	}
+	lib->Log(Format("Initialized %" PRIuPTR " libraries in %.3fms, %.3fms if done serially:", libraries.size(), toMS(wallTime), toMS(serialTime)) + report);
+}
+
+EmptyResult Application::AddBackgroundTask(StringView name, std::function<void()> workFn) noexcept
+{
+	// Added under the lock, so OnDeinitialization either waits for the task or it's rejected
+	LOCK(m_BackgroundMutex);
+	if (m_BackgroundStopped)
+		return Result::CreateFailure(Format("Couldn't add the background task '%s', the Application is deinitializing.", name.data()));
+
+	if (m_BackgroundScheduler == nullptr)
+	{
+		const auto thmgr = (PThreadManager)FindActiveInterface(IThreadManager::InterfaceUUID);
+		if (thmgr == nullptr)
+			return Result::CreateFailure(Format("Couldn't add the background task '%s', there's no active ThreadManager.", name.data()));
+		auto schedulerRes = MPMCTaskScheduler::Create((WThreadManager)thmgr, "Background"sv, 1, false);
+		if (schedulerRes.HasFailed())
+			return Result::CreateFailure(Format("Couldn't add the background task '%s', the scheduler couldn't be created, reason: %s", name.data(), schedulerRes.GetFailMessage().c_str()));
+		m_BackgroundScheduler = schedulerRes.GetValue();
+	}
+	auto res = m_BackgroundScheduler->AddTask(name, std::move(workFn));
+	if (res.HasFailed())
+		return Result::CopyFailure(res);
+	return Result::CreateSuccess();
+}
+
 TResult<PGreaperLib> Application::GetGreaperLibrary(const StringView& libraryName)const noexcept
 {
+	LoadLazyLibraryIfPending(libraryName);
+
+	SHAREDLOCK(m_LibraryMutex);
 	if (auto findIT = m_LibraryNameMap.find(libraryName); findIT != m_LibraryNameMap.end())
 	{
 		if (m_Libraries.size() <= findIT->second)
@@ -322,6 +799,9 @@ TResult<PGreaperLib> Application::GetGreaperLibrary(const StringView& libraryNam
 
 TResult<PGreaperLib> Application::GetGreaperLibrary(const Uuid& libraryUUID)const noexcept
 {
+	LoadLazyLibraryIfPending(libraryUUID);
+
+	SHAREDLOCK(m_LibraryMutex);
 	if (const auto findIT = m_LibraryUuidMap.find(libraryUUID); findIT != m_LibraryUuidMap.end())
 	{
 		if (m_Libraries.size() <= findIT->second)
@@ -339,40 +819,32 @@ EmptyResult Application::UnregisterGreaperLibrary(const PGreaperLib& library)noe
 {
 	if (library == nullptr)
 		return Result::CreateFailure("Trying to unregister a nullptr GreaperLibrary"sv);
-	
-	const auto nameIT = m_LibraryNameMap.find(library->GetLibraryName());
-	const auto uuidIT = m_LibraryUuidMap.find(library->GetLibraryUuid());
 
 	sizet nIndex = std::numeric_limits<sizet>::max();
 	sizet uIndex = std::numeric_limits<sizet>::max();
-	sizet index = std::numeric_limits<sizet>::max();
+	PGreaperLib registeredLib;
+	{
+		SHAREDLOCK(m_LibraryMutex);
+		if (const auto nameIT = m_LibraryNameMap.find(library->GetLibraryName()); nameIT != m_LibraryNameMap.end())
+			nIndex = nameIT->second;
 
-	if (nameIT != m_LibraryNameMap.end())
-		nIndex = nameIT->second;
-	
-	if (uuidIT != m_LibraryUuidMap.end())
-		uIndex = uuidIT->second;
+		if (const auto uuidIT = m_LibraryUuidMap.find(library->GetLibraryUuid()); uuidIT != m_LibraryUuidMap.end())
+			uIndex = uuidIT->second;
+
+		const auto index = (nIndex != uIndex && m_Libraries.size() <= nIndex) ? uIndex : nIndex;
+		if (m_Libraries.size() > index)
+			registeredLib = m_Libraries[index].Lib;
+	}
 	
 	auto lib = m_Library.lock();
 	VerifyNotNull(lib, "Trying to unregister a GreaperLibrary, but the Application library is expired.");
 
 	if (nIndex != uIndex)
-	{
 		lib->LogWarning(Format("Trying to unregister a GreaperLibrary '%s', but its name and uuid points to different indices.", library->GetLibraryName().data()));
-		if (m_Libraries.size() > nIndex)
-			index = nIndex;
-		else if (m_Libraries.size() > uIndex)
-			index = uIndex;
-	}
-	else
-	{
-		index = nIndex;
-	}
 
-	if (m_Libraries.size() <= index)
+	if (registeredLib == nullptr)
 		return Result::CreateFailure(Format("Trying to unregister a GreaperLibrary '%s', but it was not registered.", library->GetLibraryName().data()));
 
-	auto& libInfo = m_Libraries[index];
 	lib->Log(Format("Unregistering GraeperLibrary '%s'.", library->GetLibraryName().data()));
 	/*for (auto& iface : libInfo.Interfaces)
 	{
@@ -394,7 +866,7 @@ EmptyResult Application::UnregisterGreaperLibrary(const PGreaperLib& library)noe
 	{
 		auto prop = wprop.lock();
 		auto loadedLibraries = prop->GetValueCopy();
-		auto loadedLibrariesIdx = IndexOf(loadedLibraries, String{ libInfo.Lib->GetLibraryName() });
+		auto loadedLibrariesIdx = IndexOf(loadedLibraries, String{ registeredLib->GetLibraryName() });
 		if (loadedLibrariesIdx >= 0)
 		{
 			loadedLibraries.erase(loadedLibraries.begin() + loadedLibrariesIdx);
@@ -402,19 +874,30 @@ EmptyResult Application::UnregisterGreaperLibrary(const PGreaperLib& library)noe
 		}
 	}
 
-	libInfo.Lib->DeinitLibrary();
-	libInfo.Lib.reset();
-	libInfo.IntefaceNameMap.clear();
-	libInfo.InterfaceUuidMap.clear();
-	libInfo.Interfaces.clear();
-
-	if (nameIT != m_LibraryNameMap.end())
-		m_LibraryNameMap.erase(nameIT);
+	// Deinitialized without the registry lock, the library unregisters its interfaces through us
+	registeredLib->DeinitLibrary();
 
-	if (uuidIT != m_LibraryUuidMap.end())
-		m_LibraryUuidMap.erase(uuidIT);
+	LOCK(m_LibraryMutex);
+	sizet index = 0;
+	while (index < m_Libraries.size() && m_Libraries[index].Lib != registeredLib)
+		++index;
+	if (index >= m_Libraries.size())
+		return Result::CreateSuccess(); // Unregistered by another thread meanwhile
 
+	m_LibraryNameMap.erase(library->GetLibraryName());
+	m_LibraryUuidMap.erase(library->GetLibraryUuid());
 	m_Libraries.erase(m_Libraries.begin() + index);
+	// The libraries after it moved one position
+	for (auto& [name, libIndex] : m_LibraryNameMap)
+	{
+		if (libIndex > index)
+			--libIndex;
+	}
+	for (auto& [uuid, libIndex] : m_LibraryUuidMap)
+	{
+		if (libIndex > index)
+			--libIndex;
+	}
 	return Result::CreateSuccess();
 }
 
@@ -430,6 +913,7 @@ EmptyResult Application::RegisterInterface(const PInterface& interface)noexcept
 	}
 	auto pLib = wLib.lock();
 	
+	LOCK(m_LibraryMutex);
 	const auto findIT = m_LibraryUuidMap.find(pLib->GetLibraryUuid());
 	if (findIT == m_LibraryUuidMap.end())
 		return Result::CreateFailure("Trying to register an Interface with a non-registered GreaperLibrary."sv);
@@ -471,49 +955,49 @@ EmptyResult Application::UnregisterInterface(const PInterface& interface)noexcep
 	}
 	auto pLib = wLib.lock();
 
-	const auto findIT = m_LibraryUuidMap.find(pLib->GetLibraryUuid());
-	if (findIT == m_LibraryUuidMap.end())
-		return Result::CreateFailure("Trying to unregister an Interface with a non-registered GreaperLibrary."sv);
+	sizet nIndex = std::numeric_limits<sizet>::max();
+	sizet uIndex = std::numeric_limits<sizet>::max();
+	bool found = false;
+	{
+		LOCK(m_LibraryMutex);
+		const auto findIT = m_LibraryUuidMap.find(pLib->GetLibraryUuid());
+		if (findIT == m_LibraryUuidMap.end())
+			return Result::CreateFailure("Trying to unregister an Interface with a non-registered GreaperLibrary."sv);
 
-	auto& libInfo = m_Libraries[findIT->second];
+		auto& libInfo = m_Libraries[findIT->second];
 
-	if (libInfo.Lib != pLib)
-		return Result::CreateFailure("Trying to unregister an Interface with a GreaperLibrary which UUID points to another GreaperLibrary."sv);
+		if (libInfo.Lib != pLib)
+			return Result::CreateFailure("Trying to unregister an Interface with a GreaperLibrary which UUID points to another GreaperLibrary."sv);
 
-	const auto nameIT = libInfo.IntefaceNameMap.find(interface->GetInterfaceName());
-	const auto uuidIT = libInfo.InterfaceUuidMap.find(interface->GetInterfaceUUID());
+		const auto nameIT = libInfo.IntefaceNameMap.find(interface->GetInterfaceName());
+		const auto uuidIT = libInfo.InterfaceUuidMap.find(interface->GetInterfaceUUID());
 
-	sizet nIndex = std::numeric_limits<sizet>::max();
-	sizet uIndex = std::numeric_limits<sizet>::max();
-	sizet index = std::numeric_limits<sizet>::max();
-	if (nameIT != libInfo.IntefaceNameMap.end())
-	{
-		nIndex = nameIT->second;
-		libInfo.IntefaceNameMap.erase(nameIT);
-	}
-	if (uuidIT != libInfo.InterfaceUuidMap.end())
-	{
-		uIndex = uuidIT->second;
-		libInfo.InterfaceUuidMap.erase(uuidIT);
+		if (nameIT != libInfo.IntefaceNameMap.end())
+		{
+			nIndex = nameIT->second;
+			libInfo.IntefaceNameMap.erase(nameIT);
+		}
+		if (uuidIT != libInfo.InterfaceUuidMap.end())
+		{
+			uIndex = uuidIT->second;
+			libInfo.InterfaceUuidMap.erase(uuidIT);
+		}
+
+		const auto index = (nIndex != uIndex && libInfo.Interfaces.size() <= nIndex) ? uIndex : nIndex;
+		if (libInfo.Interfaces.size() > index)
+		{
+			libInfo.Interfaces[index].reset();
+			found = true;
+		}
 	}
 
 	auto lib = m_Library.lock();
 	VerifyNotNull(lib, "Trying to unregister a GreaperLibrary, but the Application library is expired.");
 
 	if (nIndex != uIndex)
-	{
 		lib->LogWarning(Format("Trying to unregister an Interface '%s', but its name and uuid points to different indices.", interface->GetInterfaceName().data()));
-		if (libInfo.Interfaces.size() > nIndex)
-			index = nIndex;
-		else if (libInfo.Interfaces.size() > uIndex)
-			index = uIndex;
-	}
-	else
-	{
-		index = nIndex;
-	}
 
-	if (libInfo.Interfaces.size() <= index)
+	if (!found)
 		return Result::CreateFailure(Format("Trying to unregister an Interface '%s', but it was not registered.", interface->GetInterfaceName().data()));
 
 	lib->Log(Format("Unregistering an Interface '%s' from '%s' GreaperLibrary.", interface->GetInterfaceName().data(), pLib->GetLibraryName().data()));
@@ -522,7 +1006,6 @@ EmptyResult Application::UnregisterInterface(const PInterface& interface)noexcep
 		DeactivateInterface(interface->GetInterfaceUUID());
 	if (interface->IsInitialized())
 		interface->Deinitialize();
-	libInfo.Interfaces[index].reset();
 	return Result::CreateSuccess();
 }
 
@@ -660,42 +1143,211 @@ EmptyResult Application::DeactivateInterface(const StringView& interfaceName)noe
 
 TResult<PInterface> Application::GetActiveInterface(const Uuid& interfaceUUID) const noexcept
 {
-	LOCK(m_ActiveMutex);
-
-	const auto uuidIT = m_ActiveInterfaceUuidMap.find(interfaceUUID);
-	if (uuidIT == m_ActiveInterfaceUuidMap.end())
+	auto iface = FindActiveInterface(interfaceUUID);
+	if (iface == nullptr)
 		return Result::CreateFailure<PInterface>(Format("Couldn't find an active Interface with UUID '%s'.", interfaceUUID.ToString().c_str()));
 
-	const auto index = uuidIT->second;
+	return Result::CreateSuccess(std::move(iface));
+}
 
-	if (index >= m_ActiveInterfaces.size())
-		return Result::CreateFailure<PInterface>(Format("Interface with UUID '%s', its index was out of bounds.", interfaceUUID.ToString().c_str()));
+TResult<PInterface> Application::GetActiveInterface(const StringView& interfaceName) const noexcept
+{
+	{
+		const auto snapshot = m_ActiveSnapshot.Read();
+		if (snapshot)
+		{
+			for (const auto& entry : *snapshot)
+			{
+				if (entry.Name == interfaceName)
+					return Result::CreateSuccess(entry.Interface);
+			}
+		}
+	}
+	if (auto iface = LoadLazyInterface(Uuid{}, interfaceName); iface != nullptr)
+		return Result::CreateSuccess(std::move(iface));
 
-	auto& iface = m_ActiveInterfaces[index];
+	return Result::CreateFailure<PInterface>(Format("Couldn't find an active Interface with name '%s'.", interfaceName.data()));
+}
 
-	return Result::CreateSuccess<PInterface>(iface);
+PInterface Application::FindActiveInterface(const Uuid& interfaceUUID) const noexcept
+{
+	{
+		const auto snapshot = m_ActiveSnapshot.Read();
+		if (snapshot)
+		{
+			for (const auto& entry : *snapshot)
+			{
+				if (entry.UUID == interfaceUUID)
+					return entry.Interface;
+			}
+		}
+	}
+	return LoadLazyInterface(interfaceUUID, {});
 }
 
-TResult<PInterface> Application::GetActiveInterface(const StringView& interfaceName) const noexcept
+EmptyResult Application::RegisterLazyGreaperLibrary(LibraryManifest manifest) noexcept
 {
-	LOCK(m_ActiveMutex);
+	if (manifest.LibraryPath.empty())
+		return Result::CreateFailure(Format("Trying to lazily register the GreaperLibrary '%s', but no path was given.", manifest.LibraryName.c_str()));
 
-	const auto nameIT = m_ActiveInterfaceNameMap.find(interfaceName);
-	if (nameIT == m_ActiveInterfaceNameMap.end())
-		return Result::CreateFailure<PInterface>(Format("Couldn't find an active Interface with name '%s'.", interfaceName.data()));
+	{
+		SHAREDLOCK(m_LibraryMutex);
+		if (m_LibraryNameMap.find(manifest.LibraryName) != m_LibraryNameMap.end()
+			|| m_LibraryUuidMap.find(manifest.LibraryUUID) != m_LibraryUuidMap.end())
+			return Result::CreateFailure(Format("Trying to lazily register the GreaperLibrary '%s', but its already registered.", manifest.LibraryName.c_str()));
+	}
 
-	const auto index = nameIT->second;
+	LOCK(m_LazyMutex);
+	const auto isSame = [&manifest](const LibraryManifest& lazy) { return lazy.LibraryName == manifest.LibraryName || lazy.LibraryUUID == manifest.LibraryUUID; };
+	if (std::any_of(m_LazyLibraries.begin(), m_LazyLibraries.end(), isSame) || std::any_of(m_LoadingLibraries.begin(), m_LoadingLibraries.end(), isSame))
+		return Result::CreateFailure(Format("Trying to lazily register the GreaperLibrary '%s', but its already pending.", manifest.LibraryName.c_str()));
+	m_LazyLibraries.push_back(std::move(manifest));
+	m_LazyLibraryCount.store(m_LazyLibraries.size() + m_LoadingLibraries.size(), std::memory_order_release);
+	return Result::CreateSuccess();
+}
 
-	if (index >= m_ActiveInterfaces.size())
-		return Result::CreateFailure<PInterface>(Format("Interface with name '%s', its index was out of bounds.", interfaceName.data()));
+bool Application::IsGreaperLibraryPending(const StringView& libraryName) const noexcept
+{
+	LOCK(m_LazyMutex);
+	for (const auto& lazy : m_LazyLibraries)
+	{
+		if (lazy.LibraryName == libraryName)
+			return true;
+	}
+	return false;
+}
 
-	auto& iface = m_ActiveInterfaces[index];
+TResult<PGreaperLib> Application::LoadLazyLibrary(const std::function<bool(const LibraryManifest&)>& matchFn) noexcept
+{
+	if (m_LazyLibraryCount.load(std::memory_order_acquire) == 0)
+		return Result::CreateFailure<PGreaperLib>("There are no pending GreaperLibraries."sv);
 
-	return Result::CreateSuccess(iface);
+	{
+		LOCK(m_LazyMutex);
+		if (std::none_of(m_LazyLibraries.begin(), m_LazyLibraries.end(), matchFn)
+			&& std::none_of(m_LoadingLibraries.begin(), m_LoadingLibraries.end(), matchFn))
+			return Result::CreateFailure<PGreaperLib>("Couldn't find a pending GreaperLibrary."sv);
+	}
+
+	// Checked again once locked, a library loaded by another thread meanwhile is not pending anymore
+	LOCK(m_LazyLoadMutex);
+	LibraryManifest manifest;
+	{
+		LOCK(m_LazyMutex);
+		auto it = std::find_if(m_LazyLibraries.begin(), m_LazyLibraries.end(), matchFn);
+		if (it == m_LazyLibraries.end())
+			return Result::CreateFailure<PGreaperLib>("The pending GreaperLibrary has already been loaded."sv);
+		// Moved before loading, so the lookups done while registering don't load it again
+		manifest = *it;
+		m_LoadingLibraries.push_back(std::move(*it));
+		m_LazyLibraries.erase(it);
+	}
+
+	if (auto lib = m_Library.lock(); lib != nullptr)
+		lib->Log(Format("Loading the pending GreaperLibrary '%s' on first use.", manifest.LibraryName.c_str()));
+
+	auto res = RegisterGreaperLibrary(StringView{ manifest.LibraryPath });
+	{
+		LOCK(m_LazyMutex);
+		const auto it = std::find_if(m_LoadingLibraries.begin(), m_LoadingLibraries.end(),
+			[&manifest](const LibraryManifest& loading) { return loading.LibraryUUID == manifest.LibraryUUID; });
+		if (it != m_LoadingLibraries.end())
+			m_LoadingLibraries.erase(it);
+		m_LazyLibraryCount.store(m_LazyLibraries.size() + m_LoadingLibraries.size(), std::memory_order_release);
+	}
+	if (res.HasFailed())
+		return res;
+
+	const auto& gLib = res.GetValue();
+	if (gLib->GetLibraryUuid() != manifest.LibraryUUID || gLib->GetLibraryName() != manifest.LibraryName)
+	{
+		if (auto lib = m_Library.lock(); lib != nullptr)
+			lib->LogWarning(Format("The GreaperLibrary loaded from '%s' does not match its manifest, expected '%s' but obtained '%s'.",
+				manifest.LibraryPath.c_str(), manifest.LibraryName.c_str(), gLib->GetLibraryName().data()));
+	}
+	return res;
+}
+
+TResult<PGreaperLib> Application::LoadLazyLibrary(const Uuid& libraryUUID) noexcept
+{
+	return LoadLazyLibrary([&libraryUUID](const LibraryManifest& manifest) { return manifest.LibraryUUID == libraryUUID; });
+}
+
+TResult<PGreaperLib> Application::LoadLazyLibrary(const StringView& libraryName) noexcept
+{
+	return LoadLazyLibrary([&libraryName](const LibraryManifest& manifest) { return manifest.LibraryName == libraryName; });
+}
+
+void Application::LoadLazyLibraryIfPending(const Uuid& libraryUUID) const noexcept
+{
+	if (m_LazyLibraryCount.load(std::memory_order_acquire) == 0)
+		return;
+	{
+		SHAREDLOCK(m_LibraryMutex);
+		if (m_LibraryUuidMap.find(libraryUUID) != m_LibraryUuidMap.end())
+			return;
+	}
+	// The lookups are const, but the Application itself never is, loading registers the library
+	const_cast<Application*>(this)->LoadLazyLibrary(libraryUUID);
+}
+
+void Application::LoadLazyLibraryIfPending(const StringView& libraryName) const noexcept
+{
+	if (m_LazyLibraryCount.load(std::memory_order_acquire) == 0)
+		return;
+	{
+		SHAREDLOCK(m_LibraryMutex);
+		if (m_LibraryNameMap.find(libraryName) != m_LibraryNameMap.end())
+			return;
+	}
+	const_cast<Application*>(this)->LoadLazyLibrary(libraryName);
+}
+
+PInterface Application::LoadLazyInterface(const Uuid& interfaceUUID, const StringView& interfaceName) const noexcept
+{
+	if (m_LazyLibraryCount.load(std::memory_order_acquire) == 0)
+		return PInterface();
+
+	Uuid foundUUID;
+	Uuid libraryUUID;
+	// Same as LoadLazyLibraryIfPending, loading and activating are not const
+	auto* self = const_cast<Application*>(this);
+	self->LoadLazyLibrary([&](const LibraryManifest& manifest)
+		{
+			for (const auto& info : manifest.Interfaces)
+			{
+				if ((interfaceName.empty() && info.InterfaceUUID == interfaceUUID) || (!interfaceName.empty() && info.InterfaceName == interfaceName))
+				{
+					foundUUID = info.InterfaceUUID;
+					libraryUUID = manifest.LibraryUUID;
+					return true;
+				}
+			}
+			return false;
+		});
+	if (libraryUUID == Uuid{})
+		return PInterface(); // No pending library provides it
+
+	// Looked up even if the load failed, another thread may have loaded it while this one waited
+	auto ifaceRes = GetInterface(foundUUID, libraryUUID);
+	if (ifaceRes.HasFailed() || ifaceRes.GetValue() == nullptr)
+		return PInterface();
+
+	const auto& iface = ifaceRes.GetValue();
+	if (!iface->IsActive())
+	{
+		const auto activateRes = self->ActivateInterface(iface);
+		if (activateRes.HasFailed())
+			return PInterface();
+	}
+	return iface;
 }
 
 TResult<PInterface> Application::GetInterface(const Uuid& interfaceUUID, const Uuid& libraryUUID) const noexcept
 {
+	LoadLazyLibraryIfPending(libraryUUID);
+
+	SHAREDLOCK(m_LibraryMutex);
 	const auto libUuidIT = m_LibraryUuidMap.find(libraryUUID);
 	if (libUuidIT == m_LibraryUuidMap.end())
 	{
@@ -721,6 +1373,9 @@ TResult<PInterface> Application::GetInterface(const Uuid& interfaceUUID, const U
 
 TResult<PInterface> Application::GetInterface(const StringView& interfaceName, const StringView& libraryName) const noexcept
 {
+	LoadLazyLibraryIfPending(libraryName);
+
+	SHAREDLOCK(m_LibraryMutex);
 	const auto libNameIT = m_LibraryNameMap.find(libraryName);
 	if (libNameIT == m_LibraryNameMap.end())
 	{
@@ -746,6 +1401,9 @@ TResult<PInterface> Application::GetInterface(const StringView& interfaceName, c
 
 TResult<PInterface> Application::GetInterface(const Uuid& interfaceUUID, const StringView& libraryName) const noexcept
 {
+	LoadLazyLibraryIfPending(libraryName);
+
+	SHAREDLOCK(m_LibraryMutex);
 	const auto libNameIT = m_LibraryNameMap.find(libraryName);
 	if (libNameIT == m_LibraryNameMap.end())
 	{
@@ -771,6 +1429,9 @@ TResult<PInterface> Application::GetInterface(const Uuid& interfaceUUID, const S
 
 TResult<PInterface> Application::GetInterface(const StringView& interfaceName, const Uuid& libraryUUID) const noexcept
 {
+	LoadLazyLibraryIfPending(libraryUUID);
+
+	SHAREDLOCK(m_LibraryMutex);
 	const auto libUuidIT = m_LibraryUuidMap.find(libraryUUID);
 	if (libUuidIT == m_LibraryUuidMap.end())
 	{
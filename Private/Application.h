@@ -25,6 +25,8 @@ namespace greaper::core
 			ApplicationVersion,
 			CompilationInfo,
 			LoadedLibraries,
+			UpdateMaxRate,
+			FixedUpdateMaxRate,
 
 			COUNT
 		};
@@ -34,28 +36,105 @@ namespace greaper::core
 		struct LibInfo
 		{
 			PGreaperLib Lib;
-			UnorderedMap<StringView, sizet> IntefaceNameMap;
-			UnorderedMap<Uuid, sizet> InterfaceUuidMap;
-			Vector<PInterface> Interfaces;
+			FlatMap<StringView, sizet> IntefaceNameMap;
+			FlatMap<Uuid, sizet> InterfaceUuidMap;
+			SmallVector<PInterface, 8> Interfaces;
 		};
 
-		UnorderedMap<StringView, sizet> m_LibraryNameMap;
-		UnorderedMap<Uuid, sizet> m_LibraryUuidMap;
+		// Guards the registered libraries and their interfaces, never held while calling into a library
+		mutable RWMutex m_LibraryMutex;
+		FlatMap<StringView, sizet> m_LibraryNameMap;
+		FlatMap<Uuid, sizet> m_LibraryUuidMap;
 		Vector<LibInfo> m_Libraries;
 
 		mutable RecursiveMutex m_ActiveMutex;
-		UnorderedMap<StringView, sizet> m_ActiveInterfaceNameMap;
-		UnorderedMap<Uuid, sizet> m_ActiveInterfaceUuidMap;
+		FlatMap<StringView, sizet> m_ActiveInterfaceNameMap;
+		FlatMap<Uuid, sizet> m_ActiveInterfaceUuidMap;
 		Vector<PInterface> m_ActiveInterfaces;
 
 		Vector<PInterface> m_InterfaceToChange;
 		Vector<PInterface> m_InterfacesToRemove;
 		Vector<PInterface> m_InterfacesToAdd;
 
+		struct ActiveEntry
+		{
+			Uuid UUID;
+			StringView Name;
+			PInterface Interface;
+		};
+		// Copy of the active interfaces for lock-free lookups, republished on each change
+		RCUValue<Vector<ActiveEntry>> m_ActiveSnapshot;
+		std::atomic<uint64> m_ActiveGeneration{ 1 };
+
+		mutable PropertyRegistry m_PropertyRegistry;
+
+		// Created on first use, flushed and released before the interfaces are deactivated
+		Mutex m_BackgroundMutex;
+		PTaskScheduler m_BackgroundScheduler;
+		bool m_BackgroundStopped = false;
+
+		// Update loop, only touched by the thread that ticks except the running flag and the stats
+		static constexpr Duration_t MaxTickDelta = std::chrono::milliseconds(250);
+		static constexpr sizet MaxFixedStepsPerTick = 8;
+		static constexpr Duration_t PacingSpinTime = std::chrono::microseconds(1500);
+
+		std::atomic<bool> m_UpdateLoopRunning{ false };
+		TPropertyAccessor<uint32> m_UpdateMaxRateAccessor;
+		TPropertyAccessor<uint32> m_FixedUpdateMaxRateAccessor;
+		Timepoint_t m_LastTickTime{};
+		Duration_t m_FixedAccumulator{};
+		uint64 m_UpdateGeneration = 0;
+		Vector<PInterface> m_UpdateInterfaces;
+		Vector<PInterface> m_SerialUpdateInterfaces;
+		Vector<std::tuple<StringView, std::function<void()>>> m_ParallelUpdateTasks;
+		std::atomic<sizet> m_PendingUpdateTasks{ 0 };
+		PTaskScheduler m_UpdateScheduler;
+		UpdateStats m_CurrentStats;
+		SeqLockValue<UpdateStats> m_PublishedStats;
+
+		void RefreshUpdateInterfaces()noexcept;
+
+		void DispatchPhase(UpdatePhase_t phase)noexcept;
+
+		void WaitUntil(Timepoint_t deadline)noexcept;
+
 		EmptyResult RegisterGreaperLibrary(const PGreaperLib& gLib);
 
+		// Obtains the GreaperLibrary of an OS library, without registering it
+		static TResult<PGreaperLib> LoadGreaperLibrary(const PLibrary& library)noexcept;
+
+		void AddLoadedLibraryName(const PGreaperLib& gLib)noexcept;
+
+		void LogStartupReport(const Vector<PGreaperLib>& libraries, Duration_t wallTime)noexcept;
+
+		// Lazily registered libraries, moved to m_LoadingLibraries while they load and removed once loaded
+		mutable Mutex m_LazyMutex;
+		Vector<LibraryManifest> m_LazyLibraries;
+		Vector<LibraryManifest> m_LoadingLibraries;
+		// Pending and loading libraries
+		std::atomic<sizet> m_LazyLibraryCount{ 0 };
+		// Serializes the loads, recursive as a library may load another one while it initializes
+		RecursiveMutex m_LazyLoadMutex;
+
+		// Loads the first pending library accepted by matchFn, waits for it if another thread is loading it
+		TResult<PGreaperLib> LoadLazyLibrary(const std::function<bool(const LibraryManifest&)>& matchFn)noexcept;
+
+		TResult<PGreaperLib> LoadLazyLibrary(const Uuid& libraryUUID)noexcept;
+
+		TResult<PGreaperLib> LoadLazyLibrary(const StringView& libraryName)noexcept;
+
+		// Called by the lookups before locking the registry, loads the library if it's still pending
+		void LoadLazyLibraryIfPending(const Uuid& libraryUUID)const noexcept;
+
+		void LoadLazyLibraryIfPending(const StringView& libraryName)const noexcept;
+
+		// Loads the pending library that provides the interface and activates it
+		PInterface LoadLazyInterface(const Uuid& interfaceUUID, const StringView& interfaceName)const noexcept;
+
 		void UpdateActiveInterfaceList()noexcept;
 
+		void PublishActiveInterfaces()noexcept;
+
 	public:
 		Application();
 		~Application()noexcept;
@@ -76,6 +155,14 @@ namespace greaper::core
 
 		TResult<PGreaperLib> RegisterGreaperLibrary(PLibrary library)noexcept override;
 
+		TResult<Vector<PGreaperLib>> RegisterGreaperLibraries(const Vector<StringView>& libPaths)noexcept override;
+
+		TResult<Vector<PGreaperLib>> RegisterGreaperLibraries(const Vector<PLibrary>& libraries)noexcept override;
+
+		EmptyResult RegisterLazyGreaperLibrary(LibraryManifest manifest)noexcept override;
+
+		bool IsGreaperLibraryPending(const StringView& libraryName)const noexcept override;
+
 		TResult<PGreaperLib> GetGreaperLibrary(const StringView& libraryName)const noexcept override;
 
 		TResult<PGreaperLib> GetGreaperLibrary(const Uuid& libraryUUID)const noexcept override;
@@ -96,6 +183,10 @@ namespace greaper::core
 
 		TResult<PInterface> GetActiveInterface(const StringView& interfaceName)const noexcept override;
 
+		PInterface FindActiveInterface(const Uuid& interfaceUUID)const noexcept override;
+
+		const std::atomic<uint64>& GetActiveInterfacesGeneration()const noexcept override { return m_ActiveGeneration; }
+
 		TResult<PInterface> GetInterface(const Uuid& interfaceUUID, const Uuid& libraryUUID)const noexcept override;
 
 		TResult<PInterface> GetInterface(const StringView& interfaceName, const StringView& libraryName)const noexcept override;
@@ -118,16 +209,46 @@ namespace greaper::core
 
 		WPtr<AppInstanceProp_t> GetAppInstance()const noexcept override { return (WPtr<AppInstanceProp_t>)m_Properties[(std::size_t)AppInstance]; }
 
+		WPtr<UpdateMaxRateProp_t> GetUpdateMaxRate()const noexcept override { return (WPtr<UpdateMaxRateProp_t>)m_Properties[(std::size_t)UpdateMaxRate]; }
+
+		WPtr<FixedUpdateMaxRateProp_t> GetFixedUpdateMaxRate()const noexcept override { return (WPtr<FixedUpdateMaxRateProp_t>)m_Properties[(std::size_t)FixedUpdateMaxRate]; }
+
+		void Tick()noexcept override;
+
+		void RunUpdateLoop()noexcept override;
+
+		void StopUpdateLoop()noexcept override { m_UpdateLoopRunning.store(false, std::memory_order_release); }
+
+		bool IsUpdateLoopRunning()const noexcept override { return m_UpdateLoopRunning.load(std::memory_order_acquire); }
+
+		UpdateStats GetUpdateStats()const noexcept override { return m_PublishedStats.Load(); }
+
 		NODISCARD Vector<PGreaperLib> GetRegisteredLibrariesCopy()const noexcept override
 		{
-			Vector<PGreaperLib> vec{ m_Libraries.size()};
+			Vector<PGreaperLib> vec;
+			SHAREDLOCK(m_LibraryMutex);
+			vec.reserve(m_Libraries.size());
 			for (const LibInfo& lib : m_Libraries)
 				vec.push_back(lib.Lib);
 			
 			return vec;
 		}
 
-		NODISCARD Vector<PInterface> GetActiveInterfacesCopy()const noexcept override { LOCK(m_ActiveMutex); return Vector<PInterface>{m_ActiveInterfaces}; }
+		NODISCARD Vector<PInterface> GetActiveInterfacesCopy()const noexcept override
+		{
+			Vector<PInterface> vec;
+			const auto snapshot = m_ActiveSnapshot.Read();
+			if (!snapshot)
+				return vec;
+			vec.reserve(snapshot->size());
+			for (const auto& entry : *snapshot)
+				vec.push_back(entry.Interface);
+			return vec;
+		}
+
+		PropertyRegistry& GetPropertyRegistry()const noexcept override { return m_PropertyRegistry; }
+
+		EmptyResult AddBackgroundTask(StringView name, std::function<void()> workFn)noexcept override;
 	};
 }
 
@@ -0,0 +1,240 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#include "CommandHistory.h"
+
+using namespace greaper;
+using namespace core;
+
+CommandHistory::CommandHistory(sizet depth) noexcept
+{
+	m_Records.resize(Max(depth, (sizet)1));
+}
+
+CommandHistory::NameID_t CommandHistory::InternName(const String& name) noexcept
+{
+	const auto it = m_NameMap.find(name);
+	if (it != m_NameMap.end())
+		return it->second;
+
+	const auto id = (NameID_t)m_Names.size();
+	m_Names.push_back(NameEntry{ name, InvalidRecord });
+	m_NameMap.insert_or_assign(name, id);
+	return id;
+}
+
+uint32 CommandHistory::AllocArgs(sizet size) noexcept
+{
+	if (m_ArenaUsed + size > m_Arena.size())
+		CompactArena(size);
+
+	const auto offset = (uint32)m_ArenaUsed;
+	m_ArenaUsed += size;
+	return offset;
+}
+
+void CommandHistory::CompactArena(sizet extraSize) noexcept
+{
+	sizet liveSize = 0;
+	for (auto id = m_OldestID; id < m_NextID; ++id)
+	{
+		const auto& record = GetSlot(id);
+		if (record.Alive)
+			liveSize += record.ArgSize;
+	}
+
+	// Keep twice the needed size, so compactions stay rare
+	const auto required = liveSize + extraSize;
+	if (m_Arena.size() < required * 2)
+		m_Arena.resize(required * 2);
+	m_ArenaScratch.resize(m_Arena.size());
+
+	sizet used = 0;
+	for (auto id = m_OldestID; id < m_NextID; ++id)
+	{
+		auto& record = GetSlot(id);
+		if (!record.Alive)
+			continue;
+		memcpy(m_ArenaScratch.data() + used, m_Arena.data() + record.ArgOffset, record.ArgSize);
+		record.ArgOffset = (uint32)used;
+		used += record.ArgSize;
+	}
+	m_Arena.swap(m_ArenaScratch);
+	m_ArenaUsed = used;
+}
+
+void CommandHistory::DropOldest() noexcept
+{
+	auto& record = GetSlot(m_OldestID);
+	if (record.Alive)
+	{
+		auto& name = m_Names[record.Name];
+		if (name.Latest == record.ID)
+			name.Latest = InvalidRecord;
+		record.Alive = false;
+		--m_AliveCount;
+	}
+	++m_OldestID;
+}
+
+void CommandHistory::TrimDead() noexcept
+{
+	// Removed records are never referenced again, IDs at the newest end can be given again
+	while (m_NextID > m_OldestID && !GetSlot(m_NextID - 1).Alive)
+		--m_NextID;
+	while (m_OldestID < m_NextID && !GetSlot(m_OldestID).Alive)
+		++m_OldestID;
+	if (m_AliveCount == 0)
+		m_ArenaUsed = 0;
+}
+
+void CommandHistory::CompactRecords(sizet depth) noexcept
+{
+	while (m_AliveCount > depth)
+	{
+		DropOldest();
+		TrimDead();
+	}
+
+	// The name chains hold every alive record in order, so they are rebuilt as the records are moved
+	for (auto& name : m_Names)
+		name.Latest = InvalidRecord;
+
+	Vector<Record> records(depth);
+	RecordID_t newID = m_OldestID;
+	for (auto id = m_OldestID; id < m_NextID; ++id)
+	{
+		auto record = GetSlot(id);
+		if (!record.Alive)
+			continue;
+		auto& name = m_Names[record.Name];
+		record.ID = newID++;
+		record.PrevSameName = name.Latest;
+		name.Latest = record.ID;
+		records[(sizet)(record.ID % depth)] = record;
+	}
+	m_NextID = newID;
+	m_Records.swap(records);
+}
+
+void CommandHistory::SetDepth(sizet depth) noexcept
+{
+	depth = Max(depth, (sizet)1);
+	if (depth != m_Records.size())
+		CompactRecords(depth);
+}
+
+void CommandHistory::Push(const CommandInfo& info) noexcept
+{
+	if (m_NextID - m_OldestID == m_Records.size())
+	{
+		// Records undone by name leave holes, those are reclaimed before forgetting anything
+		if (m_AliveCount < m_Records.size())
+			CompactRecords(m_Records.size());
+		else
+			DropOldest();
+	}
+
+	sizet argSize = 0;
+	for (const auto& arg : info.CommandArgs)
+		argSize += sizeof(uint32) + arg.size();
+
+	const auto nameID = InternName(info.CommandName);
+	const auto offset = AllocArgs(argSize);
+	auto* dst = m_Arena.data() + offset;
+	for (const auto& arg : info.CommandArgs)
+	{
+		const auto len = (uint32)arg.size();
+		memcpy(dst, &len, sizeof(len));
+		memcpy(dst + sizeof(len), arg.data(), len);
+		dst += sizeof(len) + len;
+	}
+
+	auto& name = m_Names[nameID];
+	const auto id = m_NextID++;
+	auto& record = GetSlot(id);
+	record.ID = id;
+	record.PrevSameName = name.Latest;
+	record.Name = nameID;
+	record.ArgOffset = offset;
+	record.ArgSize = (uint32)argSize;
+	record.ArgCount = (uint32)info.CommandArgs.size();
+	record.Alive = true;
+	name.Latest = id;
+	++m_AliveCount;
+}
+
+CommandHistory::RecordID_t CommandHistory::FindLast() const noexcept
+{
+	// TrimDead keeps the newest record alive
+	return m_NextID > m_OldestID ? m_NextID - 1 : InvalidRecord;
+}
+
+CommandHistory::RecordID_t CommandHistory::FindLast(StringView name) const noexcept
+{
+	const auto it = m_NameMap.find(name);
+	if (it == m_NameMap.end())
+		return InvalidRecord;
+	return m_Names[it->second].Latest;
+}
+
+CommandInfo CommandHistory::GetInfo(RecordID_t id) const noexcept
+{
+	CommandInfo info;
+	if (id < m_OldestID || id >= m_NextID)
+		return info;
+	const auto& record = GetSlot(id);
+	if (!record.Alive)
+		return info;
+
+	info.CommandName = m_Names[record.Name].Name;
+	info.CommandArgs.reserve(record.ArgCount);
+	const auto* src = m_Arena.data() + record.ArgOffset;
+	for (uint32 i = 0; i < record.ArgCount; ++i)
+	{
+		uint32 len;
+		memcpy(&len, src, sizeof(len));
+		info.CommandArgs.emplace_back(src + sizeof(len), len);
+		src += sizeof(len) + len;
+	}
+	return info;
+}
+
+void CommandHistory::Remove(RecordID_t id) noexcept
+{
+	if (id < m_OldestID || id >= m_NextID)
+		return;
+	auto& record = GetSlot(id);
+	if (!record.Alive)
+		return;
+
+	// Only the latest record of a name can be removed, so the chain just moves back
+	auto& name = m_Names[record.Name];
+	VerifyEqual(name.Latest, id, "Trying to remove an undo record that is not the latest of its command.");
+	name.Latest = record.PrevSameName >= m_OldestID ? record.PrevSameName : InvalidRecord;
+	record.Alive = false;
+	--m_AliveCount;
+	TrimDead();
+}
+
+void CommandHistory::ForEach(const std::function<void(const CommandInfo&)>& fn) const noexcept
+{
+	for (auto id = m_NextID; id > m_OldestID; --id)
+	{
+		if (GetSlot(id - 1).Alive)
+			fn(GetInfo(id - 1));
+	}
+}
+
+void CommandHistory::Clear() noexcept
+{
+	for (auto& name : m_Names)
+		name.Latest = InvalidRecord;
+	for (auto& record : m_Records)
+		record.Alive = false;
+	m_OldestID = m_NextID;
+	m_AliveCount = 0;
+	m_ArenaUsed = 0;
+}
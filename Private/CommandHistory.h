@@ -0,0 +1,107 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef CORE_COMMAND_HISTORY_H
+#define CORE_COMMAND_HISTORY_H 1
+
+#include "ImplPrerequisites.h"
+#include "../Public/Base/ICommand.h"
+
+namespace greaper::core
+{
+	/**
+	 * @brief Undo records of the CommandManager, newest first.
+	 * Records live in a ring of fixed depth, once it is full the oldest one is dropped.
+	 * Command names are interned and the arguments are packed into a byte arena,
+	 * which is compacted instead of freed, so a full history stops allocating.
+	 * Each name keeps a chain to its records, so the latest one of a name is found
+	 * without scanning.
+	 * Records are identified by a sequence number, they are valid until removed or dropped.
+	 */
+	class CommandHistory
+	{
+	public:
+		using RecordID_t = uint64;
+		static constexpr RecordID_t InvalidRecord = std::numeric_limits<RecordID_t>::max();
+
+	private:
+		using NameID_t = uint32;
+
+		struct Record
+		{
+			RecordID_t ID = InvalidRecord;
+			RecordID_t PrevSameName = InvalidRecord;
+			NameID_t Name = 0;
+			uint32 ArgOffset = 0;
+			uint32 ArgSize = 0;
+			uint32 ArgCount = 0;
+			bool Alive = false;
+		};
+
+		struct NameEntry
+		{
+			String Name;
+			RecordID_t Latest = InvalidRecord;
+		};
+
+		Vector<Record> m_Records;
+		RecordID_t m_OldestID = 0; // First ID still in the ring
+		RecordID_t m_NextID = 0;
+		sizet m_AliveCount = 0;
+
+		Vector<NameEntry> m_Names;
+		FlatMap<String, NameID_t> m_NameMap;
+
+		Vector<char> m_Arena;
+		Vector<char> m_ArenaScratch;
+		sizet m_ArenaUsed = 0;
+
+		INLINE Record& GetSlot(RecordID_t id)noexcept { return m_Records[(sizet)(id % m_Records.size())]; }
+		INLINE const Record& GetSlot(RecordID_t id)const noexcept { return m_Records[(sizet)(id % m_Records.size())]; }
+
+		NameID_t InternName(const String& name)noexcept;
+
+		uint32 AllocArgs(sizet size)noexcept;
+
+		void CompactArena(sizet extraSize)noexcept;
+
+		void DropOldest()noexcept;
+
+		void TrimDead()noexcept;
+
+		// Moves the alive records together, giving them new IDs
+		void CompactRecords(sizet depth)noexcept;
+
+	public:
+		explicit CommandHistory(sizet depth)noexcept;
+
+		// Keeps the newest records that fit in the new depth
+		void SetDepth(sizet depth)noexcept;
+
+		NODISCARD INLINE sizet GetDepth()const noexcept { return m_Records.size(); }
+
+		// Records that can still be undone
+		NODISCARD INLINE sizet GetSize()const noexcept { return m_AliveCount; }
+
+		void Push(const CommandInfo& info)noexcept;
+
+		NODISCARD RecordID_t FindLast()const noexcept;
+
+		NODISCARD RecordID_t FindLast(StringView name)const noexcept;
+
+		NODISCARD CommandInfo GetInfo(RecordID_t id)const noexcept;
+
+		void Remove(RecordID_t id)noexcept;
+
+		// Calls fn(const CommandInfo&) from the newest to the oldest record
+		void ForEach(const std::function<void(const CommandInfo&)>& fn)const noexcept;
+
+		void Clear()noexcept;
+	};
+}
+
+#endif /* CORE_COMMAND_HISTORY_H */
@@ -4,13 +4,20 @@
 ***********************************************************************************/
 
 #include "CommandManager.h"
+#include "Application.h"
 #include "../Public/IGreaperLibrary.h"
 #include "../Public/StringUtils.h"
+#include "../Public/MPMCTaskScheduler.h"
 
 using namespace greaper;
 using namespace core;
 
 SPtr<CommandManager> gCommandManager = {};
+extern SPtr<Application> gApplication;
+
+// Set while a scheduled command runs, the commands it starts run inline, a worker waiting for
+// them could otherwise take every worker of the fixed size pool
+static thread_local bool tRunningScheduledCommand = false;
 
 void CommandManager::OnInitialization() noexcept
 {
@@ -24,71 +31,298 @@ void CommandManager::OnDeinitialization() noexcept
 
 void CommandManager::OnActivation(UNUSED const PInterface& oldDefault) noexcept
 {
+	PTaskScheduler scheduler;
+	auto thmgrRes = gApplication->GetActiveInterface(IThreadManager::InterfaceUUID);
+	if (thmgrRes.IsOk() && thmgrRes.GetValue() != nullptr)
+	{
+		const auto workerCount = (sizet)Max(std::thread::hardware_concurrency(), 2u) - 1;
+		auto schedulerRes = MPMCTaskScheduler::Create((WThreadManager)thmgrRes.GetValue(), "CommandWorkers"sv, workerCount, false);
+		if (schedulerRes.IsOk())
+			scheduler = schedulerRes.GetValue();
+		else if (!m_Library.expired()) // Executed on the calling thread
+			m_Library.lock()->LogWarning("Couldn't create the CommandWorkers scheduler, commands will run on the calling thread, reason: " + schedulerRes.GetFailMessage());
+	}
 
+	LOCK(m_CommandMutex);
+	m_Scheduler = std::move(scheduler);
+	m_Deactivating = false;
 }
 
 void CommandManager::OnDeactivation(UNUSED const PInterface& newDefault) noexcept
 {
+	// Set under the lock ScheduleCommand adds its tasks with, so no task is added once it's waited
+	{
+		LOCK(m_CommandMutex);
+		m_Deactivating = true;
+	}
+
+	// The console sends its commands to the scheduler, it has to stop first
+	SPtr<StdConsole> console;
+	{
+		LOCK(m_ConsoleMutex);
+		console = std::move(m_Console);
+	}
+	if (console != nullptr)
+		console->Stop();
 
+	PTaskScheduler scheduler;
+	{
+		LOCK(m_CommandMutex);
+		scheduler = std::move(m_Scheduler);
+	}
+	// The running commands need m_CommandMutex to finish, so it can't be held while waiting
+	if (scheduler != nullptr)
+		scheduler->WaitUntilAllTasksFinished();
+}
+
+void CommandManager::OnUndoDepthChanged(UNUSED IProperty* prop) noexcept
+{
+	const auto depth = m_UndoDepthAccessor.Get();
+	LOCK(m_CommandMutex);
+	m_History.SetDepth(depth);
 }
 
 void CommandManager::InitProperties() noexcept
 {
+	if (m_Library.expired())
+		return; // no base library weird
+
+	auto lib = m_Library.lock();
+
+	if (m_Properties.size() != (sizet)COUNT)
+		m_Properties.resize((sizet)COUNT, WIProperty());
 
+	WPtr<UndoDepthProp_t> undoDepthPropW;
+	auto result = lib->GetProperty(UndoDepthName);
+	if (result.IsOk())
+	{
+		undoDepthPropW = result.GetValue();
+	}
+	else
+	{
+		auto undoDepthResult = CreateProperty<uint32>(m_Library, UndoDepthName, DefaultUndoDepth, "Amount of commands that can be undone, older ones are forgotten."sv,
+			false, false, (SPtr<TPropertyValidator<uint32>>)ConstructShared<PropertyValidatorBounded<uint32>>(1u, 1u << 20));
+		Verify(undoDepthResult.IsOk(), "Couldn't create the property '%s' msg: %s", UndoDepthName.data(), undoDepthResult.GetFailMessage().c_str());
+		undoDepthPropW = (WPtr<UndoDepthProp_t>)undoDepthResult.GetValue();
+	}
+
+	auto undoDepthProp = undoDepthPropW.lock();
+	undoDepthProp->GetOnModificationEvent().Connect(m_OnUndoDepthProp, [this](IProperty* prop) { OnUndoDepthChanged(prop); });
+
+	m_Properties[(sizet)UndoDepthProp] = undoDepthPropW;
+	m_UndoDepthAccessor = TPropertyAccessor<uint32>(undoDepthProp);
+	OnUndoDepthChanged(undoDepthProp.get());
 }
 
 void CommandManager::DeinitProperties() noexcept
 {
+	m_OnUndoDepthProp.Disconnect();
+	m_UndoDepthAccessor.Reset();
 
+	for (auto& prop : m_Properties)
+		prop.reset();
 }
 
-EmptyResult CommandManager::HandleCommand(const CommandInfo& info) noexcept
+TResult<PCommand> CommandManager::FindCommand(const String& cmdName) const noexcept
 {
-	auto lck = Lock(m_CommandMutex);
-	const auto findIT = m_CommandMap.find(info.CommandName);
-	if (findIT == m_CommandMap.end())
-		return Result::CreateFailure(Format("Couldn't find a command named '%s'.", info.CommandName.c_str()));
-	
-	auto cmdIdx = findIT->second;
-	if (m_Commands.size() <= cmdIdx)
-		return Result::CreateFailure(Format("Something was wrong trying to find the command '%s'.", info.CommandName.c_str()));
+	const auto* cmdIdx = m_CommandIndex.Find(cmdName);
+	if (cmdIdx == nullptr)
+	{
+		String msg = Format("Couldn't find a command named '%s'.", cmdName.c_str());
+		const auto suggestions = FindSimilarCommands(cmdName, 3);
+		if (!suggestions.empty())
+			msg += " Did you mean: " + StringUtils::ComposeString(suggestions, String(", ")) + '?';
+		return Result::CreateFailure<PCommand>(msg);
+	}
 
-	auto& cmd = m_Commands[cmdIdx];
+	if (m_Commands.size() <= *cmdIdx)
+		return Result::CreateFailure<PCommand>(Format("Something was wrong trying to find the command '%s'.", cmdName.c_str()));
+
+	const auto& cmd = m_Commands[*cmdIdx];
 	if (cmd == nullptr)
-		return Result::CreateFailure(Format("Trying call the command '%s', but was nullptr.", info.CommandName.c_str()));
+		return Result::CreateFailure<PCommand>(Format("Trying call the command '%s', but was nullptr.", cmdName.c_str()));
 
 	if (!cmd->IsActive())
-		return Result::CreateFailure(Format("Trying to call the command '%s', but was inactive.", info.CommandName.c_str()));
+		return Result::CreateFailure<PCommand>(Format("Trying to call the command '%s', but was inactive.", cmdName.c_str()));
+
+	return Result::CreateSuccess((PCommand)cmd);
+}
 
+EmptyResult CommandManager::ExecuteCommand(const PCommand& cmd, const CommandInfo& info) noexcept
+{
 	auto lib = m_Library.lock();
-	lib->LogVerbose(Format("Handling Command: %s(%s).",
-		info.CommandName.c_str(), StringUtils::ComposeString(info.CommandArgs).c_str()));
+	if (lib != nullptr)
+	{
+		lib->LogVerbose(Format("Handling Command: %s(%s).",
+			info.CommandName.c_str(), StringUtils::ComposeString(info.CommandArgs).c_str()));
+	}
 
-	const auto result = cmd->DoCommand(info.CommandArgs);
+	auto result = cmd->DoCommand(info.CommandArgs);
 
 	if (cmd->CanBeUndone() && result.IsOk())
 	{
-		m_DoneCommands.push_front(info);
+		LOCK(m_CommandMutex);
+		m_History.Push(info);
 	}
 
 	return result;
 }
 
+std::future<EmptyResult> CommandManager::ScheduleCommand(PCommand cmd, CommandInfo info) noexcept
+{
+	auto promise = ConstructShared<std::promise<EmptyResult>>();
+	auto future = promise->get_future();
+
+	const String taskName = info.CommandName;
+	std::function<void()> workFn = [this, promise, cmd = std::move(cmd), info = std::move(info)]()
+		{
+			const bool wasRunning = tRunningScheduledCommand;
+			tRunningScheduledCommand = true;
+			promise->set_value(ExecuteCommand(cmd, info));
+			tRunningScheduledCommand = wasRunning;
+		};
+
+	if (!tRunningScheduledCommand)
+	{
+		SHAREDLOCK(m_CommandMutex);
+		if (m_Deactivating)
+		{
+			promise->set_value(Result::CreateFailure(Format("Couldn't run the command '%s', the CommandManager is being deactivated.", taskName.c_str())));
+			return future;
+		}
+		if (m_Scheduler != nullptr && m_Scheduler->AddTask(taskName, workFn).IsOk())
+			return future;
+	}
+	workFn();
+	return future;
+}
+
+EmptyResult CommandManager::HandleCommand(const CommandInfo& info) noexcept
+{
+	PCommand cmd;
+	{
+		SHAREDLOCK(m_CommandMutex);
+		auto cmdRes = FindCommand(info.CommandName);
+		if (cmdRes.HasFailed())
+			return Result::CopyFailure(cmdRes);
+		cmd = cmdRes.GetValue();
+	}
+	return ExecuteCommand(cmd, info);
+}
+
+std::future<EmptyResult> CommandManager::HandleCommandAsync(CommandInfo info) noexcept
+{
+	PCommand cmd;
+	{
+		SHAREDLOCK(m_CommandMutex);
+		auto cmdRes = FindCommand(info.CommandName);
+		if (cmdRes.HasFailed())
+		{
+			std::promise<EmptyResult> promise;
+			promise.set_value(Result::CopyFailure(cmdRes));
+			return promise.get_future();
+		}
+		cmd = cmdRes.GetValue();
+	}
+	return ScheduleCommand(std::move(cmd), std::move(info));
+}
+
+EmptyResult CommandManager::RunCommandScript(StringView script) noexcept
+{
+	struct ScriptCommand
+	{
+		sizet Line;
+		CommandInfo Info;
+		PCommand Command;
+	};
+
+	Vector<ScriptCommand> commands;
+	sizet lineNum = 0;
+	for (sizet pos = 0; pos < script.size();)
+	{
+		auto lineEnd = script.find('\n', pos);
+		if (lineEnd == StringView::npos)
+			lineEnd = script.size();
+		auto line = script.substr(pos, lineEnd - pos);
+		pos = lineEnd + 1;
+		++lineNum;
+
+		const auto first = line.find_first_not_of(" \t\r");
+		if (first == StringView::npos || line[first] == '#')
+			continue;
+		line = line.substr(first, line.find_last_not_of(" \t\r") - first + 1);
+
+		auto infoRes = CommandInfo::FromConsole(String(line));
+		if (infoRes.HasFailed())
+			return Result::CreateFailure(Format("[CommandManager]::RunCommandScript Couldn't parse line %" PRIuPTR ", reason: %s", lineNum, infoRes.GetFailMessage().c_str()));
+		commands.push_back(ScriptCommand{ lineNum, std::move(infoRes.GetValue()), PCommand() });
+	}
+
+	bool parallel;
+	{
+		SHAREDLOCK(m_CommandMutex);
+		if (m_Deactivating)
+			return Result::CreateFailure("[CommandManager]::RunCommandScript Couldn't run the script, the CommandManager is being deactivated."sv);
+		for (auto& command : commands)
+		{
+			auto cmdRes = FindCommand(command.Info.CommandName);
+			if (cmdRes.HasFailed())
+				return Result::CreateFailure(Format("[CommandManager]::RunCommandScript Couldn't resolve line %" PRIuPTR ", reason: %s", command.Line, cmdRes.GetFailMessage().c_str()));
+			command.Command = cmdRes.GetValue();
+		}
+		// A script run from a scheduled command runs every line inline, see ScheduleCommand
+		parallel = m_Scheduler != nullptr && !tRunningScheduledCommand;
+	}
+
+	Vector<std::future<EmptyResult>> results;
+	for (sizet i = 0; i < commands.size();)
+	{
+		// Conflicting commands break the script into batches, the ones in between can overlap
+		sizet batchEnd = i + 1;
+		if (parallel && commands[i].Command->CanRunInParallel())
+		{
+			while (batchEnd < commands.size() && commands[batchEnd].Command->CanRunInParallel())
+				++batchEnd;
+		}
+
+		results.clear();
+		for (sizet j = i; j < batchEnd - 1; ++j)
+			results.push_back(ScheduleCommand(commands[j].Command, std::move(commands[j].Info)));
+		// The calling thread would wait anyway, so it runs the last command of the batch
+		const auto lastResult = ExecuteCommand(commands[batchEnd - 1].Command, commands[batchEnd - 1].Info);
+
+		String failures;
+		for (sizet j = 0; j < results.size(); ++j)
+		{
+			const auto res = results[j].get();
+			if (res.HasFailed())
+				failures += Format("Line %" PRIuPTR " failed, reason: %s\n", commands[i + j].Line, res.GetFailMessage().c_str());
+		}
+		if (lastResult.HasFailed())
+			failures += Format("Line %" PRIuPTR " failed, reason: %s\n", commands[batchEnd - 1].Line, lastResult.GetFailMessage().c_str());
+		if (!failures.empty())
+			return Result::CreateFailure("[CommandManager]::RunCommandScript Stopped the script:\n" + failures);
+
+		i = batchEnd;
+	}
+	return Result::CreateSuccess();
+}
+
 EmptyResult CommandManager::UndoLastCommand() noexcept
 {
 	auto lck = Lock(m_CommandMutex);
-	if (!m_DoneCommands.empty())
+	const auto recordID = m_History.FindLast();
+	if (recordID != CommandHistory::InvalidRecord)
 	{
-		CommandInfo& info = m_DoneCommands.front();
-		const auto findIT = m_CommandMap.find(info.CommandName);
-		if (findIT == m_CommandMap.end())
+		const auto info = m_History.GetInfo(recordID);
+		const auto* cmdIdx = m_CommandIndex.Find(info.CommandName);
+		if (cmdIdx == nullptr)
 			return Result::CreateFailure(Format("Couldn't find a command named '%s'.", info.CommandName.c_str()));
 		
-		auto cmdIdx = findIT->second;
-		if (m_Commands.size() <= cmdIdx)
+		if (m_Commands.size() <= *cmdIdx)
 			return Result::CreateFailure(Format("Something was wrong trying to find the command '%s'.", info.CommandName.c_str()));
 
-		auto& cmd = m_Commands[cmdIdx];
+		auto& cmd = m_Commands[*cmdIdx];
 		if (cmd == nullptr)
 			return Result::CreateFailure(Format("Trying to undo the command '%s', but was nullptr.", info.CommandName.c_str()));
 
@@ -100,7 +334,7 @@ EmptyResult CommandManager::UndoLastCommand() noexcept
 			info.CommandName.c_str(), StringUtils::ComposeString(info.CommandArgs).c_str()));
 
 		const auto result = cmd->UndoCommand(info.CommandArgs);
-		m_DoneCommands.pop_front();
+		m_History.Remove(recordID);
 		return result;
 	}
 	return Result::CreateSuccess();
@@ -110,40 +344,33 @@ EmptyResult CommandManager::UndoCommand(const String& cmdName) noexcept
 {
 	auto lck = Lock(m_CommandMutex);
 
-	auto cmdInfo = m_DoneCommands.end();
-	for (auto it = m_DoneCommands.begin(); it != m_DoneCommands.end(); ++it)
-	{
-		if (it->CommandName == cmdName)
-		{
-			cmdInfo = it;
-			break;
-		}
-	}
-	if (cmdInfo == m_DoneCommands.end())
+	const auto recordID = m_History.FindLast(cmdName);
+	if (recordID == CommandHistory::InvalidRecord)
 		return Result::CreateFailure(Format("The command '%s' was not done.", cmdName.c_str()));
 
-	const auto findIT = m_CommandMap.find(cmdName);
-	if (findIT == m_CommandMap.end())
+	const auto* cmdIdx = m_CommandIndex.Find(cmdName);
+	if (cmdIdx == nullptr)
 		return Result::CreateFailure(Format("Couldn't find a command named '%s'.", cmdName.c_str()));
 
-	auto cmdIdx = findIT->second;
-	if (m_Commands.size() <= cmdIdx)
+	if (m_Commands.size() <= *cmdIdx)
 		return Result::CreateFailure(Format("Something was wrong trying to find the command '%s'.", cmdName.c_str()));
 
-	auto& cmd = m_Commands[cmdIdx];
+	auto& cmd = m_Commands[*cmdIdx];
 	if (cmd == nullptr)
 		return Result::CreateFailure(Format("Trying to undo the command '%s', but was nullptr.", cmdName.c_str()));
 
 	if (!cmd->IsActive())
 		return Result::CreateFailure(Format("Trying to undo the command '%s', but was inactive.", cmdName.c_str()));
 
+	const auto info = m_History.GetInfo(recordID);
+
 	auto lib = m_Library.lock();
 	lib->LogVerbose(Format("Undoing Command: %s(%s).",
-		cmdName.c_str(), StringUtils::ComposeString(cmdInfo->CommandArgs).c_str()));
+		cmdName.c_str(), StringUtils::ComposeString(info.CommandArgs).c_str()));
 
-	const auto result = cmd->UndoCommand(cmdInfo->CommandArgs);
+	const auto result = cmd->UndoCommand(info.CommandArgs);
 
-	m_DoneCommands.erase(cmdInfo);
+	m_History.Remove(recordID);
 
 	return result;
 }
@@ -152,12 +379,23 @@ EmptyResult CommandManager::AddCommand(PCommand cmd) noexcept
 {
 	auto lck = Lock(m_CommandMutex);
 
-	const auto findIT = m_CommandMap.find(cmd->GetCommandName());
-	if (findIT != m_CommandMap.end())
+	if (m_CommandIndex.Contains(cmd->GetCommandName()))
 		return Result::CreateFailure(Format("Trying to add the command '%s', but was already added.", cmd->GetCommandName().c_str()));
 
-	m_CommandMap.insert_or_assign(cmd->GetCommandName(), m_Commands.size());
-	m_Commands.push_back(std::move(cmd));
+	// Slots of removed commands are reused, plugins may add and remove commands many times
+	sizet cmdIdx;
+	if (!m_FreeCommandSlots.empty())
+	{
+		cmdIdx = m_FreeCommandSlots.back();
+		m_FreeCommandSlots.pop_back();
+	}
+	else
+	{
+		cmdIdx = m_Commands.size();
+		m_Commands.emplace_back();
+	}
+	m_CommandIndex.Insert(cmd->GetCommandName(), cmdIdx);
+	m_Commands[cmdIdx] = std::move(cmd);
 	return Result::CreateSuccess();
 }
 
@@ -165,30 +403,34 @@ EmptyResult CommandManager::RemoveCommand(const String& cmdName) noexcept
 {
 	auto lck = Lock(m_CommandMutex);
 
-	const auto findIT = m_CommandMap.find(cmdName);
-	if (findIT == m_CommandMap.end())
+	const auto* found = m_CommandIndex.Find(cmdName);
+	if (found == nullptr)
 		return Result::CreateFailure(Format("Trying to remove the command '%s', but was not found.", cmdName.c_str()));
 
-	if (findIT->second >= m_Commands.size())
-		return Result::CreateFailure(Format("Trying to remove the command '%s', but the CommandMap was pointing outside the CommandVec.", cmdName.c_str()));
+	const auto cmdIdx = *found;
+	if (cmdIdx >= m_Commands.size())
+		return Result::CreateFailure(Format("Trying to remove the command '%s', but the CommandIndex was pointing outside the CommandVec.", cmdName.c_str()));
 
-	auto& cmd = m_Commands[findIT->second];
-	cmd.reset();
-	m_CommandMap.erase(findIT);
+	m_Commands[cmdIdx].reset();
+	m_CommandIndex.Erase(cmdName);
+	if (cmdIdx + 1 == m_Commands.size())
+		m_Commands.pop_back();
+	else
+		m_FreeCommandSlots.push_back(cmdIdx);
 	return Result::CreateSuccess();
 }
 
 TResult<PCommand> CommandManager::GetCommand(const String& cmdName) const noexcept
 {
 	auto lck = SharedLock(m_CommandMutex);
-	const auto findIT = m_CommandMap.find(cmdName);
-	if (findIT == m_CommandMap.end())
+	const auto* cmdIdx = m_CommandIndex.Find(cmdName);
+	if (cmdIdx == nullptr)
 		return Result::CreateFailure<PCommand>(Format("Couldn't find the command '%s'.", cmdName.c_str()));
 	
-	if (findIT->second >= m_Commands.size())
+	if (*cmdIdx >= m_Commands.size())
 		return Result::CreateFailure<PCommand>(Format("Something was wrong trying to find the command '%s'.", cmdName.c_str()));
 
-	auto& cmd = m_Commands[findIT->second];
+	auto& cmd = m_Commands[*cmdIdx];
 	if (cmd == nullptr)
 		return Result::CreateFailure<PCommand>(Format("trying to get the command '%s', but was nullptr.", cmdName.c_str()));
 	return Result::CreateSuccess((PCommand)cmd);
@@ -197,18 +439,100 @@ TResult<PCommand> CommandManager::GetCommand(const String& cmdName) const noexce
 bool CommandManager::HasCommand(const String& cmdName) const noexcept
 {
 	auto lck = SharedLock(m_CommandMutex);
-	return m_CommandMap.find(cmdName) != m_CommandMap.end();
+	return m_CommandIndex.Contains(cmdName);
 }
 
-void CommandManager::AccessCommandStack(const std::function<void(CSpan<CommandInfo>)>& accessFn) const noexcept
+Vector<String> CommandManager::FindSimilarCommands(StringView cmdName, sizet maxSuggestions) const noexcept
+{
+	// Allow roughly one typo every three characters
+	const auto maxDistance = Max(cmdName.size() / 3, (sizet)1);
+	Vector<std::pair<sizet, String>> found;
+	m_CommandIndex.ForEachSimilar(cmdName, maxDistance, [&found](StringView name, UNUSED const sizet& cmdIdx, sizet distance)
+		{
+			found.emplace_back(distance, String(name));
+		});
+	// Keys come sorted, so the closest ones keep their lexicographic order
+	std::stable_sort(found.begin(), found.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+	Vector<String> suggestions;
+	suggestions.reserve(Min(found.size(), maxSuggestions));
+	for (sizet i = 0; i < found.size() && i < maxSuggestions; ++i)
+		suggestions.push_back(std::move(found[i].second));
+	return suggestions;
+}
+
+Vector<String> CommandManager::GetCommandsWithPrefix(StringView prefix) const noexcept
+{
+	auto lck = SharedLock(m_CommandMutex);
+	Vector<String> names;
+	m_CommandIndex.ForEachWithPrefix(prefix, [&names](StringView name, UNUSED const sizet& cmdIdx)
+		{
+			names.emplace_back(name);
+		});
+	return names;
+}
+
+String CommandManager::CompleteCommand(StringView prefix) const noexcept
 {
 	auto lck = SharedLock(m_CommandMutex);
-	accessFn(CreateSpan(m_DoneCommands));
+	return m_CommandIndex.GetCompletion(prefix);
+}
+
+Vector<String> CommandManager::SuggestCommands(StringView cmdName, sizet maxSuggestions) const noexcept
+{
+	auto lck = SharedLock(m_CommandMutex);
+	return FindSimilarCommands(cmdName, maxSuggestions);
+}
+
+void CommandManager::AccessCommandStack(const std::function<void(CSpan<CommandInfo>)>& accessFn) const noexcept
+{
+	Vector<CommandInfo> commands;
+	{
+		auto lck = SharedLock(m_CommandMutex);
+		commands.reserve(m_History.GetSize());
+		m_History.ForEach([&commands](const CommandInfo& info) { commands.push_back(info); });
+	}
+	accessFn(CreateSpan(std::as_const(commands)));
 }
 
-PConsole CommandManager::GetConsole() const noexcept { return m_Console; }
+PConsole CommandManager::GetConsole() const noexcept
+{
+	LOCK(m_ConsoleMutex);
+	return (PConsole)m_Console;
+}
+
+WCommandManager CommandManager::GetWeakSelf() const noexcept
+{
+	auto lib = m_Library.lock();
+	if (lib == nullptr)
+		return {};
+	for (const auto& manager : lib->GetManagers())
+	{
+		if (manager.get() == (const IInterface*)this)
+			return (WCommandManager)(const PCommandManager&)manager;
+	}
+	return {};
+}
 
 EmptyResult CommandManager::CreateConsole() noexcept
 {
-	return Result::CreateFailure("Not Implemented"sv);
+	// Held while the console starts, so two callers can't both create one
+	LOCK(m_ConsoleMutex);
+	if (m_Console != nullptr)
+		return Result::CreateFailure("Trying to create the console, but was already created."sv);
+
+	auto thmgrRes = gApplication->GetActiveInterface(IThreadManager::InterfaceUUID);
+	if (thmgrRes.HasFailed())
+		return Result::CreateFailure("Trying to create the console, but couldn't obtain a ThreadManager, reason: " + thmgrRes.GetFailMessage());
+
+	auto self = GetWeakSelf();
+	if (self.expired())
+		return Result::CreateFailure("Trying to create the console, but the CommandManager is not registered in its library."sv);
+
+	auto consoleRes = StdConsole::Create((WThreadManager)thmgrRes.GetValue(), std::move(self));
+	if (consoleRes.HasFailed())
+		return Result::CopyFailure(consoleRes);
+
+	m_Console = consoleRes.GetValue();
+	return Result::CreateSuccess();
 }
\ No newline at end of file
@@ -10,17 +10,56 @@
 
 #include "ImplPrerequisites.h"
 #include "../Public/ICommandManager.h"
+#include "../Public/Base/RadixTrie.h"
+#include "../Public/Property.h"
+#include "../Public/StdConsole.h"
+#include "CommandHistory.h"
 
 namespace greaper::core
 {
 	class CommandManager final : public ICommandManager
 	{
+		enum PropertiesIndices
+		{
+			UndoDepthProp,
+
+			COUNT
+		};
+
+		static constexpr uint32 DefaultUndoDepth = 256;
+
+		UndoDepthProp_t::ModificationEventHandler_t m_OnUndoDepthProp;
+		TPropertyAccessor<uint32> m_UndoDepthAccessor;
+
 		Vector<PCommand> m_Commands;
-		UnorderedMap<String, std::size_t> m_CommandMap;
-		Deque<CommandInfo> m_DoneCommands;
+		Vector<sizet> m_FreeCommandSlots;
+		RadixTrie<sizet> m_CommandIndex;
+		CommandHistory m_History{ DefaultUndoDepth };
 		mutable RWMutex m_CommandMutex;
+		PTaskScheduler m_Scheduler;
+		// Guarded by m_CommandMutex, no command is scheduled once it's set
+		bool m_Deactivating = false;
+
+		// Not m_CommandMutex, stopping the console waits for its thread, which may be running a command
+		mutable Mutex m_ConsoleMutex;
+		SPtr<StdConsole> m_Console;
+
+		void OnUndoDepthChanged(IProperty* prop)noexcept;
+
+		// m_CommandMutex must be held
+		TResult<PCommand> FindCommand(const String& cmdName)const noexcept;
+
+		// m_CommandMutex must be held
+		Vector<String> FindSimilarCommands(StringView cmdName, sizet maxSuggestions)const noexcept;
 
-		PConsole m_Console;
+		// Runs the command without holding m_CommandMutex, only taken to store it if it can be undone
+		EmptyResult ExecuteCommand(const PCommand& cmd, const CommandInfo& info)noexcept;
+
+		// The shared pointer the library holds for this manager
+		WCommandManager GetWeakSelf()const noexcept;
+
+		// Runs inline without a scheduler or from a scheduled command, fails once the deactivation started
+		std::future<EmptyResult> ScheduleCommand(PCommand cmd, CommandInfo info)noexcept;
 
 	public:
 		CommandManager()noexcept = default;
@@ -40,6 +79,10 @@ namespace greaper::core
 
 		EmptyResult HandleCommand(const CommandInfo& info)noexcept override;
 
+		std::future<EmptyResult> HandleCommandAsync(CommandInfo info)noexcept override;
+
+		EmptyResult RunCommandScript(StringView script)noexcept override;
+
 		EmptyResult UndoLastCommand()noexcept override;
 
 		EmptyResult UndoCommand(const String& cmdName)noexcept override;
@@ -52,6 +95,14 @@ namespace greaper::core
 
 		bool HasCommand(const String& cmdName)const noexcept override;
 
+		WPtr<UndoDepthProp_t> GetUndoDepth()const noexcept override { return (WPtr<UndoDepthProp_t>)m_Properties[(sizet)UndoDepthProp]; }
+
+		Vector<String> GetCommandsWithPrefix(StringView prefix)const noexcept override;
+
+		String CompleteCommand(StringView prefix)const noexcept override;
+
+		Vector<String> SuggestCommands(StringView cmdName, sizet maxSuggestions = 3)const noexcept override;
+
 		void AccessCommandStack(const std::function<void(CSpan<CommandInfo>)>& accessFn)const noexcept override;
 
 		PConsole GetConsole()const noexcept override;
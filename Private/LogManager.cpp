@@ -19,8 +19,7 @@ void LogManager::OnAsyncChanged(IProperty* prop)
 	if (prop == nullptr || !IsActive())
 		return;
 
-	auto* async = (AsyncLogProp_t*)prop;
-	bool asyncVal = async->GetValueCopy();
+	const bool asyncVal = m_AsyncLogAccessor.Get();
 	if (m_Threaded == asyncVal)
 		return; // no change
 
@@ -33,7 +32,8 @@ void LogManager::OnAsyncChanged(IProperty* prop)
 void LogManager::StartThreadMode()
 {
 #if LOGMANAGER_USE_MPMC
-	m_Threaded = true;
+	// Without a scheduler the logs are written synchronously
+	m_Threaded = m_Scheduler != nullptr;
 #else
 	VerifyNot(m_Library.expired(), "Trying to set as async LogManager, but its library has expired.");
 	auto lib = m_Library.lock();
@@ -43,7 +43,7 @@ void LogManager::StartThreadMode()
 	{
 		lib->LogError("Trying to set as async LogManager, but couldn't obtain a ThreadManager, reason: " + thmgrRes.GetFailMessage());
 		m_Threaded = false;
-		GetAsyncLog().lock()->SetValue(false, true);
+		m_AsyncLogAccessor.Set(false, true);
 		return;
 	}
 	auto thmgr = (PThreadManager)thmgrRes.GetValue();
@@ -51,7 +51,7 @@ void LogManager::StartThreadMode()
 	{
 		lib->LogError("Trying to set as async LogManager, but couldn't obtain a ThreadManager.");
 		m_Threaded = false;
-		GetAsyncLog().lock()->SetValue(false, true);
+		m_AsyncLogAccessor.Set(false, true);
 		return;
 	}
 
@@ -65,7 +65,7 @@ void LogManager::StartThreadMode()
 	{
 		lib->LogError("Trying to enable async LogManager, but couldn't create a Thread, reason: " + thRes.GetFailMessage());
 		m_Threaded = false;
-		GetAsyncLog().lock()->SetValue(false, true);
+		m_AsyncLogAccessor.Set(false, true);
 		return;
 	}
 	m_AsyncThread = thRes.GetValue();
@@ -177,19 +177,18 @@ void LogManager::OnActivation(const PInterface& oldDefault) noexcept
 	
 #if LOGMANAGER_USE_MPMC
 	auto thmgrRes = gApplication->GetActiveInterface(IThreadManager::InterfaceUUID);
+	m_Scheduler.reset();
 	if (thmgrRes.IsOk())
 	{
-		m_Scheduler = MPMCTaskScheduler::Create((WThreadManager)thmgrRes.GetValue(), "AsyncLogger"sv, 1, false);
-	}
-	else
-	{
-		m_Scheduler.reset();
+		auto schedulerRes = MPMCTaskScheduler::Create((WThreadManager)thmgrRes.GetValue(), "AsyncLogger"sv, 1, false);
+		if (schedulerRes.IsOk())
+			m_Scheduler = schedulerRes.GetValue();
+		else if (!m_Library.expired()) // Logged synchronously
+			m_Library.lock()->LogWarning("Couldn't create the AsyncLogger scheduler, logs will be written synchronously, reason: " + schedulerRes.GetFailMessage());
 	}
 #endif
 
-	auto asyncProp = GetAsyncLog().lock();
-
-	bool asyncVal = asyncProp->GetValueCopy();
+	const bool asyncVal = m_AsyncLogAccessor.Get();
 	if (asyncVal)
 	{
 		StartThreadMode();
@@ -241,11 +240,13 @@ void LogManager::InitProperties()noexcept
 	asyncLogProp->GetOnModificationEvent().Connect(m_OnAsyncProp, [this](IProperty* prop) { OnAsyncChanged(prop); });
 
 	m_Properties[(sizet)AsyncProp] = asyncLogPropW;
+	m_AsyncLogAccessor = TPropertyAccessor<bool>(asyncLogProp);
 }
 
 void LogManager::DeinitProperties()noexcept
 {
 	m_OnAsyncProp.Disconnect();
+	m_AsyncLogAccessor.Reset();
 
 	for (auto& prop : m_Properties)
 		prop.reset();
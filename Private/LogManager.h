@@ -26,6 +26,7 @@ namespace greaper::core
 		};
 
 		AsyncLogProp_t::ModificationEventHandler_t m_OnAsyncProp;
+		TPropertyAccessor<bool> m_AsyncLogAccessor;
 
 #if !LOGMANAGER_USE_MPMC
 		Vector<LogData> m_QueuedMessages;
@@ -16,24 +16,82 @@ void ThreadManager::OnThreadDestruction(const PThread& thread) noexcept
 	if (thread == nullptr || !IsActive())
 		return; // thread was nullptr or manager not active
 
-	LOCK(m_ThreadMutex);
-	sizet threadIDX;
-	if (const auto findIDIT = m_ThreadIDMap.find(thread->GetID());
-		findIDIT != m_ThreadIDMap.end())
+	ThreadLookup lookup;
 	{
-		threadIDX = findIDIT->second;
+		LOCK(m_ThreadMutex);
+		// The OS may have given the ID to a newer thread, only the entries of this one are removed
+		const auto findSlot = [this, &thread](const auto& map, const auto& key, ThreadSlot& slot)
+		{
+			const auto it = map.find(key);
+			if (it == map.end())
+				return false;
+			slot = it->second;
+			return m_SlotGenerations[slot.Index] == slot.Generation && m_Threads[slot.Index] == thread;
+		};
+
+		ThreadSlot slot{};
+		const bool foundByID = findSlot(m_ThreadIDMap, thread->GetID(), slot);
+		if (!foundByID && !findSlot(m_ThreadNameMap, thread->GetName(), slot))
+			return; // Not found
+
+		if (foundByID)
+			m_ThreadIDMap.erase(thread->GetID());
+		if (const auto nameIT = m_ThreadNameMap.find(thread->GetName());
+			nameIT != m_ThreadNameMap.end() && nameIT->second == slot)
+		{
+			m_ThreadNameMap.erase(nameIT);
+		}
+
+		m_Threads[slot.Index].reset();
+		++m_SlotGenerations[slot.Index];
+		m_FreeSlots.push_back(slot.Index);
+		lookup = BuildThreadLookup();
 	}
-	else if (const auto findNameIT = m_ThreadNameMap.find(thread->GetName());
-		findNameIT != m_ThreadNameMap.end())
+	PublishThreadLookup(std::move(lookup));
+}
+
+void ThreadManager::AddThread(const PThread& thread) noexcept
+{
+	uint32 index;
+	if (!m_FreeSlots.empty())
 	{
-		threadIDX = findNameIT->second;
+		index = m_FreeSlots.back();
+		m_FreeSlots.pop_back();
+		m_Threads[index] = thread;
 	}
 	else
 	{
-		return; // Not found
+		index = (uint32)m_Threads.size();
+		m_Threads.push_back(thread);
+		m_SlotGenerations.push_back(0);
 	}
 
-	m_Threads[threadIDX].reset();
+	const ThreadSlot slot{ index, m_SlotGenerations[index] };
+	m_ThreadNameMap.insert_or_assign(thread->GetName(), slot);
+	m_ThreadIDMap.insert_or_assign(thread->GetID(), slot);
+}
+
+ThreadManager::ThreadLookup ThreadManager::BuildThreadLookup() noexcept
+{
+	ThreadLookup lookup;
+	lookup.Version = ++m_LookupVersion;
+	lookup.IDs.reserve(m_ThreadIDMap.size());
+	for (const auto& [id, slot] : m_ThreadIDMap)
+		lookup.IDs.insert_or_assign(id, (WThread)m_Threads[slot.Index]);
+	lookup.Names.reserve(m_ThreadNameMap.size());
+	for (const auto& [name, slot] : m_ThreadNameMap)
+		lookup.Names.insert_or_assign(name, (WThread)m_Threads[slot.Index]);
+	return lookup;
+}
+
+void ThreadManager::PublishThreadLookup(ThreadLookup lookup) noexcept
+{
+	LOCK(m_PublishMutex);
+	// Built under m_ThreadMutex but published after releasing it, a newer one may have been published meanwhile
+	if (lookup.Version <= m_PublishedVersion)
+		return;
+	m_PublishedVersion = lookup.Version;
+	m_ThreadLookup.Publish(std::move(lookup));
 }
 
 void ThreadManager::OnInitialization() noexcept
@@ -52,7 +110,8 @@ void ThreadManager::OnActivation(const PInterface& oldDefault) noexcept
 	{
 		const auto& other = (const PThreadManager&)oldDefault;
 		// Copy threads
-		other->AccessThreads([this](const CSpan<PThread>& threads)
+		ThreadLookup lookup;
+		other->AccessThreads([this, &lookup](const CSpan<PThread>& threads)
 			{
 				auto lck = Lock(m_ThreadMutex);
 				const auto count = threads.GetSizeFn();
@@ -60,25 +119,25 @@ void ThreadManager::OnActivation(const PInterface& oldDefault) noexcept
 					m_Threads.reserve(count);
 				for (const auto& thread : threads)
 				{
-					if (thread == nullptr)
-						continue;
-
-					m_ThreadIDMap.insert_or_assign(thread->GetID(), m_Threads.size());
-					m_ThreadNameMap.insert_or_assign(thread->GetName(), m_Threads.size());
-					m_Threads.push_back(thread);
+					if (thread != nullptr)
+						AddThread(thread);
 				}
+				lookup = BuildThreadLookup();
 			});
+		PublishThreadLookup(std::move(lookup));
 	}
 	else
 	{
 		// Add Main Thread
-		LOCK(m_ThreadMutex);
-		auto curTh = PThread(AllocT<Thread>());
-		new((void*)curTh.get())Thread((WThreadManager)gThreadManager, CUR_THHND(), CUR_THID(), "Main");
-
-		m_ThreadNameMap.insert_or_assign(curTh->GetName(), m_Threads.size());
-		m_ThreadIDMap.insert_or_assign(curTh->GetID(), m_Threads.size());
-		m_Threads.push_back(curTh);
+		ThreadLookup lookup;
+		{
+			LOCK(m_ThreadMutex);
+			auto curTh = PThread(AllocT<Thread>());
+			new((void*)curTh.get())Thread((WThreadManager)gThreadManager, CUR_THHND(), CUR_THID(), "Main");
+			AddThread(curTh);
+			lookup = BuildThreadLookup();
+		}
+		PublishThreadLookup(std::move(lookup));
 	}
 	m_ThreadDestructionEvent.Connect(m_DestructionEventHnd, [this](const PThread& thread) {OnThreadDestruction(thread); });
 }
@@ -88,10 +147,17 @@ void ThreadManager::OnDeactivation(UNUSED const PInterface& newDefault) noexcept
 	m_DestructionEventHnd.Disconnect();
 
 	// Clear threads
-	LOCK(m_ThreadMutex);
-	m_Threads.clear();
-	m_ThreadIDMap.clear();
-	m_ThreadNameMap.clear();
+	ThreadLookup lookup;
+	{
+		LOCK(m_ThreadMutex);
+		m_Threads.clear();
+		m_SlotGenerations.clear();
+		m_FreeSlots.clear();
+		m_ThreadIDMap.clear();
+		m_ThreadNameMap.clear();
+		lookup = BuildThreadLookup();
+	}
+	PublishThreadLookup(std::move(lookup));
 }
 
 void ThreadManager::InitProperties()noexcept
@@ -118,48 +184,116 @@ ThreadManager::~ThreadManager() noexcept
 
 TResult<WThread> ThreadManager::GetThread(ThreadID_t id) const noexcept
 {
-	LOCK(m_ThreadMutex);
+	const auto lookup = m_ThreadLookup.Read();
+	if (!lookup)
+		return Result::CreateFailure<WThread>(Format("Cannot find the thread with ID: %d.", id));
 
-	const auto findIDIT = m_ThreadIDMap.find(id);
-	if (findIDIT == m_ThreadIDMap.end())
+	const auto findIDIT = lookup->IDs.find(id);
+	if (findIDIT == lookup->IDs.end())
 	{
 		return Result::CreateFailure<WThread>(Format("Cannot find the thread with ID: %d.", id));
 	}
-	const auto thIdx = findIDIT->second;
-	const auto& thread = m_Threads[thIdx];
-	if (thread == nullptr)
+	if (findIDIT->second.expired())
 	{
 		return Result::CreateFailure<WThread>(Format("Trying to get a thread with ID: %d, that is already finished.", id));
 	}
-	return Result::CreateSuccess((WThread)thread);
+	return Result::CreateSuccess(findIDIT->second);
 }
 
 TResult<WThread> ThreadManager::GetThread(const String& threadName) const noexcept
 {
-	LOCK(m_ThreadMutex);
+	const auto lookup = m_ThreadLookup.Read();
+	if (!lookup)
+		return Result::CreateFailure<WThread>(Format("Cannot find the thread with name:'%s'.", threadName.c_str()));
 
-	const auto findNameIT = m_ThreadNameMap.find(threadName);
-	if (findNameIT == m_ThreadNameMap.end())
+	const auto findNameIT = lookup->Names.find(threadName);
+	if (findNameIT == lookup->Names.end())
 	{
 		return Result::CreateFailure<WThread>(Format("Cannot find the thread with name:'%s'.", threadName.c_str()));
 	}
-	const auto thIdx = findNameIT->second;
-	const auto& thread = m_Threads[thIdx];
-	if (thread == nullptr)
+	if (findNameIT->second.expired())
 	{
 		return Result::CreateFailure<WThread>(Format("Trying to get a thread with name:'%s', that is already finished.", threadName.c_str()));
 	}
-	return Result::CreateSuccess((WThread)thread);
+	return Result::CreateSuccess(findNameIT->second);
 }
 
 TResult<PThread> ThreadManager::CreateThread(const ThreadConfig& config) noexcept
 {
-	LOCK(m_ThreadMutex);
-	auto thread = PThread(AllocT<Thread>());
-	new((void*)thread.get())Thread((WThreadManager)gThreadManager, thread, config);
+	// Same path as a batch, so the thread is registered and published before it starts
+	auto res = CreateThreads(Vector<ThreadConfig>{ config });
+	if (res.HasFailed())
+		return Result::CopyFailure<PThread>(res);
+	return Result::CreateSuccess(res.GetValue().front());
+}
 
-	m_ThreadNameMap.insert_or_assign(thread->GetName(), m_Threads.size());
-	m_ThreadIDMap.insert_or_assign(thread->GetID(), m_Threads.size());
-	m_Threads.push_back(thread);
-	return Result::CreateSuccess(thread);
-}
\ No newline at end of file
+TResult<Vector<PThread>> ThreadManager::CreateThreads(const Vector<ThreadConfig>& configs) noexcept
+{
+	Vector<PThread> threads;
+	threads.reserve(configs.size());
+	for (const auto& config : configs)
+	{
+		// Held at their gate until the whole batch exists, their startups overlap with the next creations
+		auto suspendedConfig = config;
+		suspendedConfig.StartSuspended = true;
+		auto thread = PThread(AllocT<Thread>());
+		new((void*)thread.get())Thread((WThreadManager)gThreadManager, thread, suspendedConfig);
+		threads.push_back(std::move(thread));
+	}
+
+	// Checked once all of them exist, the ones with a nice value set it meanwhile
+	for (const auto& thread : threads)
+	{
+		auto res = thread->GetStartResult();
+		if (res.HasFailed())
+		{
+			for (const auto& created : threads)
+				created->Discard();
+			return Result::CopyFailure<Vector<PThread>>(res);
+		}
+	}
+
+	ThreadLookup lookup;
+	{
+		LOCK(m_ThreadMutex);
+		for (const auto& thread : threads)
+			AddThread(thread);
+		lookup = BuildThreadLookup();
+	}
+	// The grace period of the previous lookup is waited without the lock, and before the threads
+	// start, so they can already find themselves
+	PublishThreadLookup(std::move(lookup));
+
+	// Started without the lock, so the threads that finish right away don't wait for it
+	for (sizet i = 0; i < threads.size(); ++i)
+	{
+		if (!configs[i].StartSuspended)
+			threads[i]->Resume();
+	}
+	return Result::CreateSuccess(std::move(threads));
+}
+
+Vector<ThreadStats> ThreadManager::GetThreadStats() const noexcept
+{
+	// The threads are kept alive by the copy, so procfs is read without holding the lock
+	Vector<PThread> threads;
+	{
+		LOCK(m_ThreadMutex);
+		threads.reserve(m_Threads.size());
+		for (const auto& thread : m_Threads)
+		{
+			if (thread != nullptr)
+				threads.push_back(thread);
+		}
+	}
+
+	Vector<ThreadStats> stats;
+	stats.reserve(threads.size());
+	for (const auto& thread : threads)
+	{
+		auto res = thread->GetStats();
+		if (res.IsOk())
+			stats.push_back(res.GetValue());
+	}
+	return stats;
+}
@@ -20,13 +20,46 @@ namespace greaper::core
 
 		ThreadDestructionEvent_t::HandlerType m_DestructionEventHnd;
 
+		// Slot index and the generation it had when the thread was added, so a stale
+		// handle never matches a thread that later reused the slot
+		struct ThreadSlot
+		{
+			uint32 Index;
+			uint32 Generation;
+
+			INLINE bool operator==(const ThreadSlot& other)const noexcept { return Index == other.Index && Generation == other.Generation; }
+		};
+
 		mutable RecursiveMutex m_ThreadMutex;
 		Vector<PThread> m_Threads;
-		UnorderedMap<String, sizet> m_ThreadNameMap;
-		UnorderedMap<ThreadID_t, sizet> m_ThreadIDMap;
+		Vector<uint32> m_SlotGenerations;
+		Vector<uint32> m_FreeSlots;
+		FlatMap<String, ThreadSlot> m_ThreadNameMap;
+		FlatMap<ThreadID_t, ThreadSlot> m_ThreadIDMap;
+		uint64 m_LookupVersion = 0;
+
+		// Copy of m_ThreadIDMap and m_ThreadNameMap for lock-free lookups, republished on each change
+		struct ThreadLookup
+		{
+			uint64 Version = 0;
+			FlatMap<ThreadID_t, WThread> IDs;
+			FlatMap<String, WThread> Names;
+		};
+		Mutex m_PublishMutex;
+		uint64 m_PublishedVersion = 0;
+		RCUValue<ThreadLookup> m_ThreadLookup;
 
 		void OnThreadDestruction(const PThread& thread)noexcept;
 
+		// m_ThreadMutex must be held, the threads are found once a lookup built afterwards is published
+		void AddThread(const PThread& thread)noexcept;
+
+		// m_ThreadMutex must be held
+		ThreadLookup BuildThreadLookup()noexcept;
+
+		// Called after releasing m_ThreadMutex, so the readers of the previous lookup are not waited with it held
+		void PublishThreadLookup(ThreadLookup lookup)noexcept;
+
 	public:
 		ThreadManager();
 
@@ -50,6 +83,8 @@ namespace greaper::core
 
 		TResult<PThread> CreateThread(const ThreadConfig& config)noexcept override;
 
+		TResult<Vector<PThread>> CreateThreads(const Vector<ThreadConfig>& configs)noexcept override;
+
 		INLINE ThreadCreationEvent_t& GetThreadCreationEvent()const noexcept override { return m_ThreadCreationEvent; }
 		
 		INLINE ThreadDestructionEvent_t& GetThreadDestructionEvent()const noexcept override { return m_ThreadDestructionEvent; }
@@ -59,6 +94,8 @@ namespace greaper::core
 			auto lck = Lock(m_ThreadMutex);
 			accessFn(CreateSpan(m_Threads));
 		}
+
+		Vector<ThreadStats> GetThreadStats()const noexcept override;
 	};
 }
 
@@ -0,0 +1,144 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+namespace greaper
+{
+	template<class _Alloc_>
+	INLINE TResult<SPtr<ConfigWatcher>> ConfigWatcher::Create(WThreadManager threadMgr, WApplication application, std::chrono::milliseconds debounce) noexcept
+	{
+		auto* ptr = AllocT<ConfigWatcher, _Alloc_>();
+		new ((void*)ptr)ConfigWatcher(std::move(application), debounce);
+		auto watcher = SPtr<ConfigWatcher>((ConfigWatcher*)ptr, &Impl::DefaultDeleter<ConfigWatcher, _Alloc_>);
+		EmptyResult res = watcher->Start(std::move(threadMgr));
+		if (res.HasFailed())
+			return Result::CopyFailure<SPtr<ConfigWatcher>>(res);
+		return Result::CreateSuccess(watcher);
+	}
+
+	INLINE ConfigWatcher::ConfigWatcher(WApplication application, std::chrono::milliseconds debounce) noexcept
+		:m_Application(std::move(application))
+		,m_Debounce(debounce)
+		,m_Running(false)
+	{
+
+	}
+
+	INLINE ConfigWatcher::~ConfigWatcher() noexcept
+	{
+		Stop();
+	}
+
+	INLINE EmptyResult ConfigWatcher::Start(WThreadManager threadMgr) noexcept
+	{
+		if (threadMgr.expired())
+			return Result::CreateFailure("Trying to start a ConfigWatcher, but the ThreadManager has expired."sv);
+
+		const auto configPath = std::filesystem::current_path() / "Config";
+		std::error_code ec;
+		std::filesystem::create_directories(configPath, ec);
+		EmptyResult res = m_Watcher.Open(configPath);
+		if (res.HasFailed())
+			return res;
+
+		m_Running.store(true, std::memory_order_release);
+		ThreadConfig cfg;
+		cfg.Name = "ConfigWatcher"sv;
+		cfg.ThreadFN = [this]() { Run(); };
+		auto thRes = threadMgr.lock()->CreateThread(cfg);
+		if (thRes.HasFailed())
+		{
+			m_Running.store(false, std::memory_order_release);
+			m_Watcher.Close();
+			return Result::CopyFailure(thRes);
+		}
+		m_Thread = thRes.GetValue();
+		return Result::CreateSuccess();
+	}
+
+	INLINE void ConfigWatcher::Stop() noexcept
+	{
+		if (!m_Running.exchange(false, std::memory_order_acq_rel))
+			return;
+
+		m_Watcher.Wake();
+		if (m_Thread != nullptr && m_Thread->Joinable())
+			m_Thread->Join();
+		m_Thread.reset();
+		m_Watcher.Close();
+	}
+
+	NODISCARD INLINE bool ConfigWatcher::IsRunning() const noexcept
+	{
+		return m_Running.load(std::memory_order_acquire);
+	}
+
+	INLINE void ConfigWatcher::Run() noexcept
+	{
+		using Clock_t = std::chrono::steady_clock;
+
+		Vector<String> fileNames;
+		Vector<String> pendingLibraries;
+		Clock_t::time_point deadline{};
+		while (m_Running.load(std::memory_order_acquire))
+		{
+			int32 timeoutMS = -1;
+			if (!pendingLibraries.empty())
+			{
+				const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock_t::now()).count();
+				timeoutMS = (int32)Max<int64>(remaining, 0);
+			}
+
+			fileNames.clear();
+			EmptyResult res = m_Watcher.Wait(fileNames, timeoutMS);
+			if (res.HasFailed())
+			{
+				auto app = m_Application.lock();
+				if (app != nullptr && !app->GetLibrary().expired())
+					app->GetLibrary().lock()->LogError("ConfigWatcher stopped, reason: " + res.GetFailMessage());
+				break;
+			}
+
+			for (const auto& fileName : fileNames)
+			{
+				const std::filesystem::path filePath{ fileName };
+				const auto extension = filePath.extension();
+				if (extension != ".json" && extension != ".gcfg")
+					continue; // Temporal files from exports or editors
+				const auto stem = filePath.stem().string();
+				String libraryName{ stem.data(), stem.size() };
+				if (!Contains(pendingLibraries, libraryName))
+					pendingLibraries.push_back(std::move(libraryName));
+				// Each modification pushes the deadline, so a burst of writes is reloaded once
+				deadline = Clock_t::now() + m_Debounce;
+			}
+
+			if (!pendingLibraries.empty() && Clock_t::now() >= deadline)
+			{
+				ReloadLibraries(pendingLibraries);
+				pendingLibraries.clear();
+			}
+		}
+	}
+
+	INLINE void ConfigWatcher::ReloadLibraries(const Vector<String>& libraryNames) noexcept
+	{
+		auto app = m_Application.lock();
+		if (app == nullptr)
+			return;
+
+		for (const auto& libraryName : libraryNames)
+		{
+			auto libRes = app->GetGreaperLibrary(StringView{ libraryName });
+			if (libRes.HasFailed())
+				continue; // Config of a library that is not registered
+			const auto& lib = libRes.GetValue();
+			auto res = lib->ReloadConfig();
+			if (res.HasFailed())
+				lib->LogWarning(Format("Couldn't reload the config of %s, reason: %s", libraryName.c_str(), res.GetFailMessage().c_str()));
+		}
+	}
+}
@@ -0,0 +1,849 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef CORE_FLATMAP_H
+#define CORE_FLATMAP_H 1
+
+#include <cstring>
+#if ARCHITECTURE_X64
+#include <emmintrin.h>
+#endif
+#if COMPILER_MSVC
+#include <intrin.h>
+#endif
+
+namespace greaper
+{
+	/* Hash used by FlatMap/FlatSet, strings hash through their characters so String and StringView share hashes */
+	template<class K>
+	struct FlatHash
+	{
+		NODISCARD INLINE sizet operator()(const K& key)const noexcept { return (sizet)HashType<K>()(key); }
+	};
+
+	template<> struct FlatHash<String>
+	{
+		using is_transparent = void;
+		NODISCARD INLINE sizet operator()(StringView key)const noexcept { return (sizet)HashBytes(key.data(), key.size()); }
+	};
+	template<> struct FlatHash<StringView> : FlatHash<String> {  };
+
+	template<> struct FlatHash<WString>
+	{
+		using is_transparent = void;
+		NODISCARD INLINE sizet operator()(WStringView key)const noexcept { return (sizet)HashBytes(key.data(), key.size() * sizeof(key[0])); }
+	};
+	template<> struct FlatHash<WStringView> : FlatHash<WString> {  };
+
+	template<class K> struct FlatEqual : std::equal_to<K> {  };
+	template<> struct FlatEqual<String> : std::equal_to<> {  };
+	template<> struct FlatEqual<StringView> : std::equal_to<> {  };
+	template<> struct FlatEqual<WString> : std::equal_to<> {  };
+	template<> struct FlatEqual<WStringView> : std::equal_to<> {  };
+
+	namespace Impl
+	{
+		/**
+		 * Each slot of the table has a control byte, full slots store the low 7 bits of their
+		 * hash (H2) and empty or deleted ones have the sign bit set, so a group of 16 control
+		 * bytes can be matched against a hash with a couple of SIMD instructions.
+		 */
+		using FlatCtrl_t = int8;
+		static constexpr FlatCtrl_t FlatCtrlEmpty = -128;
+		static constexpr FlatCtrl_t FlatCtrlDeleted = -2;
+		static constexpr sizet FlatGroupWidth = 16;
+		static constexpr sizet FlatMinCapacity = FlatGroupWidth;
+
+		NODISCARD INLINE uint32 FlatLowestBit(uint32 mask)noexcept
+		{
+#if COMPILER_MSVC
+			unsigned long index;
+			_BitScanForward(&index, mask);
+			return (uint32)index;
+#else
+			return (uint32)__builtin_ctz(mask);
+#endif
+		}
+
+		/* Mixes the user hash, so identity hashes (integers) spread over the whole table */
+		NODISCARD INLINE uint64 FlatMixHash(sizet hash)noexcept
+		{
+			return HashImpl::WyMix((uint64)hash, 0x9E3779B97F4A7C15ull);
+		}
+
+		struct FlatGroup
+		{
+#if ARCHITECTURE_X64
+			__m128i Ctrl;
+
+			INLINE explicit FlatGroup(const FlatCtrl_t* pos)noexcept
+				:Ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos)))
+			{
+
+			}
+
+			// Bitmask of the slots whose control byte is h2
+			NODISCARD INLINE uint32 Match(FlatCtrl_t h2)const noexcept
+			{
+				return (uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), Ctrl));
+			}
+
+			NODISCARD INLINE uint32 MatchEmpty()const noexcept
+			{
+				return Match(FlatCtrlEmpty);
+			}
+
+			NODISCARD INLINE uint32 MatchEmptyOrDeleted()const noexcept
+			{
+				return (uint32)_mm_movemask_epi8(Ctrl);
+			}
+#else
+			const FlatCtrl_t* Ctrl;
+
+			INLINE explicit FlatGroup(const FlatCtrl_t* pos)noexcept
+				:Ctrl(pos)
+			{
+
+			}
+
+			NODISCARD INLINE uint32 Match(FlatCtrl_t h2)const noexcept
+			{
+				uint32 mask = 0;
+				for (uint32 i = 0; i < FlatGroupWidth; ++i)
+					mask |= (uint32)(Ctrl[i] == h2) << i;
+				return mask;
+			}
+
+			NODISCARD INLINE uint32 MatchEmpty()const noexcept
+			{
+				return Match(FlatCtrlEmpty);
+			}
+
+			NODISCARD INLINE uint32 MatchEmptyOrDeleted()const noexcept
+			{
+				uint32 mask = 0;
+				for (uint32 i = 0; i < FlatGroupWidth; ++i)
+					mask |= (uint32)(Ctrl[i] < 0) << i;
+				return mask;
+			}
+#endif
+		};
+
+		template<class K>
+		struct FlatSetPolicy
+		{
+			using KeyType = K;
+			using SlotType = K;
+			NODISCARD static INLINE const K& GetKey(const SlotType& slot)noexcept { return slot; }
+		};
+
+		template<class K, class V>
+		struct FlatMapPolicy
+		{
+			using KeyType = K;
+			// The key is not const so slots can be moved when rehashing, it must not be modified through iterators
+			using SlotType = std::pair<K, V>;
+			NODISCARD static INLINE const K& GetKey(const SlotType& slot)noexcept { return slot.first; }
+		};
+
+		template<class T>
+		class FlatIterator
+		{
+			template<class, class, class, class> friend class FlatTable;
+			template<class> friend class FlatIterator;
+
+			const FlatCtrl_t* m_Ctrl = nullptr;
+			const FlatCtrl_t* m_CtrlEnd = nullptr;
+			T* m_Slot = nullptr;
+
+			INLINE FlatIterator(const FlatCtrl_t* ctrl, const FlatCtrl_t* ctrlEnd, T* slot)noexcept
+				:m_Ctrl(ctrl)
+				,m_CtrlEnd(ctrlEnd)
+				,m_Slot(slot)
+			{
+
+			}
+
+			INLINE void SkipFree()noexcept
+			{
+				while (m_Ctrl != m_CtrlEnd && *m_Ctrl < 0)
+				{
+					++m_Ctrl;
+					++m_Slot;
+				}
+			}
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = std::remove_const_t<T>;
+			using difference_type = std::ptrdiff_t;
+			using pointer = T*;
+			using reference = T&;
+
+			INLINE FlatIterator()noexcept = default;
+
+			// iterator to const_iterator
+			template<class T2, class = std::enable_if_t<std::is_same_v<const T2, T>>>
+			INLINE FlatIterator(const FlatIterator<T2>& other)noexcept
+				:m_Ctrl(other.m_Ctrl)
+				,m_CtrlEnd(other.m_CtrlEnd)
+				,m_Slot(other.m_Slot)
+			{
+
+			}
+
+			INLINE T& operator*()const noexcept { return *m_Slot; }
+			INLINE T* operator->()const noexcept { return m_Slot; }
+
+			INLINE FlatIterator& operator++()noexcept
+			{
+				++m_Ctrl;
+				++m_Slot;
+				SkipFree();
+				return *this;
+			}
+
+			INLINE FlatIterator operator++(int)noexcept
+			{
+				auto tmp = *this;
+				++(*this);
+				return tmp;
+			}
+
+			INLINE friend bool operator==(const FlatIterator& left, const FlatIterator& right)noexcept { return left.m_Ctrl == right.m_Ctrl; }
+			INLINE friend bool operator!=(const FlatIterator& left, const FlatIterator& right)noexcept { return left.m_Ctrl != right.m_Ctrl; }
+		};
+
+		/**
+		 * @brief Open addressing hash table with SIMD probing (Swiss table), the control bytes
+		 * and the slots live in a single allocation made through _Alloc_. Probing goes over
+		 * aligned groups of 16 slots following a triangular sequence, which visits every group
+		 * as the group count is a power of two. At most 7/8 of the slots are used.
+		 * Iterators and references are invalidated by any insertion that grows the table.
+		 */
+		template<class Policy, class H, class E, class _Alloc_>
+		class FlatTable
+		{
+		public:
+			using key_type = typename Policy::KeyType;
+			using value_type = typename Policy::SlotType;
+			using size_type = sizet;
+			using difference_type = std::ptrdiff_t;
+			using hasher = H;
+			using key_equal = E;
+			using reference = value_type&;
+			using const_reference = const value_type&;
+			using iterator = FlatIterator<value_type>;
+			using const_iterator = FlatIterator<const value_type>;
+
+		protected:
+			static constexpr sizet NotFound = std::numeric_limits<sizet>::max();
+
+			template<class Q>
+			static constexpr bool IsTransparent = !std::is_same_v<std::decay_t<Q>, key_type>;
+
+			template<class HH, class EE, class = void>
+			struct TransparentHelper : std::false_type {  };
+			template<class HH, class EE>
+			struct TransparentHelper<HH, EE, std::void_t<typename HH::is_transparent, typename EE::is_transparent>> : std::true_type {  };
+
+			static constexpr bool HasTransparentLookup = TransparentHelper<H, E>::value;
+
+			template<class Q>
+			using EnableTransparent_t = std::enable_if_t<HasTransparentLookup && IsTransparent<Q>, int>;
+
+			FlatCtrl_t* m_Ctrl = nullptr;
+			value_type* m_Slots = nullptr;
+			sizet m_Capacity = 0;
+			sizet m_Size = 0;
+			sizet m_GrowthLeft = 0;
+			H m_Hash;
+			E m_Equal;
+
+			NODISCARD static INLINE sizet MaxLoad(sizet capacity)noexcept { return capacity - capacity / 8; }
+
+			NODISCARD static INLINE sizet SlotsOffset(sizet capacity)noexcept
+			{
+				constexpr sizet align = alignof(value_type);
+				return (capacity + align - 1) & ~(align - 1);
+			}
+
+			template<class Q>
+			NODISCARD INLINE uint64 HashKey(const Q& key)const noexcept
+			{
+				return FlatMixHash((sizet)m_Hash(key));
+			}
+
+			NODISCARD static INLINE FlatCtrl_t H2(uint64 hash)noexcept { return (FlatCtrl_t)(hash & 0x7F); }
+			NODISCARD static INLINE sizet H1(uint64 hash)noexcept { return (sizet)(hash >> 7); }
+
+			template<class Q>
+			NODISCARD sizet FindIndex(const Q& key, uint64 hash)const noexcept
+			{
+				if (m_Capacity == 0)
+					return NotFound;
+
+				const sizet groupMask = m_Capacity / FlatGroupWidth - 1;
+				const FlatCtrl_t h2 = H2(hash);
+				sizet group = H1(hash) & groupMask;
+				for (sizet step = 1; ; ++step)
+				{
+					const sizet base = group * FlatGroupWidth;
+					const FlatGroup g(m_Ctrl + base);
+					for (uint32 mask = g.Match(h2); mask != 0; mask &= mask - 1)
+					{
+						const sizet index = base + FlatLowestBit(mask);
+						if (m_Equal(Policy::GetKey(m_Slots[index]), key))
+							return index;
+					}
+					if (g.MatchEmpty() != 0)
+						return NotFound;
+					group = (group + step) & groupMask;
+				}
+			}
+
+			NODISCARD sizet FindFreeIndex(uint64 hash)const noexcept
+			{
+				const sizet groupMask = m_Capacity / FlatGroupWidth - 1;
+				sizet group = H1(hash) & groupMask;
+				for (sizet step = 1; ; ++step)
+				{
+					const sizet base = group * FlatGroupWidth;
+					const uint32 mask = FlatGroup(m_Ctrl + base).MatchEmptyOrDeleted();
+					if (mask != 0)
+						return base + FlatLowestBit(mask);
+					group = (group + step) & groupMask;
+				}
+			}
+
+			NODISCARD static sizet CapacityFor(sizet count)noexcept
+			{
+				sizet capacity = FlatMinCapacity;
+				while (MaxLoad(capacity) < count)
+					capacity <<= 1;
+				return capacity;
+			}
+
+			void Rehash(sizet newCapacity)
+			{
+				auto* oldCtrl = m_Ctrl;
+				auto* oldSlots = m_Slots;
+				const auto oldCapacity = m_Capacity;
+
+				auto* mem = static_cast<uint8*>(Alloc<_Alloc_>(SlotsOffset(newCapacity) + newCapacity * sizeof(value_type)));
+				m_Ctrl = reinterpret_cast<FlatCtrl_t*>(mem);
+				m_Slots = reinterpret_cast<value_type*>(mem + SlotsOffset(newCapacity));
+				m_Capacity = newCapacity;
+				memset(m_Ctrl, FlatCtrlEmpty, newCapacity);
+
+				for (sizet i = 0; i < oldCapacity; ++i)
+				{
+					if (oldCtrl[i] < 0)
+						continue;
+					auto& slot = oldSlots[i];
+					const auto hash = HashKey(Policy::GetKey(slot));
+					const auto index = FindFreeIndex(hash);
+					new(m_Slots + index) value_type(std::move(slot));
+					m_Ctrl[index] = H2(hash);
+					slot.~value_type();
+				}
+				m_GrowthLeft = MaxLoad(newCapacity) - m_Size;
+
+				if (oldCtrl != nullptr)
+					Dealloc<_Alloc_>(oldCtrl);
+			}
+
+			// Returns the slot where a new element with this hash must be constructed, grows if needed
+			sizet PrepareInsert(uint64 hash)
+			{
+				if (m_Capacity == 0)
+					Rehash(FlatMinCapacity);
+
+				auto index = FindFreeIndex(hash);
+				if (m_GrowthLeft == 0 && m_Ctrl[index] != FlatCtrlDeleted)
+				{
+					// Lots of tombstones, rehashing at the same size is enough
+					Rehash(m_Size < MaxLoad(m_Capacity) / 2 ? m_Capacity : m_Capacity * 2);
+					index = FindFreeIndex(hash);
+				}
+				if (m_Ctrl[index] == FlatCtrlEmpty)
+					--m_GrowthLeft;
+				m_Ctrl[index] = H2(hash);
+				++m_Size;
+				return index;
+			}
+
+			template<class Q, class... Args>
+			std::pair<iterator, bool> EmplaceKey(const Q& key, Args&&... args)
+			{
+				const auto hash = HashKey(key);
+				const auto found = FindIndex(key, hash);
+				if (found != NotFound)
+					return { MakeIterator(found), false };
+
+				const auto index = PrepareInsert(hash);
+				new(m_Slots + index) value_type(std::forward<Args>(args)...);
+				return { MakeIterator(index), true };
+			}
+
+			void EraseIndex(sizet index)noexcept
+			{
+				m_Slots[index].~value_type();
+				--m_Size;
+				// Probes stop at groups with an empty slot, so if the group already has one this slot can be empty too
+				const sizet base = index & ~(FlatGroupWidth - 1);
+				if (FlatGroup(m_Ctrl + base).MatchEmpty() != 0)
+				{
+					m_Ctrl[index] = FlatCtrlEmpty;
+					++m_GrowthLeft;
+				}
+				else
+				{
+					m_Ctrl[index] = FlatCtrlDeleted;
+				}
+			}
+
+			void DestroySlots()noexcept
+			{
+				if constexpr (!std::is_trivially_destructible_v<value_type>)
+				{
+					for (sizet i = 0; i < m_Capacity; ++i)
+					{
+						if (m_Ctrl[i] >= 0)
+							m_Slots[i].~value_type();
+					}
+				}
+			}
+
+			void Release()noexcept
+			{
+				if (m_Ctrl == nullptr)
+					return;
+				DestroySlots();
+				Dealloc<_Alloc_>(m_Ctrl);
+				m_Ctrl = nullptr;
+				m_Slots = nullptr;
+				m_Capacity = 0;
+				m_Size = 0;
+				m_GrowthLeft = 0;
+			}
+
+			void CopyFrom(const FlatTable& other)
+			{
+				reserve(other.m_Size);
+				for (const auto& elem : other)
+				{
+					const auto hash = HashKey(Policy::GetKey(elem));
+					const auto index = PrepareInsert(hash);
+					new(m_Slots + index) value_type(elem);
+				}
+			}
+
+			NODISCARD INLINE iterator MakeIterator(sizet index)noexcept
+			{
+				return iterator(m_Ctrl + index, m_Ctrl + m_Capacity, m_Slots + index);
+			}
+
+			NODISCARD INLINE const_iterator MakeIterator(sizet index)const noexcept
+			{
+				return const_iterator(m_Ctrl + index, m_Ctrl + m_Capacity, m_Slots + index);
+			}
+
+		public:
+			FlatTable()noexcept = default;
+
+			explicit FlatTable(sizet bucketCount, const H& hash = H(), const E& equal = E())
+				:m_Hash(hash)
+				,m_Equal(equal)
+			{
+				reserve(bucketCount);
+			}
+
+			FlatTable(const FlatTable& other)
+				:m_Hash(other.m_Hash)
+				,m_Equal(other.m_Equal)
+			{
+				CopyFrom(other);
+			}
+
+			FlatTable(FlatTable&& other)noexcept
+				:m_Ctrl(std::exchange(other.m_Ctrl, nullptr))
+				,m_Slots(std::exchange(other.m_Slots, nullptr))
+				,m_Capacity(std::exchange(other.m_Capacity, 0))
+				,m_Size(std::exchange(other.m_Size, 0))
+				,m_GrowthLeft(std::exchange(other.m_GrowthLeft, 0))
+				,m_Hash(std::move(other.m_Hash))
+				,m_Equal(std::move(other.m_Equal))
+			{
+
+			}
+
+			FlatTable& operator=(const FlatTable& other)
+			{
+				if (this != &other)
+				{
+					clear();
+					m_Hash = other.m_Hash;
+					m_Equal = other.m_Equal;
+					CopyFrom(other);
+				}
+				return *this;
+			}
+
+			FlatTable& operator=(FlatTable&& other)noexcept
+			{
+				if (this != &other)
+				{
+					Release();
+					m_Ctrl = std::exchange(other.m_Ctrl, nullptr);
+					m_Slots = std::exchange(other.m_Slots, nullptr);
+					m_Capacity = std::exchange(other.m_Capacity, 0);
+					m_Size = std::exchange(other.m_Size, 0);
+					m_GrowthLeft = std::exchange(other.m_GrowthLeft, 0);
+					m_Hash = std::move(other.m_Hash);
+					m_Equal = std::move(other.m_Equal);
+				}
+				return *this;
+			}
+
+			~FlatTable()noexcept
+			{
+				Release();
+			}
+
+			NODISCARD INLINE iterator begin()noexcept
+			{
+				auto it = MakeIterator(0);
+				it.SkipFree();
+				return it;
+			}
+			NODISCARD INLINE const_iterator begin()const noexcept
+			{
+				auto it = MakeIterator(0);
+				it.SkipFree();
+				return it;
+			}
+			NODISCARD INLINE const_iterator cbegin()const noexcept { return begin(); }
+			NODISCARD INLINE iterator end()noexcept { return MakeIterator(m_Capacity); }
+			NODISCARD INLINE const_iterator end()const noexcept { return MakeIterator(m_Capacity); }
+			NODISCARD INLINE const_iterator cend()const noexcept { return end(); }
+
+			NODISCARD INLINE sizet size()const noexcept { return m_Size; }
+			NODISCARD INLINE bool empty()const noexcept { return m_Size == 0; }
+			NODISCARD INLINE sizet capacity()const noexcept { return m_Capacity; }
+			NODISCARD INLINE hasher hash_function()const { return m_Hash; }
+			NODISCARD INLINE key_equal key_eq()const { return m_Equal; }
+
+			// Makes room for count elements without growing again
+			void reserve(sizet count)
+			{
+				if (count == 0 || MaxLoad(m_Capacity) >= count)
+					return;
+				Rehash(CapacityFor(Max(count, m_Size)));
+			}
+
+			// Keeps the allocation
+			void clear()noexcept
+			{
+				if (m_Size == 0 && m_GrowthLeft == MaxLoad(m_Capacity))
+					return;
+				DestroySlots();
+				memset(m_Ctrl, FlatCtrlEmpty, m_Capacity);
+				m_Size = 0;
+				m_GrowthLeft = MaxLoad(m_Capacity);
+			}
+
+			void swap(FlatTable& other)noexcept
+			{
+				std::swap(m_Ctrl, other.m_Ctrl);
+				std::swap(m_Slots, other.m_Slots);
+				std::swap(m_Capacity, other.m_Capacity);
+				std::swap(m_Size, other.m_Size);
+				std::swap(m_GrowthLeft, other.m_GrowthLeft);
+				std::swap(m_Hash, other.m_Hash);
+				std::swap(m_Equal, other.m_Equal);
+			}
+
+			NODISCARD iterator find(const key_type& key)noexcept
+			{
+				const auto index = FindIndex(key, HashKey(key));
+				return index == NotFound ? end() : MakeIterator(index);
+			}
+
+			NODISCARD const_iterator find(const key_type& key)const noexcept
+			{
+				const auto index = FindIndex(key, HashKey(key));
+				return index == NotFound ? end() : MakeIterator(index);
+			}
+
+			template<class Q, EnableTransparent_t<Q> = 0>
+			NODISCARD iterator find(const Q& key)noexcept
+			{
+				const auto index = FindIndex(key, HashKey(key));
+				return index == NotFound ? end() : MakeIterator(index);
+			}
+
+			template<class Q, EnableTransparent_t<Q> = 0>
+			NODISCARD const_iterator find(const Q& key)const noexcept
+			{
+				const auto index = FindIndex(key, HashKey(key));
+				return index == NotFound ? end() : MakeIterator(index);
+			}
+
+			NODISCARD bool contains(const key_type& key)const noexcept { return FindIndex(key, HashKey(key)) != NotFound; }
+
+			template<class Q, EnableTransparent_t<Q> = 0>
+			NODISCARD bool contains(const Q& key)const noexcept { return FindIndex(key, HashKey(key)) != NotFound; }
+
+			NODISCARD sizet count(const key_type& key)const noexcept { return contains(key) ? 1 : 0; }
+
+			template<class Q, EnableTransparent_t<Q> = 0>
+			NODISCARD sizet count(const Q& key)const noexcept { return contains(key) ? 1 : 0; }
+
+			NODISCARD std::pair<const_iterator, const_iterator> equal_range(const key_type& key)const noexcept
+			{
+				const auto it = find(key);
+				if (it == end())
+					return { it, it };
+				auto next = it;
+				return { it, ++next };
+			}
+
+			iterator erase(const_iterator pos)noexcept
+			{
+				const auto index = (sizet)(pos.m_Ctrl - m_Ctrl);
+				EraseIndex(index);
+				auto next = MakeIterator(index);
+				next.SkipFree();
+				return next;
+			}
+
+			iterator erase(iterator pos)noexcept
+			{
+				return erase(const_iterator(pos));
+			}
+
+			sizet erase(const key_type& key)noexcept
+			{
+				const auto index = FindIndex(key, HashKey(key));
+				if (index == NotFound)
+					return 0;
+				EraseIndex(index);
+				return 1;
+			}
+
+			template<class Q, EnableTransparent_t<Q> = 0>
+			sizet erase(const Q& key)noexcept
+			{
+				const auto index = FindIndex(key, HashKey(key));
+				if (index == NotFound)
+					return 0;
+				EraseIndex(index);
+				return 1;
+			}
+		};
+	}
+
+	/**
+	 * @brief Flat hash map, stores its pairs inline in a single allocation, lookups are one
+	 * SIMD compare per group of 16 slots, no node allocations and no pointer chasing.
+	 * Lookups, erase and insertion take any key type when both H and E are transparent,
+	 * FlatMap<String, V> can be queried with a StringView without creating a String.
+	 * Unlike UnorderedMap, insertions can invalidate iterators and references.
+	 */
+	template<class K, class V, class H = FlatHash<K>, class E = FlatEqual<K>, class _Alloc_ = GenericAllocator>
+	class FlatMap : public Impl::FlatTable<Impl::FlatMapPolicy<K, V>, H, E, _Alloc_>
+	{
+		using Base = Impl::FlatTable<Impl::FlatMapPolicy<K, V>, H, E, _Alloc_>;
+		template<class Q> using EnableTransparent_t = typename Base::template EnableTransparent_t<Q>;
+
+	public:
+		using mapped_type = V;
+		using typename Base::key_type;
+		using typename Base::value_type;
+		using typename Base::iterator;
+		using typename Base::const_iterator;
+
+		using Base::Base;
+
+		FlatMap()noexcept = default;
+
+		FlatMap(std::initializer_list<value_type> init)
+		{
+			this->reserve(init.size());
+			for (const auto& elem : init)
+				insert(elem);
+		}
+
+		std::pair<iterator, bool> insert(const value_type& value)
+		{
+			return this->EmplaceKey(value.first, value);
+		}
+
+		std::pair<iterator, bool> insert(value_type&& value)
+		{
+			return this->EmplaceKey(value.first, std::move(value));
+		}
+
+		template<class K2, class V2>
+		std::pair<iterator, bool> emplace(K2&& key, V2&& value)
+		{
+			return try_emplace(std::forward<K2>(key), std::forward<V2>(value));
+		}
+
+		template<class... Args>
+		std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
+		{
+			return this->EmplaceKey(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+		}
+
+		template<class... Args>
+		std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args)
+		{
+			const auto hash = this->HashKey(key);
+			const auto found = this->FindIndex(key, hash);
+			if (found != Base::NotFound)
+				return { this->MakeIterator(found), false };
+			const auto index = this->PrepareInsert(hash);
+			new(this->m_Slots + index) value_type(std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+			return { this->MakeIterator(index), true };
+		}
+
+		// The key is only converted to key_type if it has to be inserted
+		template<class Q, class... Args, EnableTransparent_t<Q> = 0>
+		std::pair<iterator, bool> try_emplace(const Q& key, Args&&... args)
+		{
+			return this->EmplaceKey(key, std::piecewise_construct, std::forward_as_tuple(key_type(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+		}
+
+		template<class K2, class M>
+		std::pair<iterator, bool> insert_or_assign(K2&& key, M&& obj)
+		{
+			auto res = try_emplace(std::forward<K2>(key), std::forward<M>(obj));
+			if (!res.second)
+				res.first->second = std::forward<M>(obj);
+			return res;
+		}
+
+		template<class K2>
+		V& operator[](K2&& key)
+		{
+			return try_emplace(std::forward<K2>(key)).first->second;
+		}
+
+		// The key must be present
+		NODISCARD V& at(const key_type& key)noexcept
+		{
+			auto it = this->find(key);
+			VerifyNot(it == this->end(), "[FlatMap]::at Trying to access a key that is not present.");
+			return it->second;
+		}
+
+		NODISCARD const V& at(const key_type& key)const noexcept
+		{
+			auto it = this->find(key);
+			VerifyNot(it == this->end(), "[FlatMap]::at Trying to access a key that is not present.");
+			return it->second;
+		}
+	};
+
+	/**
+	 * @brief Flat hash set, see FlatMap.
+	 */
+	template<class K, class H = FlatHash<K>, class E = FlatEqual<K>, class _Alloc_ = GenericAllocator>
+	class FlatSet : public Impl::FlatTable<Impl::FlatSetPolicy<K>, H, E, _Alloc_>
+	{
+		using Base = Impl::FlatTable<Impl::FlatSetPolicy<K>, H, E, _Alloc_>;
+		template<class Q> using EnableTransparent_t = typename Base::template EnableTransparent_t<Q>;
+
+	public:
+		using typename Base::key_type;
+		using typename Base::value_type;
+		using typename Base::iterator;
+		using typename Base::const_iterator;
+
+		using Base::Base;
+
+		FlatSet()noexcept = default;
+
+		FlatSet(std::initializer_list<value_type> init)
+		{
+			this->reserve(init.size());
+			for (const auto& elem : init)
+				insert(elem);
+		}
+
+		std::pair<iterator, bool> insert(const value_type& value)
+		{
+			return this->EmplaceKey(value, value);
+		}
+
+		std::pair<iterator, bool> insert(value_type&& value)
+		{
+			const auto hash = this->HashKey(value);
+			const auto found = this->FindIndex(value, hash);
+			if (found != Base::NotFound)
+				return { this->MakeIterator(found), false };
+			const auto index = this->PrepareInsert(hash);
+			new(this->m_Slots + index) value_type(std::move(value));
+			return { this->MakeIterator(index), true };
+		}
+
+		template<class Q, EnableTransparent_t<Q> = 0>
+		std::pair<iterator, bool> insert(const Q& value)
+		{
+			return this->EmplaceKey(value, value);
+		}
+
+		template<class... Args>
+		std::pair<iterator, bool> emplace(Args&&... args)
+		{
+			return insert(value_type(std::forward<Args>(args)...));
+		}
+	};
+
+	template<class K, class V, class H, class E, class A>
+	NODISCARD INLINE bool operator==(const FlatMap<K, V, H, E, A>& left, const FlatMap<K, V, H, E, A>& right)
+	{
+		if (left.size() != right.size())
+			return false;
+		for (const auto& [key, value] : left)
+		{
+			const auto it = right.find(key);
+			if (it == right.end() || !(it->second == value))
+				return false;
+		}
+		return true;
+	}
+
+	template<class K, class V, class H, class E, class A>
+	NODISCARD INLINE bool operator!=(const FlatMap<K, V, H, E, A>& left, const FlatMap<K, V, H, E, A>& right)
+	{
+		return !(left == right);
+	}
+
+	template<class K, class H, class E, class A>
+	NODISCARD INLINE bool operator==(const FlatSet<K, H, E, A>& left, const FlatSet<K, H, E, A>& right)
+	{
+		if (left.size() != right.size())
+			return false;
+		for (const auto& key : left)
+		{
+			if (!right.contains(key))
+				return false;
+		}
+		return true;
+	}
+
+	template<class K, class H, class E, class A>
+	NODISCARD INLINE bool operator!=(const FlatSet<K, H, E, A>& left, const FlatSet<K, H, E, A>& right)
+	{
+		return !(left == right);
+	}
+}
+
+#endif /* CORE_FLATMAP_H */
@@ -36,9 +36,10 @@ namespace greaper
 		va_start(argList, fmt);
 
 		BasicString<T, StdAlloc<T, _Alloc_>> str {};
-		str.resize(size + 1, (T)0);
+		str.resize(size, (T)0);
 
-		Snprintf::Fn(str.data(), str.size(), fmt, argList);
+		// The terminator goes to data()[size()], so it doesn't end up in the string itself
+		Snprintf::Fn(str.data(), str.size() + 1, fmt, argList);
 
 		va_end(argList);
 
@@ -59,9 +60,9 @@ namespace greaper
 		va_start(argList, fmt);
 
 		BasicString<T, StdAlloc<T, _Alloc_>> str{};
-		str.resize(size + 1, (T)0);
+		str.resize(size, (T)0);
 
-		Snprintf::Fn(str.data(), str.size(), fmt.c_str(), argList);
+		Snprintf::Fn(str.data(), str.size() + 1, fmt.c_str(), argList);
 
 		va_end(argList);
 
@@ -14,10 +14,13 @@
 
 namespace greaper
 {
+	// Commands rarely take more than a few arguments
+	using CommandArgs_t = SmallVector<String, 4>;
+
 	struct CommandInfo
 	{
 		String CommandName;
-		StringVec CommandArgs;
+		CommandArgs_t CommandArgs;
 
 		static TResult<CommandInfo> FromConsole(const String& cmdLine)noexcept;
 	};
@@ -33,9 +36,9 @@ namespace greaper
 
 		virtual ~ICommand()noexcept = default;
 
-		virtual EmptyResult DoCommand(const StringVec& args)noexcept = 0;
+		virtual EmptyResult DoCommand(const CommandArgs_t& args)noexcept = 0;
 
-		virtual EmptyResult UndoCommand(UNUSED const StringVec& args)noexcept { return Result::CreateSuccess(); }
+		virtual EmptyResult UndoCommand(UNUSED const CommandArgs_t& args)noexcept { return Result::CreateSuccess(); }
 
 		INLINE const String& GetCommandName()const noexcept { return m_CommandName; }
 
@@ -46,6 +49,10 @@ namespace greaper
 		INLINE bool IsActive()const noexcept { return m_Active; }
 
 		virtual bool CanBeUndone()const noexcept = 0;
+
+		// Commands that return true may run at the same time as other commands when they come from a script,
+		// the ones that return false are considered conflicting and run alone
+		virtual bool CanRunInParallel()const noexcept { return false; }
 	};
 
 	INLINE TResult<CommandInfo> CommandInfo::FromConsole(const String& cmdLine)noexcept
@@ -55,10 +62,9 @@ namespace greaper
 		if(vec.empty())
 			return Result::CreateFailure<CommandInfo>("Couldn't recognize the command name nor its arguments from the given command line."sv);
 		CommandInfo info;
-		info.CommandName = vec[0];
-		vec.erase(vec.begin());
-		info.CommandArgs = vec;
-		return Result::CreateSuccess(info);
+		info.CommandName = std::move(vec[0]);
+		info.CommandArgs.assign(std::make_move_iterator(vec.begin() + 1), std::make_move_iterator(vec.end()));
+		return Result::CreateSuccess(std::move(info));
 	}
 
 	INLINE ICommand::ICommand(StringView commandName, StringView helpMessage) noexcept
@@ -7,6 +7,7 @@
 
 //#include "../IGreaperLibrary.h"
 #include "../FileStream.h"
+#include "../MemoryStream.h"
 
 namespace greaper
 {
@@ -22,6 +23,7 @@ namespace greaper
 				if (oProp == nullptr)
 				{
 					m_Properties[index] = property;
+					RegisterPropertyGlobally(property);
 					return Result::CreateSuccess();
 				}
 				return Result::CreateFailure(Format("Trying to register a Property '%s', but its already registered.", property->GetPropertyName().c_str()));
@@ -31,9 +33,20 @@ namespace greaper
 		const auto index = m_Properties.size();
 		m_Properties.push_back(property);
 		m_PropertyMap.insert_or_assign(property->GetPropertyName(), index);
+		RegisterPropertyGlobally(property);
 		return Result::CreateSuccess();
 	}
 
+	INLINE void IGreaperLibrary::RegisterPropertyGlobally(const PIProperty& property) noexcept
+	{
+		if (m_Application == nullptr)
+			return;
+
+		const auto res = m_Application->GetPropertyRegistry().Register(GetLibraryName(), property);
+		if (res.HasFailed())
+			LogWarning(res.GetFailMessage());
+	}
+
 	INLINE void IGreaperLibrary::Initialize() noexcept
 	{
 		/* No-op */
@@ -49,6 +62,58 @@ namespace greaper
 		/* No-op */
 	}
 
+	INLINE void IGreaperLibrary::SortManagersByDependencies() noexcept
+	{
+		const auto count = m_Managers.size();
+		if (count < 2)
+			return;
+
+		UnorderedMap<Uuid, sizet> uuidMap;
+		for (sizet i = 0; i < count; ++i)
+			uuidMap.insert_or_assign(m_Managers[i]->GetInterfaceUUID(), i);
+
+		// Kahn's algorithm, keeping the original order among independent managers
+		Vector<sizet> pending(count, 0);
+		Vector<Vector<sizet>> dependents(count);
+		for (sizet i = 0; i < count; ++i)
+		{
+			for (const auto& dep : m_Managers[i]->GetInterfaceDependencies())
+			{
+				const auto it = uuidMap.find(dep);
+				if (it == uuidMap.end() || it->second == i)
+					continue; // Provided by another library, which is ordered by GetLibraryDependencies
+				dependents[it->second].push_back(i);
+				++pending[i];
+			}
+		}
+
+		Vector<PInterface> sorted;
+		sorted.reserve(count);
+		Vector<bool> added(count, false);
+		bool progress = true;
+		while (progress && sorted.size() < count)
+		{
+			progress = false;
+			for (sizet i = 0; i < count; ++i)
+			{
+				if (added[i] || pending[i] != 0)
+					continue;
+				added[i] = true;
+				progress = true;
+				sorted.push_back(m_Managers[i]);
+				for (const auto dependent : dependents[i])
+					--pending[dependent];
+			}
+		}
+
+		if (sorted.size() != count)
+		{
+			LogWarning(Format("The interfaces of %s have circular dependencies, keeping their declaration order.", GetLibraryName().data()));
+			return;
+		}
+		m_Managers = std::move(sorted);
+	}
+
 	INLINE void IGreaperLibrary::RegisterManagers() noexcept
 	{
 		auto libRes = m_Application->GetGreaperLibrary(GetLibraryUuid());
@@ -97,8 +162,15 @@ namespace greaper
 
 	INLINE void IGreaperLibrary::RemoveProperties() noexcept
 	{
+		LOCK(m_ConfigMutex);
 		for(const auto& mgr : m_Managers)
 			mgr->DeinitProperties();
+		if (m_Application != nullptr)
+		{
+			auto& registry = m_Application->GetPropertyRegistry();
+			for (const auto& prop : m_Properties)
+				registry.Unregister(GetLibraryName(), prop);
+		}
 		m_Properties.clear();
 		m_PropertyMap.clear();
 	}
@@ -108,120 +180,469 @@ namespace greaper
 		return true;
 	}
 
-	INLINE void IGreaperLibrary::ExportConfig() noexcept
+	NODISCARD INLINE ConfigFormat_t IGreaperLibrary::GetConfigFormat() const noexcept
 	{
-		const auto configPath = std::filesystem::current_path() / "Config";
-		const auto configFileName = String{GetLibraryName()} + ".json";
-		const auto configFilePath = configPath / configFileName;
+		return ConfigFormat_t::JSON;
+	}
 
-		std::filesystem::create_directories(configPath);
-		std::filesystem::remove(configFilePath);
-		FileStream stream{ configFilePath, FileStream::READ | FileStream::WRITE };
+	NODISCARD INLINE bool IGreaperLibrary::IsConfigDirty() const noexcept
+	{
+		sizet index = 0;
+		for (const auto& prop : m_Properties)
+		{
+			if (prop->IsStatic())
+				continue; // Static are regenerated each library init, never stored
+			if (index >= m_ConfigVersions.size())
+				return true;
+			const auto& [storedProp, version] = m_ConfigVersions[index++];
+			if (storedProp != prop.get() || version != prop->GetVersion())
+				return true;
+		}
+		return index != m_ConfigVersions.size();
+	}
 
-		// Something went wrong
-		if(!stream.IsWritable())
+	INLINE void IGreaperLibrary::StoreConfigVersions() noexcept
+	{
+		m_ConfigVersions.clear();
+		for (const auto& prop : m_Properties)
 		{
-			LogError("Something went wrong while creating the config file");
-			return;
+			if (!prop->IsStatic())
+				m_ConfigVersions.emplace_back(prop.get(), prop->GetVersion());
 		}
+	}
+
+	NODISCARD INLINE std::filesystem::path IGreaperLibrary::GetConfigFilePath(ConfigFormat_t format) const noexcept
+	{
+		const auto configPath = std::filesystem::current_path() / "Config";
+		const auto configFileName = String{ GetLibraryName() } + (format == ConfigFormat_t::Binary ? ".gcfg" : ".json");
+		return configPath / configFileName;
+	}
 
+	INLINE String IGreaperLibrary::SerializeConfigJSON(const Vector<PIProperty>& properties) noexcept
+	{
 		auto json = SPtr<cJSON>(cJSON_CreateObject(), cJSON_Delete);
-		for (const auto& prop : m_Properties)
+		for (const auto& prop : properties)
 		{
 			if(prop->IsStatic())
 				continue; // Static are regenerated each library init, never stored
 			prop->_ValueToJSON(json.get(), prop->GetPropertyName());
 		}
 		auto text = SPtr<char>(cJSON_Print(json.get()));
-		const auto textLength = strlen(text.get());
-		auto written = stream.Write(text.get(), textLength);
-		if(written < 0 || (sizet)written != textLength)
+		return String{ text.get() };
+	}
+
+	/* Binary config layout: magic, version, property count and, for each property,
+	*  name, value type ID, value size in bytes and the value as written by ToStream */
+	INLINE TResult<String> IGreaperLibrary::SerializeConfigBinary(const Vector<PIProperty>& properties) noexcept
+	{
+		using HeaderCat = refl::TypeInfo<uint32>::Type;
+		using NameCat = refl::TypeInfo<String>::Type;
+		using TypeIDCat = refl::TypeInfo<ReflectedTypeID_t>::Type;
+		using SizeCat = refl::TypeInfo<int64>::Type;
+
+		uint32 count = 0;
+		for (const auto& prop : properties)
+		{
+			if (!prop->IsStatic())
+				++count;
+		}
+
+		MemoryStream stream{};
+		HeaderCat::ToStream(BinaryConfigMagic, stream);
+		HeaderCat::ToStream(BinaryConfigVersion, stream);
+		HeaderCat::ToStream(count, stream);
+		for (const auto& prop : properties)
 		{
-			LogWarning(Format("Something went wrong while writting the config file, TextLength:%" PRIiPTR " Written:%" PRIiPTR ".", textLength, written));
-			return; // Added in case we need to expand this function
+			if (prop->IsStatic())
+				continue; // Static are regenerated each library init, never stored
+			NameCat::ToStream(prop->GetPropertyName(), stream);
+			TypeIDCat::ToStream(prop->_ValueTypeID(), stream);
+			// The size is patched once the value is written, so a concurrent change cannot make it mismatch
+			const auto sizePos = stream.Tell();
+			SizeCat::ToStream(0, stream);
+			auto res = prop->_ValueToStream(stream);
+			if (res.HasFailed())
+				return Result::CopyFailure<String>(res);
+			const auto endPos = stream.Tell();
+			stream.Seek(sizePos);
+			SizeCat::ToStream((int64)res.GetValue(), stream);
+			stream.Seek(endPos);
 		}
+		return Result::CreateSuccess(String{ (const char*)stream.GetData(), (sizet)stream.Tell() });
 	}
 
-	INLINE void IGreaperLibrary::ImportConfig() noexcept
+	INLINE TResult<sizet> IGreaperLibrary::DeserializeConfigJSON(const String& text) noexcept
 	{
-		if(m_Properties.empty())
-			return; // No config to import
+		auto json = SPtr<cJSON>(cJSON_Parse(text.c_str()), cJSON_Delete);
+		if (json == nullptr)
+			return Result::CreateFailure<sizet>("Config file could not be parsed as JSON."sv);
 
-		const auto configPath = std::filesystem::current_path() / "Config";
-		const auto configFileName = String{GetLibraryName()} + ".json";
-		const auto configFilePath = configPath / configFileName;
+		sizet loaded = 0;
+		for(auto& prop : m_Properties)
+		{
+			if (prop->IsStatic())
+				continue; // Static are regenerated each library init, never stored
+			auto res = prop->_ValueFromJSON(json.get(), prop->GetPropertyName());
+			if (res.HasFailed())
+				LogWarning(res.GetFailMessage());
+			else
+				++loaded;
+		}
+		return Result::CreateSuccess(loaded);
+	}
+
+	INLINE EmptyResult IGreaperLibrary::VisitConfigBinary(const String& data, const std::function<void(const PIProperty&, IStream&)>& visitFn) noexcept
+	{
+		using HeaderCat = refl::TypeInfo<uint32>::Type;
+		using NameCat = refl::TypeInfo<String>::Type;
+		using TypeIDCat = refl::TypeInfo<ReflectedTypeID_t>::Type;
+		using SizeCat = refl::TypeInfo<int64>::Type;
+
+		MemoryStream stream{ (void*)data.data(), data.size() };
+		uint32 magic = 0, version = 0, count = 0;
+		HeaderCat::FromStream(magic, stream);
+		HeaderCat::FromStream(version, stream);
+		auto res = HeaderCat::FromStream(count, stream);
+		if (res.HasFailed() || magic != BinaryConfigMagic || version != BinaryConfigVersion)
+			return Result::CreateFailure(Format("Config file is not a valid binary config, Magic:%" PRIu32 " Version:%" PRIu32 ".", magic, version));
+
+		for (uint32 i = 0; i < count; ++i)
+		{
+			String name;
+			ReflectedTypeID_t typeID = 0;
+			int64 valueSize = 0;
+			NameCat::FromStream(name, stream);
+			TypeIDCat::FromStream(typeID, stream);
+			res = SizeCat::FromStream(valueSize, stream);
+			const auto valueStart = stream.Tell();
+			if (res.HasFailed() || valueSize < 0 || (sizet)(valueStart + valueSize) > data.size())
+				return Result::CreateFailure(Format("Config file is truncated, stopped at property %" PRIu32 " of %" PRIu32 ".", i, count));
+
+			auto propRes = GetProperty(name);
+			auto prop = propRes.IsOk() ? propRes.GetValue().lock() : PIProperty{};
+			if (prop == nullptr || prop->IsStatic())
+				LogVerbose(Format("Config file has the unknown property '%s', skipping it.", name.c_str()));
+			else if (prop->_ValueTypeID() != typeID)
+				LogWarning(Format("Config file has the property '%s' with a different type, expected:%" PRIi64 " obtained:%" PRIi64 ".", name.c_str(), prop->_ValueTypeID(), typeID));
+			else
+				visitFn(prop, stream);
+			stream.Seek(valueStart + (ssizet)valueSize);
+		}
+		return Result::CreateSuccess();
+	}
+
+	INLINE TResult<sizet> IGreaperLibrary::DeserializeConfigBinary(const String& data) noexcept
+	{
+		sizet loaded = 0;
+		EmptyResult res = VisitConfigBinary(data, [this, &loaded](const PIProperty& prop, IStream& stream)
+			{
+				auto valueRes = prop->_ValueFromStream(stream);
+				if (valueRes.HasFailed())
+					LogWarning(valueRes.GetFailMessage());
+				else
+					++loaded;
+			});
+		if (res.HasFailed())
+			return Result::CopyFailure<sizet>(res);
+		return Result::CreateSuccess(loaded);
+	}
+
+	/* Writes next to the destination and renames over it, so the config file is never left half written */
+	INLINE EmptyResult IGreaperLibrary::WriteConfigFile(const std::filesystem::path& filePath, const String& data) noexcept
+	{
+		auto tempPath = filePath;
+		tempPath += ".tmp";
+		std::error_code ec;
+		std::filesystem::create_directories(filePath.parent_path(), ec);
+		std::filesystem::remove(tempPath, ec);
+		{
+			FileStream stream{ tempPath, FileStream::READ | FileStream::WRITE };
+			// Something went wrong
+			if (!stream.IsWritable())
+				return Result::CreateFailure(Format("Something went wrong while creating the config file '%s'.", tempPath.string().c_str()));
+			const auto written = stream.Write(data.data(), (ssizet)data.size());
+			if (written < 0 || (sizet)written != data.size())
+				return Result::CreateFailure(Format("Something went wrong while writting the config file, TextLength:%" PRIuPTR " Written:%" PRIiPTR ".", data.size(), written));
+		}
+		std::filesystem::rename(tempPath, filePath, ec);
+		if (ec)
+			return Result::CreateFailure(Format("Couldn't replace the config file '%s', reason: %s.", filePath.string().c_str(), ec.message().c_str()));
+		return Result::CreateSuccess();
+	}
 
-		std::filesystem::create_directories(configPath);
-		FileStream stream{ configFilePath, FileStream::READ };
-		// Could not be opened because it didn't exist
-		if(!stream.IsReadable())
-			return; 
+	INLINE TResult<String> IGreaperLibrary::ReadConfigFile(const std::filesystem::path& filePath) noexcept
+	{
+		FileStream stream{ filePath, FileStream::READ };
+		if (!stream.IsReadable())
+			return Result::CreateFailure<String>(Format("Config file '%s' could not be opened.", filePath.string().c_str()));
 
 		String fileTxt{};
 		const auto fileLength = stream.Size();
-		if(fileLength <= 0) 
+		if (fileLength <= 0)
 		{ // Empty or something went wrong
-			LogWarning("Config file could not be read, length <= 0.");
-			return;
+			return Result::CreateFailure<String>("Config file could not be read, length <= 0."sv);
 		}
 		fileTxt.resize(fileLength);
 		auto readAmount = stream.Read(fileTxt.data(), fileLength);
 		stream.Close(); // Close the file as soon as possible
-		if(readAmount != fileLength)
+		if (readAmount != fileLength)
 		{ // Couldn't read it all? Something went wrong
-			LogWarning(Format("Something went wrong while reading the config file, FileSize:%" PRIiPTR " Read:%" PRIiPTR ".", fileLength, readAmount));
+			return Result::CreateFailure<String>(Format("Something went wrong while reading the config file, FileSize:%" PRIiPTR " Read:%" PRIiPTR ".", fileLength, readAmount));
+		}
+		return Result::CreateSuccess(std::move(fileTxt));
+	}
+
+	INLINE TResult<String> IGreaperLibrary::ReadStoredConfig(ConfigFormat_t& format) const noexcept
+	{
+		format = GetConfigFormat();
+		auto configFilePath = GetConfigFilePath(format);
+		std::error_code ec;
+		if (!std::filesystem::exists(configFilePath, ec))
+		{ // Fall back to the other format, the next export will convert it
+			format = format == ConfigFormat_t::Binary ? ConfigFormat_t::JSON : ConfigFormat_t::Binary;
+			configFilePath = GetConfigFilePath(format);
+			if (!std::filesystem::exists(configFilePath, ec))
+				return Result::CreateSuccess(String{}); // No config stored yet
+		}
+		return ReadConfigFile(configFilePath);
+	}
+
+	INLINE void IGreaperLibrary::WaitForConfigExport() noexcept
+	{
+		LOCK(m_ConfigMutex);
+		if (!m_ConfigExportTask.valid())
+			return;
+
+		const auto res = m_ConfigExportTask.get();
+		if (res.HasFailed())
+		{
+			m_ConfigVersions.clear(); // Not written, retry on the next export
+			m_ConfigFileHash = 0;
+			LogWarning(res.GetFailMessage());
 			return;
 		}
-		auto json = SPtr<cJSON>(cJSON_Parse(fileTxt.c_str()), cJSON_Delete);
-		for(auto& prop : m_Properties)
+		m_ConfigFileHash = res.GetValue();
+	}
+
+	INLINE void IGreaperLibrary::ExportConfig() noexcept
+	{
+		LOCK(m_ConfigMutex);
+		WaitForConfigExport();
+		if (!IsConfigDirty())
 		{
-			if (prop->IsStatic())
-				continue; // Static are regenerated each library init, never stored
-			auto res = prop->_ValueFromJSON(json.get(), prop->GetPropertyName());
+			LogVerbose("Config has not changed since it was imported or exported, skipping the export.");
+			return;
+		}
+
+		// Versions are taken before serializing, a change racing with it will be exported next time
+		StoreConfigVersions();
+		const auto format = GetConfigFormat();
+
+		// Serialized from a copy, the properties may be removed right after this
+		auto promise = ConstructShared<std::promise<TResult<uint64>>>();
+		m_ConfigExportTask = promise->get_future();
+		std::function<void()> exportFn = [promise, properties = m_Properties, format, filePath = GetConfigFilePath(format)]()
+			{
+				String data;
+				if (format == ConfigFormat_t::Binary)
+				{
+					auto res = SerializeConfigBinary(properties);
+					if (res.HasFailed())
+					{
+						promise->set_value(Result::CreateFailure<uint64>("Something went wrong while serializing the config, reason: " + res.GetFailMessage()));
+						return;
+					}
+					data = std::move(res.GetValue());
+				}
+				else
+				{
+					data = SerializeConfigJSON(properties);
+				}
+				EmptyResult res = WriteConfigFile(filePath, data);
+				if (res.HasFailed())
+					promise->set_value(Result::CopyFailure<uint64>(res));
+				else
+					promise->set_value(Result::CreateSuccess(HashBytes(data.data(), data.size())));
+			};
+
+		if (m_Application == nullptr || m_Application->AddBackgroundTask("ConfigExport"sv, exportFn).HasFailed())
+			exportFn();
+	}
+
+	INLINE void IGreaperLibrary::ImportConfig() noexcept
+	{
+		if(m_Properties.empty())
+			return; // No config to import
+
+		LOCK(m_ConfigMutex);
+		WaitForConfigExport(); // A previous export may still be writing the file
+
+		ConfigFormat_t format;
+		auto fileRes = ReadStoredConfig(format);
+		if (fileRes.HasFailed())
+		{
+			LogWarning(fileRes.GetFailMessage());
+			return;
+		}
+		const auto& data = fileRes.GetValue();
+		if (data.empty())
+			return; // No config stored yet
+
+		auto loadRes = format == ConfigFormat_t::Binary ? DeserializeConfigBinary(data) : DeserializeConfigJSON(data);
+		if (loadRes.HasFailed())
+		{
+			LogWarning(loadRes.GetFailMessage());
+			return;
+		}
+
+		StoreConfigVersions();
+		m_ConfigFileHash = HashBytes(data.data(), data.size());
+		// Properties missing from the file or a format change require the next export to write it
+		if (loadRes.GetValue() != m_ConfigVersions.size() || format != GetConfigFormat())
+			m_ConfigVersions.clear();
+	}
+
+	INLINE TResult<sizet> IGreaperLibrary::ReloadConfig() noexcept
+	{
+		// Checked under the lock, DeinitLibrary takes it to stop the library, so this reload either ends before or doesn't start
+		LOCK(m_ConfigMutex);
+		if (m_InitializationState.load(std::memory_order_acquire) != InitState_t::Started)
+			return Result::CreateFailure<sizet>(Format("Trying to reload the config of %s, but the library is not started.", GetLibraryName().data()));
+
+		WaitForConfigExport();
+
+		ConfigFormat_t format;
+		auto fileRes = ReadStoredConfig(format);
+		if (fileRes.HasFailed())
+			return Result::CopyFailure<sizet>(fileRes);
+		const auto& data = fileRes.GetValue();
+		const auto fileHash = HashBytes(data.data(), data.size());
+		if (data.empty() || fileHash == m_ConfigFileHash)
+			return Result::CreateSuccess<sizet>(0); // Nothing stored or our own export
+
+		// Only the values that differ are staged, so unchanged properties are not even locked
+		PropertyTransaction transaction;
+		const auto stageChange = [&transaction, this](const PIProperty& prop, TResult<PPropertyChange> changeRes)
+			{
+				if (changeRes.HasFailed() || !changeRes.GetValue()->_Differs())
+					return;
+				if (prop->IsConstant())
+				{
+					LogWarning(Format("Config reload tried to change the constant property '%s', ignoring it.", prop->GetPropertyName().c_str()));
+					return;
+				}
+				transaction.StageChange(prop, changeRes.GetValue());
+			};
+
+		if (format == ConfigFormat_t::Binary)
+		{
+			EmptyResult res = VisitConfigBinary(data, [&stageChange](const PIProperty& prop, IStream& stream)
+				{ stageChange(prop, prop->_CreateChangeFromStream(stream)); });
 			if (res.HasFailed())
-				LogWarning(res.GetFailMessage());
+				return Result::CopyFailure<sizet>(res);
 		}
+		else
+		{
+			auto json = SPtr<cJSON>(cJSON_Parse(data.c_str()), cJSON_Delete);
+			if (json == nullptr)
+				return Result::CreateFailure<sizet>("Config file could not be parsed as JSON."sv);
+			for (const auto& prop : m_Properties)
+			{
+				if (prop->IsStatic())
+					continue; // Static are regenerated each library init, never stored
+				stageChange(prop, prop->_CreateChangeFromJSON(json.get(), prop->GetPropertyName()));
+			}
+		}
+
+		const bool wasDirty = IsConfigDirty();
+		auto commitRes = transaction.Commit();
+		if (commitRes.HasFailed())
+			return commitRes;
+
+		m_ConfigFileHash = fileHash;
+		if (!wasDirty)
+			StoreConfigVersions(); // The file already holds the reloaded values
+		Log(Format("Config of %s reloaded, %" PRIuPTR " properties changed.", GetLibraryName().data(), commitRes.GetValue()));
+		return commitRes;
 	}
 
 	INLINE void IGreaperLibrary::InitLibrary(PLibrary lib, PApplication app) noexcept
 	{
-		using namespace std::placeholders;
+		StartInitLibrary(std::move(lib), std::move(app));
+		RegisterLibraryContents();
+		ImportLibraryConfig();
+		FinishInitLibrary();
+	}
 
-		VerifyEqual(m_InitializationState, InitState_t::Stopped, "Trying to initialize a library that is not fully stopped.");
+	INLINE void IGreaperLibrary::StartInitLibrary(PLibrary lib, PApplication app) noexcept
+	{
+		VerifyEqual(m_InitializationState.load(std::memory_order_acquire), InitState_t::Stopped, "Trying to initialize a library that is not fully stopped.");
 
 		const auto [major, minor, patch, rev] = GetGreaperVersionValues(GetLibraryVersion());
 		Log(Format("Initializing %s library ver. %d.%d.%d.%d...", GetLibraryName().data(), 
 			major, minor, patch, rev));
 
-		m_InitializationState = InitState_t::Starting;
+		m_InitializationState.store(InitState_t::Starting, std::memory_order_release);
 
 		m_Library = std::move(lib);
 		m_Application = std::move(app);
 
+		m_InitTimings = InitTimings{};
+		const auto initStart = Clock_t::now();
 		Initialize();
+		m_InitTimings.Initialize = Clock_t::now() - initStart;
+	}
+
+	INLINE void IGreaperLibrary::RegisterLibraryContents() noexcept
+	{
+		VerifyEqual(m_InitializationState.load(std::memory_order_acquire), InitState_t::Starting, "Trying to register the contents of a library that is not starting.");
+
+		const auto managersStart = Clock_t::now();
 		AddManagers();
+		SortManagersByDependencies();
 		RegisterManagers();
+		const auto propertiesStart = Clock_t::now();
 		AddProperties();
+		m_InitTimings.Managers = propertiesStart - managersStart;
+		m_InitTimings.Properties = Clock_t::now() - propertiesStart;
+	}
+
+	INLINE void IGreaperLibrary::ImportLibraryConfig() noexcept
+	{
+		VerifyEqual(m_InitializationState.load(std::memory_order_acquire), InitState_t::Starting, "Trying to import the config of a library that is not starting.");
+
+		const auto configStart = Clock_t::now();
 		if(ShouldImportExportConfig())
 			ImportConfig();
+		m_InitTimings.ImportConfig = Clock_t::now() - configStart;
+	}
+
+	INLINE void IGreaperLibrary::FinishInitLibrary() noexcept
+	{
+		using namespace std::placeholders;
+
+		VerifyEqual(m_InitializationState.load(std::memory_order_acquire), InitState_t::Starting, "Trying to finish the initialization of a library that is not starting.");
+
+		// Only the steps themselves, not the time spent waiting between them
+		m_InitTimings.Total = m_InitTimings.Initialize + m_InitTimings.Managers + m_InitTimings.Properties + m_InitTimings.ImportConfig;
 
+		PLogManager logManager;
 		if (m_Application != nullptr)
 		{
 			auto logMgrRes = m_Application->GetActiveInterface(ILogManager::InterfaceUUID);
 			if (logMgrRes.IsOk())
 			{
-				m_LogManager = logMgrRes.GetValue();
+				logManager = logMgrRes.GetValue();
 			}
 		}
 
-		if (m_LogManager != nullptr)
+		if (logManager != nullptr)
 		{
-			m_LogManager->GetActivationEvent().Connect(m_OnLogActivation,
+			logManager->GetActivationEvent().Connect(m_OnLogActivation,
 														[this](bool active, IInterface* oldLog, const PInterface& newLog)
 														{ OnLogActivation(active, oldLog, newLog); });
-			m_LogActivated = m_LogManager->IsActive();
-			if (m_LogActivated)
-				DumpStoredLogs();
+			SetLogManager(std::move(logManager));
+			DumpStoredLogs();
 		}
 		else
 		{
@@ -231,16 +652,20 @@ namespace greaper
 		}
 
 		Log(Format("%s has been initialized.", GetLibraryName().data()));
-		m_InitializationState = InitState_t::Started;
+		m_InitializationState.store(InitState_t::Started, std::memory_order_release);
 	}
 
 	INLINE void IGreaperLibrary::DeinitLibrary() noexcept
 	{
-		VerifyEqual(m_InitializationState, InitState_t::Started, "Trying to deinitialize a library that is not fully started.");
+		VerifyEqual(m_InitializationState.load(std::memory_order_acquire), InitState_t::Started, "Trying to deinitialize a library that is not fully started.");
 
 		Log(Format("Deinitializing %s...", GetLibraryName().data()));
 
-		m_InitializationState = InitState_t::Stopping;
+		{
+			// Waits for a reload running on the ConfigWatcher thread, the next ones see the library stopping
+			LOCK(m_ConfigMutex);
+			m_InitializationState.store(InitState_t::Stopping, std::memory_order_release);
+		}
 
 		if(ShouldImportExportConfig())
 			ExportConfig();
@@ -249,19 +674,24 @@ namespace greaper
 		RemoveManagers();
 		Deinitialize();
 		m_Application.reset();
+		// Shutdown still waits for the last export to be written
+		WaitForConfigExport();
 
 		Log(Format("%s has been deinitialized.", GetLibraryName().data()));
 
 		m_OnLogActivation.Disconnect();
 		m_OnNewLog.Disconnect();
-		m_LogActivated = false;
-		m_LogManager.reset();
+		SetLogManager(PLogManager{});
 
-		m_InitializationState = InitState_t::Stopped;
+		m_InitializationState.store(InitState_t::Stopped, std::memory_order_release);
 	}
 
 	inline WApplication IGreaperLibrary::GetApplication() const noexcept { return (WApplication)m_Application; }
 
+	INLINE Vector<StringView> IGreaperLibrary::GetLibraryDependencies() const noexcept { return {}; }
+
+	INLINE const IGreaperLibrary::InitTimings& IGreaperLibrary::GetInitTimings() const noexcept { return m_InitTimings; }
+
 	INLINE WLibrary IGreaperLibrary::GetOSLibrary() const noexcept { return (WLibrary)m_Library; }
 
 	inline CSpan<PInterface> IGreaperLibrary::GetManagers() const noexcept { return CreateSpan(m_Managers); }
@@ -279,44 +709,46 @@ namespace greaper
 		return Result::CreateSuccess((WIProperty)prop);
 	}
 
+	INLINE IGreaperLibrary::PropertiesChangedEvent_t& IGreaperLibrary::GetOnPropertiesChangedEvent() const noexcept { return m_OnPropertiesChanged; }
+
 	INLINE void IGreaperLibrary::Log(const String& message) const noexcept
 	{
-		if (m_LogActivated && m_LogManager != nullptr)
-			m_LogManager->Log(LogLevel_t::INFORMATIVE, message, GetLibraryName());
-		else
-			m_InitLogs.push_back(LogData{ message, std::chrono::system_clock::now(), LogLevel_t::INFORMATIVE, GetLibraryName() });
+		LogWithLevel(LogLevel_t::INFORMATIVE, message);
 	}
 
 	INLINE void IGreaperLibrary::LogVerbose(const String& message) const noexcept
 	{
-		if (m_LogActivated && m_LogManager != nullptr)
-			m_LogManager->Log(LogLevel_t::VERBOSE, message, GetLibraryName());
-		else
-			m_InitLogs.push_back(LogData{ message, std::chrono::system_clock::now(), LogLevel_t::VERBOSE, GetLibraryName() });
+		LogWithLevel(LogLevel_t::VERBOSE, message);
 	}
 
 	INLINE void IGreaperLibrary::LogWarning(const String& message) const noexcept
 	{
-		if (m_LogActivated && m_LogManager != nullptr)
-			m_LogManager->Log(LogLevel_t::WARNING, message, GetLibraryName());
-		else
-			m_InitLogs.push_back(LogData{ message, std::chrono::system_clock::now(), LogLevel_t::WARNING, GetLibraryName() });
+		LogWithLevel(LogLevel_t::WARNING, message);
 	}
 
 	INLINE void IGreaperLibrary::LogError(const String& message) const noexcept
 	{
-		if (m_LogActivated && m_LogManager != nullptr)
-			m_LogManager->Log(LogLevel_t::ERROR, message, GetLibraryName());
-		else
-			m_InitLogs.push_back(LogData{ message, std::chrono::system_clock::now(), LogLevel_t::ERROR, GetLibraryName() });
+		LogWithLevel(LogLevel_t::ERROR, message);
 	}
 
 	INLINE void IGreaperLibrary::LogCritical(const String& message) const noexcept
 	{
-		if (m_LogActivated && m_LogManager != nullptr)
-			m_LogManager->Log(LogLevel_t::CRITICAL, message, GetLibraryName());
-		else
-			m_InitLogs.push_back(LogData{ message, std::chrono::system_clock::now(), LogLevel_t::CRITICAL, GetLibraryName() });
+		LogWithLevel(LogLevel_t::CRITICAL, message);
+	}
+
+	INLINE void IGreaperLibrary::LogWithLevel(LogLevel_t level, const String& message) const noexcept
+	{
+		PLogManager logManager;
+		{
+			LOCK(m_LogMutex);
+			if (!m_LogActivated || m_LogManager == nullptr)
+			{
+				m_InitLogs.push_back(LogData{ message, std::chrono::system_clock::now(), level, GetLibraryName() });
+				return;
+			}
+			logManager = m_LogManager;
+		}
+		logManager->Log(level, message, GetLibraryName());
 	}
 
 	INLINE void IGreaperLibrary::OnNewLog(const PInterface& newInterface) noexcept
@@ -328,15 +760,13 @@ namespace greaper
 
 		if (newInterface->GetInterfaceUUID() == ILogManager::InterfaceUUID)
 		{
-			m_LogManager = newInterface;
-			m_LogActivated = m_LogManager->IsActive();
+			SetLogManager((PLogManager)newInterface);
 			m_OnLogActivation.Disconnect();
-			m_LogManager->GetActivationEvent().Connect(m_OnLogActivation,
+			newInterface->GetActivationEvent().Connect(m_OnLogActivation,
 					[this](bool active, IInterface* oldLog, const PInterface& newLog)
 					{ OnLogActivation(active, oldLog, newLog); });
 			m_OnNewLog.Disconnect();
-			if (m_LogActivated)
-				DumpStoredLogs();
+			DumpStoredLogs();
 		}
 	}
 
@@ -348,20 +778,17 @@ namespace greaper
 		{
 			if (newLog != nullptr) // new log manager
 			{
-				m_LogManager = newLog;
-				m_LogActivated = m_LogManager->IsActive();
+				SetLogManager((PLogManager)newLog);
 				m_OnLogActivation.Disconnect();
-				m_LogManager->GetActivationEvent().Connect(m_OnLogActivation,
+				newLog->GetActivationEvent().Connect(m_OnLogActivation,
 						[this](bool active, IInterface* oldLog, const PInterface& newLog)
 						{ OnLogActivation(active, oldLog, newLog); });
-				if (m_LogActivated)
-					DumpStoredLogs();
+				DumpStoredLogs();
 			}
 			else // the current log manager was deactivated
 			{
 				m_OnLogActivation.Disconnect();
-				m_LogManager.reset();
-				m_LogActivated = false;
+				SetLogManager(PLogManager{});
 				m_Application->GetOnInterfaceActivationEvent().Connect(m_OnNewLog,
 						[this](const PInterface& newInterface)
 						{ OnNewLog(newInterface); });
@@ -369,25 +796,39 @@ namespace greaper
 		}
 		else // the current log manager was activated, we shouldn't arrive here
 		{
-			m_LogManager = newLog;
-			m_LogActivated = m_LogManager->IsActive();
+			SetLogManager((PLogManager)newLog);
 			m_OnLogActivation.Disconnect();
-			m_LogManager->GetActivationEvent().Connect(m_OnLogActivation,
+			newLog->GetActivationEvent().Connect(m_OnLogActivation,
 					[this](bool active, IInterface* oldLog, const PInterface& newLog)
 					{ OnLogActivation(active, oldLog, newLog); });
-			if (m_LogActivated)
-				DumpStoredLogs();
+			DumpStoredLogs();
 		}
 	}
 
+	INLINE void IGreaperLibrary::SetLogManager(PLogManager logManager) noexcept
+	{
+		LOCK(m_LogMutex);
+		m_LogActivated = logManager != nullptr && logManager->IsActive();
+		m_LogManager = std::move(logManager);
+	}
+
 	INLINE void IGreaperLibrary::DumpStoredLogs() noexcept
 	{
-		for (const auto& log : m_InitLogs)
-			m_LogManager->_Log(log);
-		m_InitLogs.clear();
+		// Taken out under the lock, the logs that come meanwhile already go to the manager
+		PLogManager logManager;
+		Vector<LogData> logs;
+		{
+			LOCK(m_LogMutex);
+			if (!m_LogActivated || m_LogManager == nullptr)
+				return;
+			logManager = m_LogManager;
+			logs.swap(m_InitLogs);
+		}
+		for (const auto& log : logs)
+			logManager->_Log(log);
 	}
 	
-	INLINE bool IGreaperLibrary::IsInitialized() const noexcept { return m_InitializationState == InitState_t::Started; }
+	INLINE bool IGreaperLibrary::IsInitialized() const noexcept { return m_InitializationState.load(std::memory_order_acquire) == InitState_t::Started; }
 	
-	INLINE InitState_t IGreaperLibrary::GetInitializationState() const noexcept { return m_InitializationState; }
+	INLINE InitState_t IGreaperLibrary::GetInitializationState() const noexcept { return m_InitializationState.load(std::memory_order_acquire); }
 }
\ No newline at end of file
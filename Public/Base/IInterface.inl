@@ -23,6 +23,36 @@ namespace greaper
 		return m_Library;
 	}
 
+	INLINE Vector<Uuid> IInterface::GetInterfaceDependencies() const noexcept
+	{
+		return {};
+	}
+
+	INLINE void IInterface::PreUpdate() noexcept
+	{
+		/* No-op */
+	}
+
+	INLINE void IInterface::FixedUpdate() noexcept
+	{
+		/* No-op */
+	}
+
+	INLINE void IInterface::Update() noexcept
+	{
+		/* No-op */
+	}
+
+	INLINE void IInterface::PostUpdate() noexcept
+	{
+		/* No-op */
+	}
+
+	INLINE bool IInterface::IsUpdateThreadSafe() const noexcept
+	{
+		return false;
+	}
+
 	INLINE bool IInterface::IsActive() const noexcept
 	{
 		return m_ActiveState == InitState_t::Started;
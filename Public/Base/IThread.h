@@ -12,9 +12,31 @@
 #include "../Enumeration.h"
 
 ENUMERATION(ThreadState, STOPPED, SUSPENDED, RUNNING, UNMANAGED);
+ENUMERATION(ThreadSchedPolicy, Default, Batch, Idle, FIFO, RoundRobin);
 
 namespace greaper
 {
+	/**
+	 * @brief How the OS schedules a thread, applied before it runs its function.
+	 * Default and Batch are time-shared and use the NiceValue, from -20 (highest) to 19 (lowest),
+	 * a NiceValue of 0 keeps the one inherited from the creator.
+	 * FIFO and RoundRobin are real-time and use the Priority, from 1 to 99 on Linux,
+	 * they and the negative nice values require privileges, otherwise the thread creation fails.
+	 * Idle runs only when nothing else wants the CPU.
+	 */
+	struct ThreadScheduling
+	{
+		ThreadSchedPolicy_t Policy = ThreadSchedPolicy_t::Default;
+		int32 Priority = 0;
+		int32 NiceValue = 0;
+
+		// For throughput work that shouldn't get in the way of the rest of threads
+		static constexpr ThreadScheduling Background()noexcept { return ThreadScheduling{ ThreadSchedPolicy_t::Batch, 0, 10 }; }
+
+		// For threads that must react quickly, lowest real-time priority so it never starves the kernel threads
+		static constexpr ThreadScheduling Latency()noexcept { return ThreadScheduling{ ThreadSchedPolicy_t::RoundRobin, 1, 0 }; }
+	};
+
 	struct ThreadConfig
 	{
 		std::function<void()> ThreadFN = nullptr;
@@ -22,6 +44,23 @@ namespace greaper
 		bool StartSuspended = false;
 		bool JoinAtDestruction = true;
 		StringView Name = "Unnamed"sv;
+		ThreadScheduling Scheduling{};
+	};
+
+	/**
+	 * @brief Runtime counters of a thread, taken at the moment it was queried.
+	 * The counters that the platform doesn't provide are left at 0, LastCPU is -1 when unknown.
+	 */
+	struct ThreadStats
+	{
+		ThreadID_t ID{};
+		String Name;
+		std::chrono::nanoseconds CPUTime{ 0 };
+		std::chrono::nanoseconds UserTime{ 0 };
+		std::chrono::nanoseconds SystemTime{ 0 };
+		uint64 VoluntaryContextSwitches = 0;
+		uint64 InvoluntaryContextSwitches = 0;
+		int32 LastCPU = -1;
 	};
 }
 #if PLT_WINDOWS
@@ -77,7 +77,7 @@ namespace greaper
 			std::strftime(gTimeBuff, ArraySize(gTimeBuff), "%H:%M:%S", std::localtime(&time));
 
 			auto message = Format("[%s][%s][%s]: %s\r\n", gLevelName[(sizet)logData.Level], gTimeBuff, logData.LibraryName.data(), logData.Message.c_str());
-			m_Stream->Write(message.c_str(), (ssizet)(message.length() - 1));
+			m_Stream->Write(message.c_str(), (ssizet)message.length());
 		}
 	};
 }
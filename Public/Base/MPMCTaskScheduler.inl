@@ -31,11 +31,17 @@ namespace greaper
 	}
 	
 	template<class _Alloc_>
-	INLINE SPtr<MPMCTaskScheduler> MPMCTaskScheduler::Create(WThreadManager threadMgr, StringView name, sizet workerCount, bool allowGrowth) noexcept
+	INLINE TResult<PTaskScheduler> MPMCTaskScheduler::Create(WThreadManager threadMgr, StringView name, sizet workerCount, bool allowGrowth, ThreadScheduling scheduling) noexcept
 	{
 		auto* ptr = AllocT<MPMCTaskScheduler, _Alloc_>();
-		new ((void*)ptr)MPMCTaskScheduler(threadMgr, std::move(name), workerCount, allowGrowth);
-		return SPtr<MPMCTaskScheduler>((MPMCTaskScheduler*)ptr, &Impl::DefaultDeleter<MPMCTaskScheduler, _Alloc_>);
+		new ((void*)ptr)MPMCTaskScheduler(threadMgr, std::move(name), scheduling);
+		auto scheduler = SPtr<MPMCTaskScheduler>((MPMCTaskScheduler*)ptr, &Impl::DefaultDeleter<MPMCTaskScheduler, _Alloc_>);
+		// A scheduler without workers would queue tasks forever, ie. a scheduling policy the process can't apply
+		EmptyResult res = scheduler->SetWorkerCount(workerCount);
+		if (res.HasFailed())
+			return Result::CopyFailure<PTaskScheduler>(res);
+		scheduler->EnableGrowth(allowGrowth);
+		return Result::CreateSuccess(scheduler);
 	}
 
 	INLINE MPMCTaskScheduler::~MPMCTaskScheduler() noexcept
@@ -48,61 +54,71 @@ namespace greaper
 
 	inline EmptyResult MPMCTaskScheduler::SetWorkerCount(sizet count) noexcept
 	{
-		m_TaskWorkersMutex.lock();
+		// Serializes whole resizes, the workers lock is released while the removed ones are joined
+		auto countLck = Lock(m_WorkerCountMutex);
+		auto lck = UniqueLock<decltype(m_TaskWorkersMutex)>(m_TaskWorkersMutex);
 		if (m_TaskWorkers.size() == count)
-		{
-			m_TaskWorkersMutex.unlock();
 			return Result::CreateSuccess();
-		}
+
 		// Add new workers
 		if (m_TaskWorkers.size() < count)
 		{
-			auto lck = Lock<decltype(m_TaskWorkersMutex)>(m_TaskWorkersMutex, AdoptLock{});
-			
 			if(!m_AllowGrowth)
 				return Result::CreateFailure("Trying to add more workers to a MPMCTaskScheduler, but it has forbidden the growth."sv);
 
 			if (m_ThreadManager.expired())
 				return Result::CreateFailure("Trying to add more workers to a MPMCTaskScheduler, but the ThreadManager has expired."sv);
 
-			auto thManager = m_ThreadManager.lock();
-			for (sizet i = m_TaskWorkers.size(); i < count; ++i)
+			const auto first = m_TaskWorkers.size();
+			// Reserved first, the configs keep views of the names
+			Vector<String> names;
+			names.reserve(count - first);
+			Vector<ThreadConfig> configs;
+			configs.reserve(count - first);
+			for (sizet i = first; i < count; ++i)
 			{
-				ThreadConfig cfg;
-				auto name = Format("%s_%" PRIuPTR "", m_Name.c_str(), i);
+				const auto& name = names.emplace_back(Format("%s_%" PRIuPTR "", m_Name.c_str(), i));
+				ThreadConfig& cfg = configs.emplace_back();
 				cfg.Name = name;
 				cfg.ThreadFN = [this, i]() { WorkerFn(*this, i); };
-				auto thRes = thManager->CreateThread(cfg);
-				if (thRes.HasFailed())
-					return Result::CopyFailure(thRes);
-				m_TaskWorkers.push_back(thRes.GetValue());
+				cfg.Scheduling = m_Scheduling;
 			}
+
+			// Started all at once, they wait on the workers lock until they've been added
+			auto thRes = m_ThreadManager.lock()->CreateThreads(configs);
+			if (thRes.HasFailed())
+				return Result::CopyFailure(thRes);
+			const auto& threads = thRes.GetValue();
+			m_TaskWorkers.insert(m_TaskWorkers.end(), threads.begin(), threads.end());
+			return Result::CreateSuccess();
 		}
-		// Remove workers
-		else
+
+		// Remove workers, all of them are told to stop at once and joined afterwards
+		Vector<PThread> removed;
+		removed.reserve(m_TaskWorkers.size() - count);
+		for (sizet i = count; i < m_TaskWorkers.size(); ++i)
 		{
-			while (m_TaskWorkers.size() > count)
-			{
-				const auto sz = m_TaskWorkers.size();
-				PThread th = m_TaskWorkers[sz - 1];
-				m_TaskWorkers[sz - 1].reset();
-				m_TaskWorkersMutex.unlock();
-				while (th != nullptr)
-				{
-					if (th->TryJoin())
-					{
-						th.reset();
-					}
-					else
-					{
-						m_TaskQueueSignal.notify_all();
-						THREAD_YIELD();
-					}
-				}
-				m_TaskQueueMutex.lock();
-				m_TaskWorkers.erase(m_TaskWorkers.begin() + (sz - 1));
-			}
+			removed.push_back(std::move(m_TaskWorkers[i]));
+			m_TaskWorkers[i].reset();
+		}
+		lck.unlock();
+
+		// A worker checks whether it can continue under the queue lock, so taking it here ensures
+		// that every removed worker either sees its empty slot or is already waiting for the signal
+		{
+			LOCK(m_TaskQueueMutex);
+		}
+		m_TaskQueueSignal.notify_all();
+
+		for (auto& th : removed)
+		{
+			if (th != nullptr && th->Joinable())
+				th->Join();
 		}
+
+		lck.lock();
+		while (m_TaskWorkers.size() > count && m_TaskWorkers.back() == nullptr)
+			m_TaskWorkers.pop_back();
 		return Result::CreateSuccess();
 	}
 
@@ -145,22 +161,22 @@ namespace greaper
 		return Result::CreateSuccess(hTask);
 	}
 
-	inline TResult<Vector<Impl::HTask>> MPMCTaskScheduler::AddTasks(const Vector<std::tuple<StringView, std::function<void()>>>& tasks) noexcept
+	inline TResult<TaskHandles_t> MPMCTaskScheduler::AddTasks(const Vector<std::tuple<StringView, std::function<void()>>>& tasks) noexcept
 	{
 		if(tasks.empty())
 		{
-			return Result::CreateFailure<Vector<Impl::HTask>>("Trying to add multiple tasks, but an empty task vector was given."sv);
+			return Result::CreateFailure<TaskHandles_t>("Trying to add multiple tasks, but an empty task vector was given."sv);
 		}
 
 		// we keep the lock so if there's only 1 task worker and someone wants to remove it, we can still schedule this task
 		auto wkLck = SharedLock(m_TaskWorkersMutex);
 		if (!AreThereAnyAvailableWorker())
 		{
-			return Result::CreateFailure<Vector<Impl::HTask>>("Couldn't add multiple tasks, no available workers."sv);
+			return Result::CreateFailure<TaskHandles_t>("Couldn't add multiple tasks, no available workers."sv);
 		}
 
-		Vector<SPtr<Impl::Task>> taskPtrs;
-		Vector<Impl::HTask> hTasks;
+		SmallVector<SPtr<Impl::Task>, 8> taskPtrs;
+		TaskHandles_t hTasks;
 		taskPtrs.reserve(tasks.size());
 		hTasks.reserve(tasks.size());
 		while(taskPtrs.size() < tasks.size())
@@ -182,19 +198,18 @@ namespace greaper
 			taskPtr->m_Name.assign(std::get<0>(tuple));
 			taskPtr->m_State = TaskState_t::Inactive;
 			taskPtr->m_WorkFn = std::get<1>(tuple);
-			auto task = SPtr<Impl::Task>{ taskPtr };
+			auto task = SPtr<Impl::Task>{ taskPtr, &Impl::EmptyDeleter<Impl::Task> };
 			hTasks.push_back(Impl::HTask{ (WPtr<Impl::Task>)task, (WPtr<MPMCTaskScheduler>)m_This });
 			taskPtrs.push_back(task);
 		}
 
 		m_TaskQueueMutex.lock();
-		const auto oldSize = m_TaskQueue.size();
-		std::move(taskPtrs.begin(), taskPtrs.end(), m_TaskQueue.begin() + oldSize);
+		m_TaskQueue.insert(m_TaskQueue.end(), std::make_move_iterator(taskPtrs.begin()), std::make_move_iterator(taskPtrs.end()));
 		m_TaskQueueMutex.unlock();
 		for(std::size_t i = 0; i < tasks.size(); ++i)
 			m_TaskQueueSignal.notify_one();
 
-		return Result::CreateSuccess(hTasks);
+		return Result::CreateSuccess(std::move(hTasks));
 	}
 
 	INLINE void MPMCTaskScheduler::WaitUntilTaskIsFinish(const Impl::HTask& hTask) noexcept
@@ -235,6 +250,8 @@ namespace greaper
 		m_AllowGrowth = enable;
 	}
 
+	INLINE const ThreadScheduling& MPMCTaskScheduler::GetScheduling() const noexcept { return m_Scheduling; }
+
 	INLINE void MPMCTaskScheduler::OnNewManager(const PInterface& newInterface) noexcept
 	{
 		auto lck = SharedLock(m_TaskWorkersMutex);
@@ -307,18 +324,16 @@ namespace greaper
 		return false; // There is no active worker
 	}
 
-	INLINE MPMCTaskScheduler::MPMCTaskScheduler(WThreadManager threadMgr, StringView name, sizet workerCount, bool allowGrowth)noexcept
+	INLINE MPMCTaskScheduler::MPMCTaskScheduler(WThreadManager threadMgr, StringView name, ThreadScheduling scheduling)noexcept
 		:m_ThreadManager(std::move(threadMgr))
 		,m_Name(name)
 		,m_This(this, &Impl::EmptyDeleter<MPMCTaskScheduler>)
 		,m_AllowGrowth(true)
+		,m_Scheduling(scheduling)
 	{
 		VerifyNot(m_ThreadManager.expired(), "Trying to initialize a MPMCTaskScheduler, but an expired ThreadManager was given.");
 		auto mgr = m_ThreadManager.lock();
 		mgr->GetActivationEvent().Connect(m_OnManagerActivation, [this](bool active, IInterface* oldInterface, const PInterface& newInterface) { OnManagerActivation(active, oldInterface, newInterface); });
-
-		SetWorkerCount(workerCount);
-		m_AllowGrowth = allowGrowth;
 	}
 
 	INLINE bool MPMCTaskScheduler::CanWorkerContinueWorking(sizet workerID)const noexcept
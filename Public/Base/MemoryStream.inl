@@ -173,7 +173,7 @@ namespace greaper
 		if (newSize > m_Size)
 		{
 			if (m_OwnsMemory)
-				Realloc(newSize);
+				Realloc(Max(newSize, m_Size + (m_Size >> 1))); // geometric growth, keeps writes amortized O(1)
 			else
 				count = m_Size - currentSize;
 		}
@@ -223,4 +223,12 @@ namespace greaper
 		m_OwnsMemory = false;
 		return m_Data;
 	}
+
+	INLINE void MemoryStream::Reserve(const sizet bytes)noexcept
+	{
+		if ((ssizet)bytes <= m_Size)
+			return;
+		VerifyNot(!m_OwnsMemory && m_Data != nullptr, "Trying to reserve memory on a MemoryStream that doesn't own its memory.");
+		Realloc(bytes);
+	}
 }
\ No newline at end of file
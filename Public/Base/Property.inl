@@ -46,6 +46,8 @@ namespace greaper
 		:m_Value(std::move(initialValue))
 		,m_PropertyName(propertyName)
 		,m_PropertyInfo(propertyInfo)
+		,m_StringVersion(0)
+		,m_Version(1)
 		,m_OnModificationEvent("PropertyModified"sv)
 		,m_PropertyValidator(std::move(validator))
 		,m_Library(std::move(library))
@@ -56,7 +58,8 @@ namespace greaper
 			m_PropertyValidator = (SPtr<TPropertyValidator<T>>)ConstructShared<PropertyValidatorNone<T>>(); //.reset(Construct<PropertyValidatorNone<T>>());
 
 		m_PropertyValidator->Validate(m_Value, &m_Value);
-		m_StringValue = refl::TypeInfo<T>::Type::ToString(m_Value);
+		if constexpr (HasLockFreeRead)
+			m_PublishedValue.Store(m_Value);
 	}
 
 	template<class T>
@@ -100,32 +103,44 @@ namespace greaper
 			return false;
 		}
 		auto lock = Lock<RWMutex>(m_Mutex);
-		T old = m_Value;
 		T newValue;
 		if (!m_PropertyValidator->Validate(value, &newValue))
 		{
-			const String nValueStr = refl::TypeInfo<T>::Type::ToString(m_Value);
+			const String oValueStr = refl::TypeInfo<T>::Type::ToString(m_Value);
+			const String nValueStr = refl::TypeInfo<T>::Type::ToString(value);
 			lib->LogWarning(Format("Couldn't validate the new value of Property '%s', oldValue '%s', newValue '%s'.",
-				m_PropertyName.c_str(), m_StringValue.c_str(), nValueStr.c_str()));
+				m_PropertyName.c_str(), oValueStr.c_str(), nValueStr.c_str()));
 			return false;
 		}
-		m_Value = newValue;
-		if (old == m_Value)
+		if (!_StoreValue(newValue))
 		{
-			const String nValueStr = refl::TypeInfo<T>::Type::ToString(m_Value);
-			lib->LogVerbose(Format("Property '%s', has mantain the same value, current '%s', tried '%s'.",
-				m_PropertyName.c_str(), m_StringValue.c_str(), nValueStr.c_str()));
+			const String nValueStr = refl::TypeInfo<T>::Type::ToString(newValue);
+			lib->LogVerbose(Format("Property '%s', has mantain the same value '%s'.",
+				m_PropertyName.c_str(), nValueStr.c_str()));
 			return false; // Property has not changed;
 		}
-		const auto oldStringValue = String{ m_StringValue };
-		m_StringValue = refl::TypeInfo<T>::Type::ToString(m_Value);
-		lib->LogVerbose(Format("Property '%s', has changed from '%s' to '%s'.",
-			m_PropertyName.c_str(), oldStringValue.c_str(), m_StringValue.c_str()));
+		const auto version = m_Version.load(std::memory_order_relaxed);
+		lib->LogVerbose(Format("Property '%s', has changed, version %" PRIu64 ".",
+			m_PropertyName.c_str(), version));
 		if (triggerEvent)
 			m_OnModificationEvent.Trigger(this);
 		return true;
 	}
 
+	template<class T>
+	INLINE bool TProperty<T>::_StoreValue(const T& newValue) noexcept
+	{
+		// m_Mutex must be held for writing
+		if (m_Value == newValue)
+			return false;
+		m_Value = newValue;
+		if constexpr (HasLockFreeRead)
+			m_PublishedValue.Store(m_Value);
+		// The string form is rebuilt on demand, see _UpdateStringValue
+		m_Version.fetch_add(1, std::memory_order_release);
+		return true;
+	}
+
 	template<class T>
 	INLINE bool TProperty<T>::SetValueFromString(const String& value) noexcept
 	{
@@ -138,28 +153,57 @@ namespace greaper
 	template<class T>
 	NODISCARD inline T TProperty<T>::GetValueCopy()const noexcept
 	{
-		auto lck = SharedLock(m_Mutex);
-		return { m_Value };
+		if constexpr (HasLockFreeRead)
+		{
+			return m_PublishedValue.Load();
+		}
+		else
+		{
+			auto lck = SharedLock(m_Mutex);
+			return { m_Value };
+		}
 	}
 
 	template<class T>
 	INLINE void TProperty<T>::AccessValue(const std::function<void(const T&)>& accessFn)const noexcept
 	{
+		if constexpr (HasLockFreeRead)
+		{
+			const T value = m_PublishedValue.Load();
+			accessFn(value);
+		}
+		else
+		{
+			auto lck = SharedLock(m_Mutex);
+			accessFn(m_Value);
+		}
+	}
+
+	template<class T>
+	INLINE void TProperty<T>::_UpdateStringValue()const noexcept
+	{
+		// m_StringMutex must be held, the value mutex is always taken after it
+		if (m_StringVersion == m_Version.load(std::memory_order_acquire))
+			return;
+
 		auto lck = SharedLock(m_Mutex);
-		accessFn(m_Value);
+		m_StringValue = refl::TypeInfo<T>::Type::ToString(m_Value);
+		m_StringVersion = m_Version.load(std::memory_order_relaxed);
 	}
 
 	template<class T>
 	NODISCARD INLINE String TProperty<T>::GetStringValueCopy()const noexcept
 	{
-		auto lck = SharedLock(m_Mutex);
+		auto lck = Lock(m_StringMutex);
+		_UpdateStringValue();
 		return { m_StringValue };
 	}
 
 	template<class T>
 	INLINE void TProperty<T>::AccessStringValue(const std::function<void(const String&)>& accessFn)const noexcept
 	{
-		auto lck = SharedLock(m_Mutex);
+		auto lck = Lock(m_StringMutex);
+		_UpdateStringValue();
 		accessFn(m_StringValue);
 	}
 	
@@ -179,7 +223,6 @@ namespace greaper
 	template<class T>
 	INLINE TResult<ssizet> TProperty<T>::_ValueFromStream(IStream& stream) noexcept
 	{
-		auto lck = Lock(m_Mutex);
 		T value;
 		TResult<ssizet> ret = refl::TypeInfo<T>::Type::FromStream(value, stream);
 		if(ret.HasFailed())
@@ -237,4 +280,87 @@ namespace greaper
 		auto lck = SharedLock(m_Mutex);
 		return ComputeHash(m_Value);
 	}
-}
\ No newline at end of file
+
+	template<class T>
+	NODISCARD INLINE uint64 TProperty<T>::GetVersion()const noexcept
+	{
+		return m_Version.load(std::memory_order_acquire);
+	}
+
+	template<class T>
+	INLINE TResult<PPropertyChange> TProperty<T>::_CreateChangeFromString(const String& value) noexcept
+	{
+		T temp;
+		refl::TypeInfo<T>::Type::FromString(value, temp);
+		return Result::CreateSuccess((PPropertyChange)ConstructShared<TPropertyChange<T>>(this, std::move(temp)));
+	}
+
+	template<class T>
+	INLINE TResult<PPropertyChange> TProperty<T>::_CreateChangeFromJSON(cJSON* json, StringView name) noexcept
+	{
+		T temp;
+		EmptyResult res = refl::TypeInfo<T>::Type::FromJSON(temp, json, name);
+		if (res.HasFailed())
+			return Result::CopyFailure<PPropertyChange>(res);
+		return Result::CreateSuccess((PPropertyChange)ConstructShared<TPropertyChange<T>>(this, std::move(temp)));
+	}
+
+	template<class T>
+	INLINE TResult<PPropertyChange> TProperty<T>::_CreateChangeFromStream(IStream& stream) noexcept
+	{
+		T temp;
+		TResult<ssizet> res = refl::TypeInfo<T>::Type::FromStream(temp, stream);
+		if (res.HasFailed())
+			return Result::CopyFailure<PPropertyChange>(res);
+		return Result::CreateSuccess((PPropertyChange)ConstructShared<TPropertyChange<T>>(this, std::move(temp)));
+	}
+
+	template<class T>
+	INLINE TPropertyChange<T>::TPropertyChange(TProperty<T>* prop, T value) noexcept
+		:m_Property(prop)
+		,m_StagedValue(std::move(value))
+		,m_ValidatedValue()
+	{
+
+	}
+
+	template<class T>
+	NODISCARD INLINE IProperty* TPropertyChange<T>::GetProperty() const noexcept
+	{
+		return m_Property;
+	}
+
+	template<class T>
+	NODISCARD INLINE RWMutex& TPropertyChange<T>::_GetMutex() const noexcept
+	{
+		return m_Property->m_Mutex;
+	}
+
+	template<class T>
+	NODISCARD INLINE bool TPropertyChange<T>::_Differs() const noexcept
+	{
+		auto lck = SharedLock(m_Property->m_Mutex);
+		return !(m_Property->m_Value == m_StagedValue);
+	}
+
+	template<class T>
+	INLINE EmptyResult TPropertyChange<T>::_Validate() noexcept
+	{
+		if (m_Property->m_Constant)
+			return Result::CreateFailure(Format("Trying to change a constant property, '%s'.", m_Property->m_PropertyName.c_str()));
+
+		if (!m_Property->m_PropertyValidator->Validate(m_StagedValue, &m_ValidatedValue))
+		{
+			const String nValueStr = refl::TypeInfo<T>::Type::ToString(m_StagedValue);
+			return Result::CreateFailure(Format("Couldn't validate the new value of Property '%s', newValue '%s'.",
+				m_Property->m_PropertyName.c_str(), nValueStr.c_str()));
+		}
+		return Result::CreateSuccess();
+	}
+
+	template<class T>
+	INLINE bool TPropertyChange<T>::_Apply() noexcept
+	{
+		return m_Property->_StoreValue(m_ValidatedValue);
+	}
+}
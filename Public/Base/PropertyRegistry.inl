@@ -0,0 +1,183 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+namespace greaper
+{
+	template<class T>
+	INLINE TResult<T> PropertyRegistry::Snapshot::GetValue(sizet index) const noexcept
+	{
+		if (index >= Entries.size())
+			return Result::CreateFailure<T>(Format("[PropertyRegistry::Snapshot]::GetValue Index %" PRIuPTR " out of range, the snapshot has %" PRIuPTR " entries.", index, Entries.size()));
+
+		const auto& entry = Entries[index];
+		if (entry.TypeID != refl::TypeInfo<T>::ID)
+			return Result::CreateFailure<T>(Format("[PropertyRegistry::Snapshot]::GetValue Entry %" PRIuPTR " does not hold a value of type '%s'.", index, refl::TypeInfo<T>::Name.data()));
+
+		MemoryStream stream(const_cast<uint8*>(Data.data()) + entry.Offset, entry.Size);
+		T value{};
+		const auto res = refl::TypeInfo<T>::Type::FromStream(value, stream);
+		if (res.HasFailed())
+			return Result::CopyFailure<T>(res);
+		return Result::CreateSuccess(std::move(value));
+	}
+
+	INLINE String PropertyRegistry::MakeAtom(StringView libraryName, StringView propertyName) noexcept
+	{
+		String atom;
+		atom.reserve(libraryName.size() + 1 + propertyName.size());
+		atom.append(libraryName).append(1, '.').append(propertyName);
+		return atom;
+	}
+
+	INLINE TResult<PropertyID_t> PropertyRegistry::Register(StringView libraryName, const PIProperty& property) noexcept
+	{
+		if (property == nullptr)
+			return Result::CreateFailure<PropertyID_t>("[PropertyRegistry]::Register Trying to register a null property."sv);
+
+		const String atom = MakeAtom(libraryName, property->GetPropertyName());
+		auto lck = Lock<RWMutex>(m_Mutex);
+
+		PropertyID_t id;
+		const auto it = m_AtomMap.find(atom);
+		if (it != m_AtomMap.end())
+		{
+			id = it->second;
+			auto& slot = m_Slots[id];
+			if (slot.Property != nullptr && slot.Property != property)
+				return Result::CreateFailure<PropertyID_t>(Format("[PropertyRegistry]::Register Trying to register the property '%s', but its already registered.", atom.c_str()));
+			if (slot.Property == nullptr)
+				++m_RegisteredCount;
+			slot.Property = property;
+			return Result::CreateSuccess(id);
+		}
+
+		if (m_Slots.size() >= (sizet)InvalidPropertyID)
+			return Result::CreateFailure<PropertyID_t>("[PropertyRegistry]::Register Ran out of property IDs."sv);
+
+		id = (PropertyID_t)m_Slots.size();
+		const StringView name = m_Atoms.emplace_back(atom);
+		m_AtomMap.insert_or_assign(name, id);
+		m_Slots.push_back(Slot{ name, property });
+		++m_RegisteredCount;
+		return Result::CreateSuccess(id);
+	}
+
+	INLINE void PropertyRegistry::Unregister(StringView libraryName, const PIProperty& property) noexcept
+	{
+		if (property == nullptr)
+			return;
+
+		const String atom = MakeAtom(libraryName, property->GetPropertyName());
+		auto lck = Lock<RWMutex>(m_Mutex);
+		const auto it = m_AtomMap.find(atom);
+		if (it == m_AtomMap.end())
+			return;
+
+		// The atom and its ID are kept, so a later registration gets the same ID
+		auto& slot = m_Slots[it->second];
+		if (slot.Property != property)
+			return;
+		slot.Property.reset();
+		--m_RegisteredCount;
+	}
+
+	INLINE TResult<PropertyID_t> PropertyRegistry::GetID(StringView atom) const noexcept
+	{
+		auto lck = SharedLock(m_Mutex);
+		const auto it = m_AtomMap.find(atom);
+		if (it == m_AtomMap.end())
+			return Result::CreateFailure<PropertyID_t>(Format("[PropertyRegistry]::GetID Couldn't find the property '%s'.", String(atom).c_str()));
+		return Result::CreateSuccess(it->second);
+	}
+
+	INLINE TResult<PropertyID_t> PropertyRegistry::GetID(StringView libraryName, StringView propertyName) const noexcept
+	{
+		return GetID(MakeAtom(libraryName, propertyName));
+	}
+
+	INLINE StringView PropertyRegistry::GetName(PropertyID_t id) const noexcept
+	{
+		auto lck = SharedLock(m_Mutex);
+		if (id >= m_Slots.size())
+			return {};
+		return m_Slots[id].Name;
+	}
+
+	INLINE TResult<PIProperty> PropertyRegistry::GetByID(PropertyID_t id) const noexcept
+	{
+		auto lck = SharedLock(m_Mutex);
+		if (id >= m_Slots.size())
+			return Result::CreateFailure<PIProperty>(Format("[PropertyRegistry]::GetByID Invalid property ID %" PRIu32 ".", id));
+
+		const auto& slot = m_Slots[id];
+		if (slot.Property == nullptr)
+			return Result::CreateFailure<PIProperty>(Format("[PropertyRegistry]::GetByID The property '%s' is not registered at the moment.", String(slot.Name).c_str()));
+		return Result::CreateSuccess(slot.Property);
+	}
+
+	template<class T>
+	INLINE TResult<TPropertyAccessor<T>> PropertyRegistry::GetAccessor(PropertyID_t id) const noexcept
+	{
+		auto res = GetByID(id);
+		if (res.HasFailed())
+			return Result::CopyFailure<TPropertyAccessor<T>>(res);
+
+		const auto& prop = res.GetValue();
+		if (prop->_ValueTypeID() != refl::TypeInfo<T>::ID)
+			return Result::CreateFailure<TPropertyAccessor<T>>(Format("[PropertyRegistry]::GetAccessor The property '%s' does not hold a value of type '%s'.", prop->GetPropertyName().c_str(), refl::TypeInfo<T>::Name.data()));
+
+		return Result::CreateSuccess(TPropertyAccessor<T>((PProperty<T>)prop));
+	}
+
+	INLINE sizet PropertyRegistry::GetCount() const noexcept
+	{
+		auto lck = SharedLock(m_Mutex);
+		return m_RegisteredCount;
+	}
+
+	INLINE sizet PropertyRegistry::GetIDCount() const noexcept
+	{
+		auto lck = SharedLock(m_Mutex);
+		return m_Slots.size();
+	}
+
+	INLINE TResult<PropertyRegistry::Snapshot> PropertyRegistry::TakeSnapshot() const noexcept
+	{
+		Snapshot snapshot;
+		MemoryStream stream;
+		{
+			SHAREDLOCK(m_Mutex);
+
+			int64 totalSize = 0;
+			for (const auto& slot : m_Slots)
+			{
+				if (slot.Property != nullptr)
+					totalSize += slot.Property->_GetStaticSize() + slot.Property->_GetDynamicSize();
+			}
+
+			// Values may grow between the size pass and the copy, the stream takes care of it
+			stream.Reserve((sizet)totalSize);
+			snapshot.Entries.reserve(m_RegisteredCount);
+			for (PropertyID_t id = 0; id < (PropertyID_t)m_Slots.size(); ++id)
+			{
+				const auto& prop = m_Slots[id].Property;
+				if (prop == nullptr)
+					continue;
+
+				const auto offset = stream.Tell();
+				const auto res = prop->_ValueToStream(stream);
+				if (res.HasFailed())
+					return Result::CreateFailure<Snapshot>(Format("[PropertyRegistry]::TakeSnapshot Couldn't serialize the property '%s'\n", String(m_Slots[id].Name).c_str()) + res.GetFailMessage());
+				snapshot.Entries.push_back(SnapshotEntry{ id, prop->_ValueTypeID(), (uint32)offset, (uint32)res.GetValue() });
+			}
+		}
+
+		const auto* data = stream.GetData();
+		snapshot.Data.assign(data, data + stream.Tell());
+		return Result::CreateSuccess(std::move(snapshot));
+	}
+}
@@ -0,0 +1,131 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+namespace greaper
+{
+	INLINE EmptyResult PropertyTransaction::AddChange(PIProperty prop, TResult<PPropertyChange> changeRes) noexcept
+	{
+		if (changeRes.HasFailed())
+			return Result::CopyFailure(changeRes);
+
+		for (auto& entry : m_Entries)
+		{
+			if (entry.Property == prop)
+			{
+				entry.Change = changeRes.GetValue();
+				return Result::CreateSuccess();
+			}
+		}
+		m_Entries.push_back(Entry{ std::move(prop), changeRes.GetValue() });
+		return Result::CreateSuccess();
+	}
+
+	template<class T>
+	INLINE EmptyResult PropertyTransaction::Stage(const PProperty<T>& prop, T value) noexcept
+	{
+		if (prop == nullptr)
+			return Result::CreateFailure("[PropertyTransaction]::Stage Trying to stage a value on a null property."sv);
+
+		auto change = (PPropertyChange)ConstructShared<TPropertyChange<T>>(prop.get(), std::move(value));
+		return AddChange((PIProperty)prop, Result::CreateSuccess(std::move(change)));
+	}
+
+	template<class T>
+	INLINE EmptyResult PropertyTransaction::Stage(const WProperty<T>& prop, T value) noexcept
+	{
+		return Stage(prop.lock(), std::move(value));
+	}
+
+	INLINE EmptyResult PropertyTransaction::StageFromString(const PIProperty& prop, const String& value) noexcept
+	{
+		if (prop == nullptr)
+			return Result::CreateFailure("[PropertyTransaction]::StageFromString Trying to stage a value on a null property."sv);
+
+		return AddChange(prop, prop->_CreateChangeFromString(value));
+	}
+
+	INLINE EmptyResult PropertyTransaction::StageChange(const PIProperty& prop, PPropertyChange change) noexcept
+	{
+		if (prop == nullptr || change == nullptr || change->GetProperty() != prop.get())
+			return Result::CreateFailure("[PropertyTransaction]::StageChange Trying to stage a change that does not belong to the given property."sv);
+
+		return AddChange(prop, Result::CreateSuccess(std::move(change)));
+	}
+
+	INLINE EmptyResult PropertyTransaction::StageFromJSON(const PIProperty& prop, cJSON* json) noexcept
+	{
+		if (prop == nullptr)
+			return Result::CreateFailure("[PropertyTransaction]::StageFromJSON Trying to stage a value on a null property."sv);
+
+		return AddChange(prop, prop->_CreateChangeFromJSON(json, prop->GetPropertyName()));
+	}
+
+	INLINE TResult<sizet> PropertyTransaction::Commit(bool triggerEvents) noexcept
+	{
+		Vector<Entry> entries = std::move(m_Entries);
+		m_Entries.clear();
+		if (entries.empty())
+			return Result::CreateSuccess<sizet>(0);
+
+		// Always lock in the same order to avoid deadlocks between concurrent transactions
+		std::sort(entries.begin(), entries.end(), [](const Entry& left, const Entry& right)
+			{ return left.Property.get() < right.Property.get(); });
+
+		for (auto& entry : entries)
+			entry.Change->_GetMutex().lock();
+
+		const auto unlockAll = [&entries]()
+			{
+				for (auto it = entries.rbegin(); it != entries.rend(); ++it)
+					it->Change->_GetMutex().unlock();
+			};
+
+		for (auto& entry : entries)
+		{
+			EmptyResult res = entry.Change->_Validate();
+			if (res.HasFailed())
+			{
+				unlockAll();
+				return Result::CreateFailure<sizet>("[PropertyTransaction]::Commit Nothing was applied, " + res.GetFailMessage());
+			}
+		}
+
+		Vector<IProperty*> changed;
+		changed.reserve(entries.size());
+		for (auto& entry : entries)
+		{
+			if (entry.Change->_Apply())
+				changed.push_back(entry.Property.get());
+		}
+		unlockAll();
+
+		if (!triggerEvents || changed.empty())
+			return Result::CreateSuccess(changed.size());
+
+		for (IProperty* prop : changed)
+			prop->GetOnModificationEvent().Trigger(prop);
+
+		// Group the changes by library, keeping the property order inside each group
+		std::stable_sort(changed.begin(), changed.end(), [](IProperty* left, IProperty* right)
+			{ return left->GetLibrary().lock().get() < right->GetLibrary().lock().get(); });
+
+		Vector<IProperty*> libChanges;
+		for (sizet i = 0; i < changed.size();)
+		{
+			auto lib = changed[i]->GetLibrary().lock();
+			libChanges.clear();
+			for (; i < changed.size() && changed[i]->GetLibrary().lock() == lib; ++i)
+				libChanges.push_back(changed[i]);
+
+			if (lib == nullptr)
+				continue;
+			lib->LogVerbose(Format("PropertyTransaction has changed %" PRIuPTR " properties.", libChanges.size()));
+			lib->GetOnPropertiesChangedEvent().Trigger(CreateSpan(std::as_const(libChanges)));
+		}
+		return Result::CreateSuccess(changed.size());
+	}
+}
@@ -0,0 +1,366 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef CORE_RADIX_TRIE_H
+#define CORE_RADIX_TRIE_H 1
+
+#include "../Memory.h"
+
+namespace greaper
+{
+	/**
+	 * @brief Compressed prefix tree from strings to T.
+	 * Lookups walk at most one edge per matched segment, so they are O(k) on the key
+	 * length regardless of the amount of entries. Nodes live in a single vector and are
+	 * referenced by index, erased nodes are merged with their only child when possible
+	 * and their slots reused by later insertions.
+	 * Children are kept sorted, so the enumerations visit the keys in lexicographic order.
+	 * T must be default constructible.
+	 */
+	template<class T, class _Alloc_ = GenericAllocator>
+	class RadixTrie
+	{
+		using NodeIndex_t = uint32;
+		static constexpr NodeIndex_t RootNode = 0;
+		static constexpr NodeIndex_t InvalidNode = std::numeric_limits<NodeIndex_t>::max();
+
+		struct Node
+		{
+			String Label; // Edge from the parent
+			SmallVector<NodeIndex_t, 4> Children;
+			NodeIndex_t Parent = InvalidNode;
+			bool HasValue = false;
+			T Value{};
+		};
+
+		Vector<Node> m_Nodes;
+		Vector<NodeIndex_t> m_FreeNodes;
+		sizet m_Size = 0;
+
+		static INLINE sizet CommonPrefix(StringView a, StringView b)noexcept
+		{
+			const auto count = Min(a.size(), b.size());
+			sizet i = 0;
+			while (i < count && a[i] == b[i])
+				++i;
+			return i;
+		}
+
+		NodeIndex_t AllocNode(StringView label, NodeIndex_t parent)
+		{
+			NodeIndex_t idx;
+			if (!m_FreeNodes.empty())
+			{
+				idx = m_FreeNodes.back();
+				m_FreeNodes.pop_back();
+			}
+			else
+			{
+				idx = (NodeIndex_t)m_Nodes.size();
+				m_Nodes.emplace_back();
+			}
+			auto& node = m_Nodes[idx];
+			node.Label.assign(label);
+			node.Parent = parent;
+			return idx;
+		}
+
+		void FreeNode(NodeIndex_t idx)
+		{
+			auto& node = m_Nodes[idx];
+			node.Label.clear();
+			node.Children.clear();
+			node.Parent = InvalidNode;
+			node.HasValue = false;
+			node.Value = T{};
+			m_FreeNodes.push_back(idx);
+		}
+
+		// Position where a child starting with c is or would be in the children of node
+		INLINE sizet ChildPosition(NodeIndex_t node, char c)const noexcept
+		{
+			const auto& children = m_Nodes[node].Children;
+			sizet i = 0;
+			while (i < children.size() && m_Nodes[children[i]].Label[0] < c)
+				++i;
+			return i;
+		}
+
+		INLINE NodeIndex_t FindChild(NodeIndex_t node, char c)const noexcept
+		{
+			const auto& children = m_Nodes[node].Children;
+			const auto pos = ChildPosition(node, c);
+			if (pos < children.size() && m_Nodes[children[pos]].Label[0] == c)
+				return children[pos];
+			return InvalidNode;
+		}
+
+		NodeIndex_t FindNode(StringView key)const noexcept
+		{
+			if (m_Nodes.empty())
+				return InvalidNode;
+
+			NodeIndex_t node = RootNode;
+			while (!key.empty())
+			{
+				node = FindChild(node, key[0]);
+				if (node == InvalidNode)
+					return InvalidNode;
+				const StringView label = m_Nodes[node].Label;
+				if (key.size() < label.size() || key.compare(0, label.size(), label) != 0)
+					return InvalidNode;
+				key.remove_prefix(label.size());
+			}
+			return node;
+		}
+
+		// Finds the node under which every key starting with prefix lives, path gets its full key
+		NodeIndex_t FindPrefixNode(StringView prefix, String& path)const noexcept
+		{
+			if (m_Nodes.empty())
+				return InvalidNode;
+
+			NodeIndex_t node = RootNode;
+			while (!prefix.empty())
+			{
+				node = FindChild(node, prefix[0]);
+				if (node == InvalidNode)
+					return InvalidNode;
+				const StringView label = m_Nodes[node].Label;
+				const auto common = CommonPrefix(label, prefix);
+				if (common != prefix.size() && common != label.size())
+					return InvalidNode;
+				path.append(label);
+				prefix.remove_prefix(common);
+			}
+			return node;
+		}
+
+		// Joins a node without value and a single child into one edge
+		void MergeWithChild(NodeIndex_t idx)
+		{
+			const auto childIdx = m_Nodes[idx].Children[0];
+			auto& child = m_Nodes[childIdx];
+			child.Label.insert(0, m_Nodes[idx].Label);
+			child.Parent = m_Nodes[idx].Parent;
+			auto& siblings = m_Nodes[child.Parent].Children;
+			*std::find(siblings.begin(), siblings.end(), idx) = childIdx;
+			FreeNode(idx);
+		}
+
+		template<class F>
+		void VisitSubtree(NodeIndex_t idx, String& path, F& fn)const
+		{
+			const auto& node = m_Nodes[idx];
+			if (node.HasValue)
+				fn(StringView{ path }, node.Value);
+			for (const auto childIdx : node.Children)
+			{
+				const auto prevSize = path.size();
+				path.append(m_Nodes[childIdx].Label);
+				VisitSubtree(childIdx, path, fn);
+				path.resize(prevSize);
+			}
+		}
+
+		// Levenshtein walk, row holds the distances of key against the current path
+		template<class F>
+		void VisitSimilar(NodeIndex_t idx, StringView key, const SmallVector<sizet, 32>& parentRow, String& path, sizet maxDistance, F& fn)const
+		{
+			const auto& node = m_Nodes[idx];
+			SmallVector<sizet, 32> row = parentRow;
+			SmallVector<sizet, 32> prevRow;
+			for (const char c : node.Label)
+			{
+				prevRow.swap(row);
+				row.resize(key.size() + 1);
+				row[0] = prevRow[0] + 1;
+				sizet rowMin = row[0];
+				for (sizet i = 1; i <= key.size(); ++i)
+				{
+					const sizet cost = key[i - 1] == c ? 0 : 1;
+					row[i] = Min(Min(row[i - 1] + 1, prevRow[i] + 1), prevRow[i - 1] + cost);
+					rowMin = Min(rowMin, row[i]);
+				}
+				if (rowMin > maxDistance)
+					return; // Every key below is further away
+			}
+
+			const auto prevSize = path.size();
+			path.append(node.Label);
+			if (node.HasValue && row[key.size()] <= maxDistance)
+				fn(StringView{ path }, node.Value, row[key.size()]);
+			for (const auto childIdx : node.Children)
+				VisitSimilar(childIdx, key, row, path, maxDistance, fn);
+			path.resize(prevSize);
+		}
+
+	public:
+		RadixTrie()noexcept = default;
+
+		// Returns false if the key was already present, its value is left untouched
+		bool Insert(StringView key, T value)
+		{
+			if (m_Nodes.empty())
+				m_Nodes.emplace_back(); // Root, keeps the empty key
+
+			NodeIndex_t node = RootNode;
+			while (!key.empty())
+			{
+				const auto pos = ChildPosition(node, key[0]);
+				const auto& children = m_Nodes[node].Children;
+				if (pos >= children.size() || m_Nodes[children[pos]].Label[0] != key[0])
+				{
+					const auto newIdx = AllocNode(key, node);
+					auto& newNode = m_Nodes[newIdx];
+					newNode.HasValue = true;
+					newNode.Value = std::move(value);
+					auto& parentChildren = m_Nodes[node].Children;
+					parentChildren.insert(parentChildren.begin() + pos, newIdx);
+					++m_Size;
+					return true;
+				}
+
+				const auto childIdx = children[pos];
+				const auto common = CommonPrefix(m_Nodes[childIdx].Label, key);
+				if (common < m_Nodes[childIdx].Label.size())
+				{
+					// Split the edge, the new node takes the shared part
+					const auto midIdx = AllocNode(key.substr(0, common), node);
+					m_Nodes[node].Children[pos] = midIdx;
+					auto& child = m_Nodes[childIdx];
+					child.Label.erase(0, common);
+					child.Parent = midIdx;
+					m_Nodes[midIdx].Children.push_back(childIdx);
+				}
+				node = m_Nodes[node].Children[pos];
+				key.remove_prefix(common);
+			}
+
+			auto& target = m_Nodes[node];
+			if (target.HasValue)
+				return false;
+			target.HasValue = true;
+			target.Value = std::move(value);
+			++m_Size;
+			return true;
+		}
+
+		// Returns false if the key was not present
+		bool Erase(StringView key)
+		{
+			auto idx = FindNode(key);
+			if (idx == InvalidNode || !m_Nodes[idx].HasValue)
+				return false;
+
+			auto& node = m_Nodes[idx];
+			node.HasValue = false;
+			node.Value = T{};
+			--m_Size;
+
+			if (idx == RootNode)
+				return true;
+
+			if (node.Children.size() == 1)
+			{
+				MergeWithChild(idx);
+				return true;
+			}
+			if (!node.Children.empty())
+				return true;
+
+			const auto parentIdx = node.Parent;
+			auto& siblings = m_Nodes[parentIdx].Children;
+			siblings.erase(std::find(siblings.begin(), siblings.end(), idx));
+			FreeNode(idx);
+
+			const auto& parent = m_Nodes[parentIdx];
+			if (parentIdx != RootNode && !parent.HasValue && parent.Children.size() == 1)
+				MergeWithChild(parentIdx);
+			return true;
+		}
+
+		NODISCARD T* Find(StringView key)noexcept
+		{
+			const auto idx = FindNode(key);
+			return idx != InvalidNode && m_Nodes[idx].HasValue ? &m_Nodes[idx].Value : nullptr;
+		}
+
+		NODISCARD const T* Find(StringView key)const noexcept
+		{
+			const auto idx = FindNode(key);
+			return idx != InvalidNode && m_Nodes[idx].HasValue ? &m_Nodes[idx].Value : nullptr;
+		}
+
+		NODISCARD INLINE bool Contains(StringView key)const noexcept { return Find(key) != nullptr; }
+
+		// Calls fn(StringView key, const T& value) for every key starting with prefix
+		template<class F>
+		void ForEachWithPrefix(StringView prefix, F fn)const
+		{
+			String path;
+			const auto idx = FindPrefixNode(prefix, path);
+			if (idx != InvalidNode)
+				VisitSubtree(idx, path, fn);
+		}
+
+		/**
+		 * @brief Extends prefix as far as it is shared by every key that starts with it,
+		 * what a console would autocomplete. Returns prefix as is if no key starts with it.
+		 */
+		NODISCARD String GetCompletion(StringView prefix)const
+		{
+			String path;
+			auto idx = FindPrefixNode(prefix, path);
+			if (idx == InvalidNode)
+				return String(prefix);
+
+			while (!m_Nodes[idx].HasValue && m_Nodes[idx].Children.size() == 1)
+			{
+				idx = m_Nodes[idx].Children[0];
+				path.append(m_Nodes[idx].Label);
+			}
+			return path;
+		}
+
+		// Calls fn(StringView key, const T& value, sizet distance) for every key within maxDistance edits of key
+		template<class F>
+		void ForEachSimilar(StringView key, sizet maxDistance, F fn)const
+		{
+			if (m_Nodes.empty())
+				return;
+
+			SmallVector<sizet, 32> row;
+			row.resize(key.size() + 1);
+			for (sizet i = 0; i < row.size(); ++i)
+				row[i] = i;
+
+			String path;
+			const auto& root = m_Nodes[RootNode];
+			if (root.HasValue && key.size() <= maxDistance)
+				fn(StringView{ path }, root.Value, key.size());
+			for (const auto childIdx : root.Children)
+				VisitSimilar(childIdx, key, row, path, maxDistance, fn);
+		}
+
+		NODISCARD INLINE sizet size()const noexcept { return m_Size; }
+
+		NODISCARD INLINE bool empty()const noexcept { return m_Size == 0; }
+
+		// Nodes alive, including the ones used for shared prefixes
+		NODISCARD INLINE sizet GetNodeCount()const noexcept { return m_Nodes.size() - m_FreeNodes.size(); }
+
+		void clear()noexcept
+		{
+			m_Nodes.clear();
+			m_FreeNodes.clear();
+			m_Size = 0;
+		}
+	};
+}
+
+#endif /* CORE_RADIX_TRIE_H */
@@ -49,6 +49,10 @@ namespace greaper::refl
 	template<typename K, typename V, typename H, typename C, typename A> struct TypeInfo<UnorderedMap<K, V, H, C, A>> { static constexpr ReflectedTypeID_t ID = RTI_UnorderedMap; using Type = ContainerType<UnorderedMap<K, V, H, C, A>>; static constexpr StringView Name = "unordered_map"sv; };
 	template<typename K, typename V, typename H, typename C, typename A> struct TypeInfo<UnorderedMultiMap<K, V, H, C, A>> { static constexpr ReflectedTypeID_t ID = RTI_UnorderedMultiMap; using Type = ContainerType<UnorderedMultiMap<K, V, H, C, A>>; static constexpr StringView Name = "unordered_multimap"sv; };
 	template<typename T, typename H, typename C, typename A> struct TypeInfo<UnorderedMultiSet<T, H, C, A>> { static constexpr ReflectedTypeID_t ID = RTI_UnorderedMultiSet; using Type = ContainerType<UnorderedMultiSet<T, H, C, A>>; static constexpr StringView Name = "unordered_multiset"sv; };
+	template<typename K, typename V, typename H, typename E, typename A> struct TypeInfo<FlatMap<K, V, H, E, A>> { static constexpr ReflectedTypeID_t ID = RTI_FlatMap; using Type = ContainerType<FlatMap<K, V, H, E, A>>; static constexpr StringView Name = "flat_map"sv; };
+	template<typename K, typename H, typename E, typename A> struct TypeInfo<FlatSet<K, H, E, A>> { static constexpr ReflectedTypeID_t ID = RTI_FlatSet; using Type = ContainerType<FlatSet<K, H, E, A>>; static constexpr StringView Name = "flat_set"sv; };
+	template<typename T, sizet N, typename A> struct TypeInfo<SmallVector<T, N, A>> { static constexpr ReflectedTypeID_t ID = RTI_SmallVector; using Type = ContainerType<SmallVector<T, N, A>>; static constexpr StringView Name = "small_vector"sv; };
+	template<typename T, sizet N> struct TypeInfo<StaticVector<T, N>> { static constexpr ReflectedTypeID_t ID = RTI_StaticVector; using Type = ContainerType<StaticVector<T, N>>; static constexpr StringView Name = "static_vector"sv; };
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,605 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef CORE_SMALLVECTOR_H
+#define CORE_SMALLVECTOR_H 1
+
+#include <cstddef>
+
+namespace greaper
+{
+	namespace Impl
+	{
+		/**
+		 * @brief Vector operations over a buffer owned by Derived, which provides Grow(minCapacity).
+		 * Iterators are plain pointers, and are invalidated like the ones of std::vector.
+		 */
+		template<class T, class Derived>
+		class InlineVectorBase
+		{
+		public:
+			using value_type = T;
+			using size_type = sizet;
+			using difference_type = std::ptrdiff_t;
+			using reference = T&;
+			using const_reference = const T&;
+			using pointer = T*;
+			using const_pointer = const T*;
+			using iterator = T*;
+			using const_iterator = const T*;
+			using reverse_iterator = std::reverse_iterator<iterator>;
+			using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		protected:
+			T* m_Data;
+			sizet m_Size = 0;
+			sizet m_Capacity;
+
+			INLINE InlineVectorBase(T* data, sizet capacity)noexcept
+				:m_Data(data)
+				,m_Capacity(capacity)
+			{
+
+			}
+
+			InlineVectorBase(const InlineVectorBase&) = delete;
+			InlineVectorBase& operator=(const InlineVectorBase&) = delete;
+
+			INLINE void EnsureCapacity(sizet count)
+			{
+				if (count > m_Capacity)
+					static_cast<Derived*>(this)->Grow(count);
+			}
+
+			// Moves [first, last) into uninitialized memory at dst and destroys the source
+			static void RelocateRange(T* dst, T* first, T* last)noexcept
+			{
+				if constexpr (std::is_trivially_copyable_v<T>)
+				{
+					if (first != last)
+						memcpy((void*)dst, (const void*)first, (sizet)(last - first) * sizeof(T));
+				}
+				else
+				{
+					for (; first != last; ++first, ++dst)
+					{
+						new(dst) T(std::move(*first));
+						first->~T();
+					}
+				}
+			}
+
+			static INLINE void DestroyRange(T* first, T* last)noexcept
+			{
+				if constexpr (!std::is_trivially_destructible_v<T>)
+				{
+					for (; first != last; ++first)
+						first->~T();
+				}
+			}
+
+		public:
+			NODISCARD INLINE iterator begin()noexcept { return m_Data; }
+			NODISCARD INLINE const_iterator begin()const noexcept { return m_Data; }
+			NODISCARD INLINE const_iterator cbegin()const noexcept { return m_Data; }
+			NODISCARD INLINE iterator end()noexcept { return m_Data + m_Size; }
+			NODISCARD INLINE const_iterator end()const noexcept { return m_Data + m_Size; }
+			NODISCARD INLINE const_iterator cend()const noexcept { return m_Data + m_Size; }
+			NODISCARD INLINE reverse_iterator rbegin()noexcept { return reverse_iterator(end()); }
+			NODISCARD INLINE const_reverse_iterator rbegin()const noexcept { return const_reverse_iterator(end()); }
+			NODISCARD INLINE reverse_iterator rend()noexcept { return reverse_iterator(begin()); }
+			NODISCARD INLINE const_reverse_iterator rend()const noexcept { return const_reverse_iterator(begin()); }
+
+			NODISCARD INLINE sizet size()const noexcept { return m_Size; }
+			NODISCARD INLINE sizet capacity()const noexcept { return m_Capacity; }
+			NODISCARD INLINE bool empty()const noexcept { return m_Size == 0; }
+			NODISCARD INLINE T* data()noexcept { return m_Data; }
+			NODISCARD INLINE const T* data()const noexcept { return m_Data; }
+
+			NODISCARD INLINE T& operator[](sizet index)noexcept { return m_Data[index]; }
+			NODISCARD INLINE const T& operator[](sizet index)const noexcept { return m_Data[index]; }
+
+			NODISCARD INLINE T& at(sizet index)noexcept
+			{
+				VerifyLess(index, m_Size, "Trying to access an element outside of the vector, index: %" PRIuPTR " size: %" PRIuPTR ".", index, m_Size);
+				return m_Data[index];
+			}
+			NODISCARD INLINE const T& at(sizet index)const noexcept
+			{
+				VerifyLess(index, m_Size, "Trying to access an element outside of the vector, index: %" PRIuPTR " size: %" PRIuPTR ".", index, m_Size);
+				return m_Data[index];
+			}
+
+			NODISCARD INLINE T& front()noexcept { return m_Data[0]; }
+			NODISCARD INLINE const T& front()const noexcept { return m_Data[0]; }
+			NODISCARD INLINE T& back()noexcept { return m_Data[m_Size - 1]; }
+			NODISCARD INLINE const T& back()const noexcept { return m_Data[m_Size - 1]; }
+
+			INLINE void reserve(sizet count)
+			{
+				EnsureCapacity(count);
+			}
+
+			template<class... Args>
+			T& emplace_back(Args&&... args)
+			{
+				if (m_Size == m_Capacity)
+				{
+					// args may reference an element of this vector, build the value before moving the buffer
+					T tmp(std::forward<Args>(args)...);
+					EnsureCapacity(m_Size + 1);
+					new(m_Data + m_Size) T(std::move(tmp));
+				}
+				else
+				{
+					new(m_Data + m_Size) T(std::forward<Args>(args)...);
+				}
+				return m_Data[m_Size++];
+			}
+
+			INLINE void push_back(const T& value) { emplace_back(value); }
+			INLINE void push_back(T&& value) { emplace_back(std::move(value)); }
+
+			INLINE void pop_back()noexcept
+			{
+				m_Data[--m_Size].~T();
+			}
+
+			void clear()noexcept
+			{
+				DestroyRange(m_Data, m_Data + m_Size);
+				m_Size = 0;
+			}
+
+			void resize(sizet count)
+			{
+				if (count < m_Size)
+				{
+					DestroyRange(m_Data + count, m_Data + m_Size);
+					m_Size = count;
+					return;
+				}
+				EnsureCapacity(count);
+				for (; m_Size < count; ++m_Size)
+					new(m_Data + m_Size) T();
+			}
+
+			void resize(sizet count, const T& value)
+			{
+				if (count < m_Size)
+				{
+					DestroyRange(m_Data + count, m_Data + m_Size);
+					m_Size = count;
+					return;
+				}
+				if (count > m_Capacity)
+				{
+					T tmp(value);
+					EnsureCapacity(count);
+					for (; m_Size < count; ++m_Size)
+						new(m_Data + m_Size) T(tmp);
+					return;
+				}
+				for (; m_Size < count; ++m_Size)
+					new(m_Data + m_Size) T(value);
+			}
+
+			template<class... Args>
+			iterator emplace(const_iterator pos, Args&&... args)
+			{
+				const auto index = (sizet)(pos - m_Data);
+				if (index == m_Size)
+				{
+					emplace_back(std::forward<Args>(args)...);
+					return m_Data + index;
+				}
+				T tmp(std::forward<Args>(args)...);
+				EnsureCapacity(m_Size + 1);
+				new(m_Data + m_Size) T(std::move(m_Data[m_Size - 1]));
+				std::move_backward(m_Data + index, m_Data + m_Size - 1, m_Data + m_Size);
+				m_Data[index] = std::move(tmp);
+				++m_Size;
+				return m_Data + index;
+			}
+
+			INLINE iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+			INLINE iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+			// The range must not come from this vector
+			template<class It, class = typename std::iterator_traits<It>::iterator_category>
+			iterator insert(const_iterator pos, It first, It last)
+			{
+				const auto index = (sizet)(pos - m_Data);
+				const auto oldSize = m_Size;
+				if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>)
+					EnsureCapacity(m_Size + (sizet)std::distance(first, last));
+				for (; first != last; ++first)
+					emplace_back(*first);
+				std::rotate(m_Data + index, m_Data + oldSize, m_Data + m_Size);
+				return m_Data + index;
+			}
+
+			INLINE iterator insert(const_iterator pos, std::initializer_list<T> init)
+			{
+				return insert(pos, init.begin(), init.end());
+			}
+
+			iterator erase(const_iterator pos)noexcept
+			{
+				auto* it = m_Data + (pos - m_Data);
+				std::move(it + 1, m_Data + m_Size, it);
+				pop_back();
+				return it;
+			}
+
+			iterator erase(const_iterator first, const_iterator last)noexcept
+			{
+				auto* dst = m_Data + (first - m_Data);
+				if (first == last)
+					return dst;
+				auto* newEnd = std::move(m_Data + (last - m_Data), m_Data + m_Size, dst);
+				DestroyRange(newEnd, m_Data + m_Size);
+				m_Size = (sizet)(newEnd - m_Data);
+				return dst;
+			}
+
+			template<class It, class = typename std::iterator_traits<It>::iterator_category>
+			void assign(It first, It last)
+			{
+				clear();
+				insert(end(), first, last);
+			}
+
+			void assign(sizet count, const T& value)
+			{
+				clear();
+				resize(count, value);
+			}
+
+			INLINE void assign(std::initializer_list<T> init)
+			{
+				assign(init.begin(), init.end());
+			}
+
+			// Removes the element by moving the last one into its place, does not keep the order
+			void erase_unordered(const_iterator pos)noexcept
+			{
+				auto* it = m_Data + (pos - m_Data);
+				if (it != m_Data + m_Size - 1)
+					*it = std::move(m_Data[m_Size - 1]);
+				pop_back();
+			}
+		};
+
+		template<class T, class D1, class D2>
+		NODISCARD INLINE bool operator==(const InlineVectorBase<T, D1>& left, const InlineVectorBase<T, D2>& right)
+		{
+			return left.size() == right.size() && std::equal(left.begin(), left.end(), right.begin());
+		}
+
+		template<class T, class D1, class D2>
+		NODISCARD INLINE bool operator!=(const InlineVectorBase<T, D1>& left, const InlineVectorBase<T, D2>& right)
+		{
+			return !(left == right);
+		}
+
+		template<class T, class D1, class D2>
+		NODISCARD INLINE bool operator<(const InlineVectorBase<T, D1>& left, const InlineVectorBase<T, D2>& right)
+		{
+			return std::lexicographical_compare(left.begin(), left.end(), right.begin(), right.end());
+		}
+	}
+
+	/**
+	 * @brief Vector with room for N elements inside of itself, once it needs more it moves to
+	 * a heap buffer obtained from _Alloc_ and behaves like a regular vector from then on.
+	 * Meant for the many small vectors that rarely hold more than a handful of elements.
+	 */
+	template<class T, sizet N, class _Alloc_ = GenericAllocator>
+	class SmallVector : public Impl::InlineVectorBase<T, SmallVector<T, N, _Alloc_>>
+	{
+		static_assert(N > 0, "SmallVector needs at least one inline element, use Vector otherwise.");
+
+		using Base = Impl::InlineVectorBase<T, SmallVector<T, N, _Alloc_>>;
+		friend Base;
+
+		alignas(T) uint8 m_Inline[N * sizeof(T)];
+
+		NODISCARD INLINE T* InlineData()noexcept { return reinterpret_cast<T*>(m_Inline); }
+		NODISCARD INLINE const T* InlineData()const noexcept { return reinterpret_cast<const T*>(m_Inline); }
+
+		NODISCARD static INLINE T* AllocBuffer(sizet count)
+		{
+			if constexpr (alignof(T) > alignof(std::max_align_t))
+				return AllocAlignedN<T, _Alloc_>(count, alignof(T));
+			else
+				return AllocN<T, _Alloc_>(count);
+		}
+
+		static INLINE void FreeBuffer(T* buffer)noexcept
+		{
+			if constexpr (alignof(T) > alignof(std::max_align_t))
+				DeallocAligned<_Alloc_>(buffer);
+			else
+				Dealloc<_Alloc_>(buffer);
+		}
+
+		void Grow(sizet minCapacity)
+		{
+			const auto newCapacity = Max(minCapacity, this->m_Capacity * 2);
+			auto* buffer = AllocBuffer(newCapacity);
+			Base::RelocateRange(buffer, this->m_Data, this->m_Data + this->m_Size);
+			if (!IsInline())
+				FreeBuffer(this->m_Data);
+			this->m_Data = buffer;
+			this->m_Capacity = newCapacity;
+		}
+
+		// Takes the elements of other, which is left empty
+		void MoveFrom(SmallVector& other)noexcept
+		{
+			if (other.IsInline())
+			{
+				Base::RelocateRange(this->m_Data, other.m_Data, other.m_Data + other.m_Size);
+				this->m_Size = other.m_Size;
+			}
+			else
+			{
+				this->m_Data = other.m_Data;
+				this->m_Size = other.m_Size;
+				this->m_Capacity = other.m_Capacity;
+				other.m_Data = other.InlineData();
+				other.m_Capacity = N;
+			}
+			other.m_Size = 0;
+		}
+
+	public:
+		static constexpr sizet InlineCapacity = N;
+
+		INLINE SmallVector()noexcept
+			:Base(InlineData(), N)
+		{
+
+		}
+
+		explicit SmallVector(sizet count, const T& value = T())
+			:Base(InlineData(), N)
+		{
+			this->resize(count, value);
+		}
+
+		SmallVector(std::initializer_list<T> init)
+			:Base(InlineData(), N)
+		{
+			this->insert(this->end(), init.begin(), init.end());
+		}
+
+		template<class It, class = typename std::iterator_traits<It>::iterator_category>
+		SmallVector(It first, It last)
+			:Base(InlineData(), N)
+		{
+			this->insert(this->end(), first, last);
+		}
+
+		explicit SmallVector(const CSpan<T>& span)
+			:Base(InlineData(), N)
+		{
+			this->reserve(span.GetSizeFn());
+			for (const auto& elem : span)
+				this->emplace_back(elem);
+		}
+
+		SmallVector(const SmallVector& other)
+			:Base(InlineData(), N)
+		{
+			this->insert(this->end(), other.begin(), other.end());
+		}
+
+		SmallVector(SmallVector&& other)noexcept
+			:Base(InlineData(), N)
+		{
+			MoveFrom(other);
+		}
+
+		SmallVector& operator=(const SmallVector& other)
+		{
+			if (this != &other)
+				this->assign(other.begin(), other.end());
+			return *this;
+		}
+
+		SmallVector& operator=(SmallVector&& other)noexcept
+		{
+			if (this != &other)
+			{
+				this->clear();
+				if (!other.IsInline() || this->m_Capacity < other.m_Size)
+				{
+					if (!IsInline())
+						FreeBuffer(this->m_Data);
+					this->m_Data = InlineData();
+					this->m_Capacity = N;
+				}
+				MoveFrom(other);
+			}
+			return *this;
+		}
+
+		SmallVector& operator=(std::initializer_list<T> init)
+		{
+			this->assign(init.begin(), init.end());
+			return *this;
+		}
+
+		~SmallVector()noexcept
+		{
+			this->clear();
+			if (!IsInline())
+				FreeBuffer(this->m_Data);
+		}
+
+		// Whether the elements are still stored inside of the vector
+		NODISCARD INLINE bool IsInline()const noexcept { return this->m_Data == InlineData(); }
+
+		// Moves the elements back to the inline storage if they fit
+		void shrink_to_fit()noexcept
+		{
+			if (IsInline() || this->m_Size > N)
+				return;
+			auto* buffer = this->m_Data;
+			Base::RelocateRange(InlineData(), buffer, buffer + this->m_Size);
+			FreeBuffer(buffer);
+			this->m_Data = InlineData();
+			this->m_Capacity = N;
+		}
+
+		void swap(SmallVector& other)noexcept
+		{
+			SmallVector tmp(std::move(other));
+			other = std::move(*this);
+			*this = std::move(tmp);
+		}
+	};
+
+	/**
+	 * @brief Vector that never allocates, it holds up to N elements inside of itself.
+	 * Going over N is a programming error and breaks.
+	 */
+	template<class T, sizet N>
+	class StaticVector : public Impl::InlineVectorBase<T, StaticVector<T, N>>
+	{
+		static_assert(N > 0, "StaticVector needs a capacity of at least one element.");
+
+		using Base = Impl::InlineVectorBase<T, StaticVector<T, N>>;
+		friend Base;
+
+		alignas(T) uint8 m_Inline[N * sizeof(T)];
+
+		NODISCARD INLINE T* InlineData()noexcept { return reinterpret_cast<T*>(m_Inline); }
+
+		void Grow(sizet minCapacity)
+		{
+			Break("Trying to store %" PRIuPTR " elements on a StaticVector with capacity for %" PRIuPTR ".", minCapacity, N);
+		}
+
+	public:
+		static constexpr sizet InlineCapacity = N;
+
+		INLINE StaticVector()noexcept
+			:Base(InlineData(), N)
+		{
+
+		}
+
+		explicit StaticVector(sizet count, const T& value = T())
+			:Base(InlineData(), N)
+		{
+			this->resize(count, value);
+		}
+
+		StaticVector(std::initializer_list<T> init)
+			:Base(InlineData(), N)
+		{
+			this->insert(this->end(), init.begin(), init.end());
+		}
+
+		template<class It, class = typename std::iterator_traits<It>::iterator_category>
+		StaticVector(It first, It last)
+			:Base(InlineData(), N)
+		{
+			this->insert(this->end(), first, last);
+		}
+
+		explicit StaticVector(const CSpan<T>& span)
+			:Base(InlineData(), N)
+		{
+			this->reserve(span.GetSizeFn());
+			for (const auto& elem : span)
+				this->emplace_back(elem);
+		}
+
+		StaticVector(const StaticVector& other)
+			:Base(InlineData(), N)
+		{
+			this->insert(this->end(), other.begin(), other.end());
+		}
+
+		StaticVector(StaticVector&& other)noexcept
+			:Base(InlineData(), N)
+		{
+			Base::RelocateRange(this->m_Data, other.m_Data, other.m_Data + other.m_Size);
+			this->m_Size = std::exchange(other.m_Size, 0);
+		}
+
+		StaticVector& operator=(const StaticVector& other)
+		{
+			if (this != &other)
+				this->assign(other.begin(), other.end());
+			return *this;
+		}
+
+		StaticVector& operator=(StaticVector&& other)noexcept
+		{
+			if (this != &other)
+			{
+				this->clear();
+				Base::RelocateRange(this->m_Data, other.m_Data, other.m_Data + other.m_Size);
+				this->m_Size = std::exchange(other.m_Size, 0);
+			}
+			return *this;
+		}
+
+		StaticVector& operator=(std::initializer_list<T> init)
+		{
+			this->assign(init.begin(), init.end());
+			return *this;
+		}
+
+		~StaticVector()noexcept
+		{
+			this->clear();
+		}
+
+		NODISCARD static constexpr sizet max_size()noexcept { return N; }
+
+		NODISCARD INLINE bool full()const noexcept { return this->m_Size == N; }
+
+		void swap(StaticVector& other)noexcept
+		{
+			StaticVector tmp(std::move(other));
+			other = std::move(*this);
+			*this = std::move(tmp);
+		}
+	};
+
+	template<class T, sizet N, class _Alloc_>
+	inline Span<T> CreateSpan(SmallVector<T, N, _Alloc_>& vec)noexcept
+	{
+		return Span<T>([&vec]() { return vec.size(); }, [&vec](std::size_t idx) -> T& { return vec.at(idx); });
+	}
+
+	template<class T, sizet N, class _Alloc_>
+	inline CSpan<T> CreateSpan(const SmallVector<T, N, _Alloc_>& vec)noexcept
+	{
+		return CSpan<T>([&vec]() { return vec.size(); }, [&vec](std::size_t idx) -> const T& { return vec.at(idx); });
+	}
+
+	template<class T, sizet N>
+	inline Span<T> CreateSpan(StaticVector<T, N>& vec)noexcept
+	{
+		return Span<T>([&vec]() { return vec.size(); }, [&vec](std::size_t idx) -> T& { return vec.at(idx); });
+	}
+
+	template<class T, sizet N>
+	inline CSpan<T> CreateSpan(const StaticVector<T, N>& vec)noexcept
+	{
+		return CSpan<T>([&vec]() { return vec.size(); }, [&vec](std::size_t idx) -> const T& { return vec.at(idx); });
+	}
+}
+
+#endif /* CORE_SMALLVECTOR_H */
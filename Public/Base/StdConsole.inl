@@ -0,0 +1,336 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+namespace greaper
+{
+	template<class _Alloc_>
+	INLINE TResult<SPtr<StdConsole>> StdConsole::Create(WThreadManager threadMgr, WPtr<ICommandManager> commandMgr) noexcept
+	{
+		auto* ptr = AllocT<StdConsole, _Alloc_>();
+		new ((void*)ptr)StdConsole(std::move(commandMgr));
+		auto console = SPtr<StdConsole>((StdConsole*)ptr, &Impl::DefaultDeleter<StdConsole, _Alloc_>);
+		EmptyResult res = console->Start(std::move(threadMgr));
+		if (res.HasFailed())
+			return Result::CopyFailure<SPtr<StdConsole>>(res);
+		return Result::CreateSuccess(console);
+	}
+
+	INLINE StdConsole::StdConsole(WPtr<ICommandManager> commandMgr) noexcept
+		:m_CommandManager(std::move(commandMgr))
+		,m_Running(false)
+		,m_ConsoleEvent("StdConsole"sv)
+	{
+
+	}
+
+	INLINE StdConsole::~StdConsole() noexcept
+	{
+		Stop();
+		// Stopped from its own thread, it still has to be joined
+		if (m_Thread != nullptr && m_Thread->GetID() != CUR_THID() && m_Thread->Joinable())
+			m_Thread->Join();
+		m_Thread.reset();
+		// Closed once nothing can Wake it anymore, the writers may still be running until now
+		m_IO.Close();
+	}
+
+	INLINE EmptyResult StdConsole::Start(WThreadManager threadMgr) noexcept
+	{
+		if (threadMgr.expired())
+			return Result::CreateFailure("Trying to start a StdConsole, but the ThreadManager has expired."sv);
+
+		EmptyResult res = m_IO.Open();
+		if (res.HasFailed())
+			return res;
+
+		m_Running.store(true, std::memory_order_release);
+		ThreadConfig cfg;
+		cfg.Name = "StdConsole"sv;
+		cfg.ThreadFN = [this]() { Run(); };
+		auto thRes = threadMgr.lock()->CreateThread(cfg);
+		if (thRes.HasFailed())
+		{
+			m_Running.store(false, std::memory_order_release);
+			m_IO.Close();
+			return Result::CopyFailure(thRes);
+		}
+		m_Thread = thRes.GetValue();
+		return Result::CreateSuccess();
+	}
+
+	INLINE void StdConsole::Stop() noexcept
+	{
+		if (!m_Running.exchange(false, std::memory_order_acq_rel))
+			return;
+
+		// From the console thread, ie. a ConsoleEvent handler, it leaves its loop once the handler returns
+		if (m_Thread != nullptr && m_Thread->GetID() != CUR_THID())
+		{
+			m_IO.Wake();
+			if (m_Thread->Joinable())
+				m_Thread->Join();
+			m_Thread.reset();
+		}
+
+		// Nothing will be read anymore, the waiting futures get an empty line
+		LOCK(m_ReadMutex);
+		for (auto& request : m_ReadRequests)
+			request.set_value(String{});
+		m_ReadRequests.clear();
+	}
+
+	NODISCARD INLINE bool StdConsole::IsRunning() const noexcept
+	{
+		return m_Running.load(std::memory_order_acquire);
+	}
+
+	INLINE void StdConsole::WriteToConsole(const String& msg) noexcept
+	{
+		bool wake;
+		{
+			LOCK(m_OutputMutex);
+			const auto pending = m_Output.size() - m_OutputOffset;
+			if (pending + msg.size() > MaxBufferedOutput)
+			{
+				m_DroppedOutput += msg.size();
+				return;
+			}
+			wake = pending == 0;
+			m_Output.append(msg);
+		}
+		// The console thread only waits for stdout while it has something to write
+		if (wake)
+			m_IO.Wake();
+	}
+
+	INLINE std::future<String> StdConsole::ReadFromConsole() noexcept
+	{
+		LOCK(m_ReadMutex);
+		auto& request = m_ReadRequests.emplace_back();
+		if (!IsRunning())
+		{
+			request.set_value(String{});
+			auto future = request.get_future();
+			m_ReadRequests.pop_back();
+			return future;
+		}
+		return request.get_future();
+	}
+
+	INLINE void StdConsole::SetCursorPosition(std::pair<int16, int16> position) noexcept
+	{
+		{
+			LOCK(m_OutputMutex);
+			m_CursorPosition = position;
+		}
+		WriteToConsole(Format("\x1b[%d;%dH", position.second + 1, position.first + 1));
+	}
+
+	INLINE std::pair<int16, int16> StdConsole::GetCursorPosition() noexcept
+	{
+		LOCK(m_OutputMutex);
+		return m_CursorPosition;
+	}
+
+	NODISCARD INLINE sizet StdConsole::GetDroppedOutput() const noexcept
+	{
+		LOCK(m_OutputMutex);
+		return m_DroppedOutput;
+	}
+
+	NODISCARD INLINE bool StdConsole::HasPendingOutput() const noexcept
+	{
+		LOCK(m_OutputMutex);
+		return m_Output.size() > m_OutputOffset || m_DroppedOutput != m_ReportedDroppedOutput;
+	}
+
+	INLINE void StdConsole::Run() noexcept
+	{
+		using Clock_t = std::chrono::steady_clock;
+		// Time to wait for the rate limit to allow another write
+		static constexpr int32 RefillWaitMS = (int32)((1000 * OSConsoleIO::MaxAtomicWrite + OutputBytesPerSecond - 1) / OutputBytesPerSecond);
+		static constexpr int32 PendingCommandsPollMS = 50;
+
+		sizet outputBudget = OutputBurstSize;
+		auto lastRefill = Clock_t::now();
+		while (m_Running.load(std::memory_order_acquire))
+		{
+			const auto now = Clock_t::now();
+			const auto elapsedUS = std::chrono::duration_cast<std::chrono::microseconds>(now - lastRefill).count();
+			const auto refill = (sizet)elapsedUS * OutputBytesPerSecond / 1000000;
+			if (refill > 0)
+			{
+				outputBudget = Min(outputBudget + refill, OutputBurstSize);
+				lastRefill = now;
+			}
+
+			const bool pendingOutput = HasPendingOutput();
+			const bool wantWrite = pendingOutput && outputBudget > 0;
+			int32 timeoutMS = -1;
+			if (pendingOutput && !wantWrite)
+				timeoutMS = RefillWaitMS;
+			if (!m_PendingCommands.empty())
+				timeoutMS = timeoutMS < 0 ? PendingCommandsPollMS : Min(timeoutMS, PendingCommandsPollMS);
+
+			bool readable, writable;
+			EmptyResult res = m_IO.Wait(wantWrite, timeoutMS, readable, writable);
+			if (res.HasFailed())
+				break;
+
+			if (readable)
+				ProcessInput();
+			if (writable)
+				outputBudget -= FlushOutput(outputBudget);
+			CollectFinishedCommands();
+		}
+	}
+
+	INLINE void StdConsole::ProcessInput() noexcept
+	{
+		const auto scanStart = m_InputSize;
+		const auto ret = m_IO.Read(m_Input + m_InputSize, InputBufferSize - m_InputSize);
+		if (ret <= 0)
+		{
+			// stdin was closed, the last line may lack its line break
+			if (ret == 0 && m_InputSize > 0 && !m_DiscardingLine)
+				HandleLine(StringView{ m_Input, m_InputSize });
+			if (ret == 0)
+				m_InputSize = 0;
+			return;
+		}
+		m_InputSize += (sizet)ret;
+
+		sizet lineStart = 0;
+		const char* searchFrom = m_Input + scanStart;
+		const char* end = m_Input + m_InputSize;
+		while (const auto* lineEnd = (const char*)memchr(searchFrom, '\n', end - searchFrom))
+		{
+			const auto lineEndPos = (sizet)(lineEnd - m_Input);
+			if (m_DiscardingLine)
+				m_DiscardingLine = false;
+			else
+				HandleLine(StringView{ m_Input + lineStart, lineEndPos - lineStart });
+			lineStart = lineEndPos + 1;
+			searchFrom = lineEnd + 1;
+		}
+
+		if (lineStart == 0 && m_InputSize == InputBufferSize)
+		{
+			// A line that doesn't fit in the buffer is skipped until its end
+			if (!m_DiscardingLine)
+				WriteToConsole(Format("Console line longer than %" PRIuPTR " bytes, discarded.\n", InputBufferSize));
+			m_DiscardingLine = true;
+			m_InputSize = 0;
+			return;
+		}
+
+		m_InputSize -= lineStart;
+		if (m_InputSize > 0 && lineStart > 0)
+			memmove(m_Input, m_Input + lineStart, m_InputSize);
+	}
+
+	INLINE void StdConsole::HandleLine(StringView line) noexcept
+	{
+		const auto first = line.find_first_not_of(" \t\r");
+		if (first == StringView::npos)
+			return;
+		line = line.substr(first, line.find_last_not_of(" \t\r") - first + 1);
+
+		m_ConsoleEvent.Trigger(String{ line });
+
+		{
+			LOCK(m_ReadMutex);
+			if (!m_ReadRequests.empty())
+			{
+				m_ReadRequests.front().set_value(String{ line });
+				m_ReadRequests.pop_front();
+				return;
+			}
+		}
+
+		SmallVector<StringView, 8> tokens;
+		for (sizet pos = 0; pos < line.size();)
+		{
+			const auto tokenEnd = Min(line.find_first_of(" \t", pos), line.size());
+			tokens.push_back(line.substr(pos, tokenEnd - pos));
+			pos = line.find_first_not_of(" \t", tokenEnd);
+			if (pos == StringView::npos)
+				break;
+		}
+
+		auto cmdMgr = m_CommandManager.lock();
+		if (cmdMgr == nullptr)
+		{
+			WriteToConsole(String{ "There's no CommandManager to run the command.\n" });
+			return;
+		}
+
+		CommandInfo info;
+		info.CommandName.assign(tokens[0]);
+		info.CommandArgs.reserve(tokens.size() - 1);
+		for (sizet i = 1; i < tokens.size(); ++i)
+			info.CommandArgs.emplace_back(tokens[i]);
+
+		String cmdName = info.CommandName;
+		m_PendingCommands.push_back(PendingCommand{ std::move(cmdName), cmdMgr->HandleCommandAsync(std::move(info)) });
+	}
+
+	INLINE void StdConsole::CollectFinishedCommands() noexcept
+	{
+		for (sizet i = 0; i < m_PendingCommands.size();)
+		{
+			auto& pending = m_PendingCommands[i];
+			if (pending.Result.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			{
+				++i;
+				continue;
+			}
+
+			const auto res = pending.Result.get();
+			if (res.HasFailed())
+				WriteToConsole(Format("Command '%s' failed: %s\n", pending.CommandName.c_str(), res.GetFailMessage().c_str()));
+
+			pending = std::move(m_PendingCommands.back());
+			m_PendingCommands.pop_back();
+		}
+	}
+
+	INLINE sizet StdConsole::FlushOutput(sizet maxSize) noexcept
+	{
+		char chunk[OSConsoleIO::MaxAtomicWrite];
+		sizet size;
+		{
+			LOCK(m_OutputMutex);
+			if (m_DroppedOutput != m_ReportedDroppedOutput)
+			{
+				m_Output.append(Format("\n[Console output full, %" PRIuPTR " bytes dropped]\n", m_DroppedOutput - m_ReportedDroppedOutput));
+				m_ReportedDroppedOutput = m_DroppedOutput;
+			}
+			// The chunk is copied, so the writers can keep appending while it's written
+			size = Min(Min(m_Output.size() - m_OutputOffset, maxSize), sizeof(chunk));
+			memcpy(chunk, m_Output.data() + m_OutputOffset, size);
+		}
+
+		const auto ret = m_IO.Write(chunk, size);
+		if (ret <= 0)
+			return 0;
+
+		LOCK(m_OutputMutex);
+		m_OutputOffset += (sizet)ret;
+		if (m_OutputOffset == m_Output.size())
+		{
+			m_Output.clear();
+			m_OutputOffset = 0;
+		}
+		else if (m_OutputOffset >= MaxBufferedOutput / 2)
+		{
+			m_Output.erase(0, m_OutputOffset);
+			m_OutputOffset = 0;
+		}
+		return (sizet)ret;
+	}
+}
@@ -12,11 +12,7 @@ namespace std
 	{
 		NODISCARD INLINE size_t operator()(const greaper::String& str)const noexcept
 		{
-#if COMPILER_MSVC
-			return std::_Hash_array_representation(str.data(), str.size());
-#else
-			return std::_Hash_bytes(str.data(), str.size(), 0);
-#endif
+			return (size_t)HashBytes(str.data(), str.size() * sizeof(str[0]));
 		}
 	};
 
@@ -25,11 +21,7 @@ namespace std
 	{
 		NODISCARD INLINE size_t operator()(const greaper::WString& str)const noexcept
 		{
-#if COMPILER_MSVC
-			return std::_Hash_array_representation(str.data(), str.size());
-#else
-			return std::_Hash_bytes(str.data(), str.size(), 0);
-#endif
+			return (size_t)HashBytes(str.data(), str.size() * sizeof(str[0]));
 		}
 	};
 
@@ -38,10 +30,17 @@ namespace std
 	{
 		NODISCARD INLINE size_t operator()(const greaper::Vector<T, A>& v)const noexcept
 		{
-			size_t seed = 0;
-			for (const T& elem : v)
-				HashCombine(seed, elem);
-			return seed;
+			if constexpr (std::has_unique_object_representations_v<T>)
+			{
+				return (size_t)HashBytes(v.data(), v.size() * sizeof(T));
+			}
+			else
+			{
+				size_t seed = 0;
+				for (const T& elem : v)
+					HashCombine(seed, elem);
+				return seed;
+			}
 		}
 	};
 
@@ -50,10 +49,17 @@ namespace std
 	{
 		NODISCARD INLINE size_t operator()(const std::array<T, N>& v)const noexcept
 		{
-			size_t seed = 0;
-			for (const T& elem : v)
-				HashCombine(seed, elem);
-			return seed;
+			if constexpr (std::has_unique_object_representations_v<T>)
+			{
+				return (size_t)HashBytes(v.data(), v.size() * sizeof(T));
+			}
+			else
+			{
+				size_t seed = 0;
+				for (const T& elem : v)
+					HashCombine(seed, elem);
+				return seed;
+			}
 		}
 	};
 
@@ -0,0 +1,212 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+//#include "../ThreadLocal.h"
+
+namespace greaper
+{
+	namespace Impl
+	{
+		NODISCARD INLINE FlatMap<uint64, void*>& GetThreadLocalCache()noexcept
+		{
+			static thread_local FlatMap<uint64, void*> cache;
+			return cache;
+		}
+
+		NODISCARD INLINE uint64 NextThreadLocalKey()noexcept
+		{
+			static std::atomic<uint64> nextKey{ 1 };
+			return nextKey.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	template<class T>
+	INLINE ThreadLocal<T>::ThreadLocal(WThreadManager threadMgr, Factory_t factory) noexcept
+		:m_Key(Impl::NextThreadLocalKey())
+		,m_Factory(std::move(factory))
+		,m_ThreadManager(std::move(threadMgr))
+	{
+		VerifyNot(m_ThreadManager.expired(), "Trying to initialize a ThreadLocal, but an expired ThreadManager was given.");
+		ConnectToManager(m_ThreadManager.lock());
+	}
+
+	template<class T>
+	INLINE ThreadLocal<T>::~ThreadLocal() noexcept
+	{
+		m_OnThreadCreation.Disconnect();
+		m_OnThreadDestruction.Disconnect();
+		m_OnManagerActivation.Disconnect();
+		m_OnNewManager.Disconnect();
+
+		// The caches of other threads keep the key, but it will never be given again
+		Impl::GetThreadLocalCache().erase(m_Key);
+
+		LOCK(m_InstancesMutex);
+		for (auto& [id, instance] : m_Instances)
+			Destroy(instance);
+		m_Instances.clear();
+	}
+
+	template<class T>
+	NODISCARD INLINE T& ThreadLocal<T>::Get() noexcept
+	{
+		auto& cache = Impl::GetThreadLocalCache();
+		const auto it = cache.find(m_Key);
+		if (it != cache.end())
+			return *(T*)it->second;
+		return CreateInstance();
+	}
+
+	template<class T>
+	NODISCARD INLINE T* ThreadLocal<T>::TryGet() noexcept
+	{
+		auto& cache = Impl::GetThreadLocalCache();
+		const auto it = cache.find(m_Key);
+		return it != cache.end() ? (T*)it->second : nullptr;
+	}
+
+	template<class T>
+	INLINE void ThreadLocal<T>::Reset() noexcept
+	{
+		RemoveInstance(CUR_THID());
+	}
+
+	template<class T>
+	NODISCARD INLINE sizet ThreadLocal<T>::GetInstanceCount() const noexcept
+	{
+		SHAREDLOCK(m_InstancesMutex);
+		return m_Instances.size();
+	}
+
+	template<class T>
+	INLINE void ThreadLocal<T>::ForEach(const std::function<void(ThreadID_t, T&)>& fn) noexcept
+	{
+		SHAREDLOCK(m_InstancesMutex);
+		for (auto& [id, instance] : m_Instances)
+			fn(id, *instance);
+	}
+
+	template<class T>
+	INLINE void ThreadLocal<T>::ForEach(const std::function<void(ThreadID_t, const T&)>& fn) const noexcept
+	{
+		SHAREDLOCK(m_InstancesMutex);
+		for (const auto& [id, instance] : m_Instances)
+			fn(id, *instance);
+	}
+
+	template<class T>
+	template<class TAcc, class BinaryOp>
+	NODISCARD INLINE TAcc ThreadLocal<T>::Aggregate(TAcc init, BinaryOp op) const noexcept
+	{
+		SHAREDLOCK(m_InstancesMutex);
+		for (const auto& [id, instance] : m_Instances)
+			init = op(std::move(init), (const T&)*instance);
+		return init;
+	}
+
+	template<class T>
+	INLINE T& ThreadLocal<T>::CreateInstance() noexcept
+	{
+		// Constructed outside the lock, the factory may use other ThreadLocals
+		auto* instance = AllocT<T>();
+		if (m_Factory != nullptr)
+			new ((void*)instance)T(m_Factory());
+		else
+			new ((void*)instance)T();
+
+		T* previous = nullptr;
+		{
+			LOCK(m_InstancesMutex);
+			// An unmanaged thread that finished may have left its instance under the same ID
+			const auto it = m_Instances.find(CUR_THID());
+			if (it != m_Instances.end())
+			{
+				previous = it->second;
+				it->second = instance;
+			}
+			else
+			{
+				m_Instances.insert_or_assign(CUR_THID(), instance);
+			}
+		}
+		if (previous != nullptr)
+			Destroy(previous);
+
+		Impl::GetThreadLocalCache().insert_or_assign(m_Key, (void*)instance);
+		return *instance;
+	}
+
+	template<class T>
+	INLINE void ThreadLocal<T>::RemoveInstance(ThreadID_t id) noexcept
+	{
+		T* instance = nullptr;
+		{
+			LOCK(m_InstancesMutex);
+			const auto it = m_Instances.find(id);
+			if (it == m_Instances.end())
+				return;
+			instance = it->second;
+			m_Instances.erase(it);
+		}
+
+		// Only the thread itself can reach its cache
+		if (id == CUR_THID())
+			Impl::GetThreadLocalCache().erase(m_Key);
+		Destroy(instance);
+	}
+
+	template<class T>
+	INLINE void ThreadLocal<T>::ConnectToManager(const PThreadManager& threadMgr) noexcept
+	{
+		// Both events are triggered from the thread that starts or finishes
+		threadMgr->GetThreadCreationEvent().Connect(m_OnThreadCreation, [this](UNUSED const PThread& thread) { RemoveInstance(CUR_THID()); });
+		threadMgr->GetThreadDestructionEvent().Connect(m_OnThreadDestruction, [this](const PThread& thread) { RemoveInstance(thread->GetID()); });
+		threadMgr->GetActivationEvent().Connect(m_OnManagerActivation, [this](bool active, IInterface* oldInterface, const PInterface& newInterface) { OnManagerActivation(active, oldInterface, newInterface); });
+	}
+
+	template<class T>
+	INLINE void ThreadLocal<T>::OnManagerActivation(bool active, IInterface* oldInterface, const PInterface& newInterface) noexcept
+	{
+		if (active)
+			return;
+
+		m_OnThreadCreation.Disconnect();
+		m_OnThreadDestruction.Disconnect();
+		m_OnManagerActivation.Disconnect();
+
+		// Change of ThreadManager
+		if (newInterface != nullptr)
+		{
+			const auto& newThreadMgr = (const PThreadManager&)newInterface;
+			m_ThreadManager = (WThreadManager)newThreadMgr;
+			ConnectToManager(newThreadMgr);
+		}
+		// ThreadManager deactivated, wait until a new one is active
+		else
+		{
+			const auto& libW = oldInterface->GetLibrary();
+			VerifyNot(libW.expired(), "Trying to connect to InterfaceActivationEvent but GreaperLibrary was expired.");
+			auto lib = libW.lock();
+			auto appW = lib->GetApplication();
+			VerifyNot(appW.expired(), "Trying to connect to InterfaceActivationEvent but Application was expired.");
+			auto app = appW.lock();
+			m_OnNewManager.Disconnect(); // double check we are not connected
+			app->GetOnInterfaceActivationEvent().Connect(m_OnNewManager, [this](const PInterface& newManager) { OnNewManager(newManager); });
+		}
+	}
+
+	template<class T>
+	INLINE void ThreadLocal<T>::OnNewManager(const PInterface& newInterface) noexcept
+	{
+		if (newInterface == nullptr || newInterface->GetInterfaceUUID() != IThreadManager::InterfaceUUID)
+			return;
+
+		m_ThreadManager = (WThreadManager)newInterface;
+		ConnectToManager((const PThreadManager&)newInterface);
+		m_OnNewManager.Disconnect();
+	}
+}
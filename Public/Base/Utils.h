@@ -8,6 +8,9 @@
 #include <cstring>
 #include <type_traits>
 #include <tuple>
+#if COMPILER_MSVC
+#include <intrin.h>
+#endif
 
 /** Checks if a value is within range [min,max) */
 template<typename T>
@@ -295,6 +298,106 @@ NODISCARD INLINE sizet ComputeHash(const ArgsType&... args)
 	return seed;
 }
 
+namespace HashImpl
+{
+	NODISCARD INLINE uint64 WyRead8(const uint8* ptr)noexcept { uint64 v; memcpy(&v, ptr, sizeof(v)); return v; }
+	NODISCARD INLINE uint64 WyRead4(const uint8* ptr)noexcept { uint32 v; memcpy(&v, ptr, sizeof(v)); return v; }
+	NODISCARD INLINE uint64 WyRead3(const uint8* ptr, sizet k)noexcept
+	{
+		return (((uint64)ptr[0]) << 16) | (((uint64)ptr[k >> 1]) << 8) | ptr[k - 1];
+	}
+	/** 64x64->128 multiplication, leaves the low part on a and the high part on b */
+	INLINE void WyMum(uint64& a, uint64& b)noexcept
+	{
+#if COMPILER_MSVC
+		a = _umul128(a, b, &b);
+#else
+		const __uint128_t r = (__uint128_t)a * b;
+		a = (uint64)r;
+		b = (uint64)(r >> 64);
+#endif
+	}
+	NODISCARD INLINE uint64 WyMix(uint64 a, uint64 b)noexcept
+	{
+		WyMum(a, b);
+		return a ^ b;
+	}
+}
+
+/**
+*	Computes a wide hash of a contiguous block of memory, it consumes 48 bytes per
+*	iteration on large inputs, based on wyhash (public domain) by Wang Yi.
+*/
+NODISCARD INLINE uint64 HashBytes(const void* data, sizet length, uint64 seed = 0)noexcept
+{
+	constexpr uint64 secret0 = 0xa0761d6478bd642full;
+	constexpr uint64 secret1 = 0xe7037ed1a0b428dbull;
+	constexpr uint64 secret2 = 0x8ebc6af09c88c6e3ull;
+	constexpr uint64 secret3 = 0x589965cc75374cc3ull;
+
+	const auto* ptr = static_cast<const uint8*>(data);
+	seed ^= HashImpl::WyMix(seed ^ secret0, secret1);
+	uint64 a, b;
+	if (length <= 16)
+	{
+		if (length >= 4)
+		{
+			const sizet offset = (length >> 3) << 2;
+			a = (HashImpl::WyRead4(ptr) << 32) | HashImpl::WyRead4(ptr + offset);
+			b = (HashImpl::WyRead4(ptr + length - 4) << 32) | HashImpl::WyRead4(ptr + length - 4 - offset);
+		}
+		else if (length > 0)
+		{
+			a = HashImpl::WyRead3(ptr, length);
+			b = 0;
+		}
+		else
+		{
+			a = b = 0;
+		}
+	}
+	else
+	{
+		sizet i = length;
+		if (i > 48)
+		{
+			uint64 seed1 = seed, seed2 = seed;
+			do
+			{
+				seed = HashImpl::WyMix(HashImpl::WyRead8(ptr) ^ secret1, HashImpl::WyRead8(ptr + 8) ^ seed);
+				seed1 = HashImpl::WyMix(HashImpl::WyRead8(ptr + 16) ^ secret2, HashImpl::WyRead8(ptr + 24) ^ seed1);
+				seed2 = HashImpl::WyMix(HashImpl::WyRead8(ptr + 32) ^ secret3, HashImpl::WyRead8(ptr + 40) ^ seed2);
+				ptr += 48;
+				i -= 48;
+			} while (i > 48);
+			seed ^= seed1 ^ seed2;
+		}
+		while (i > 16)
+		{
+			seed = HashImpl::WyMix(HashImpl::WyRead8(ptr) ^ secret1, HashImpl::WyRead8(ptr + 8) ^ seed);
+			i -= 16;
+			ptr += 16;
+		}
+		a = HashImpl::WyRead8(ptr + i - 16);
+		b = HashImpl::WyRead8(ptr + i - 8);
+	}
+	a ^= secret1;
+	b ^= seed;
+	HashImpl::WyMum(a, b);
+	return HashImpl::WyMix(a ^ secret0 ^ length, b ^ secret1);
+}
+
+/**
+*	Hashes a value by its object representation, only valid for types where equal
+*	values always share the same bytes (no padding, no floating points).
+*/
+template<class T>
+NODISCARD INLINE sizet HashObjectBytes(const T& value)noexcept
+{
+	static_assert(std::has_unique_object_representations_v<T>, "HashObjectBytes used with a type that can have several representations of the same value.");
+	return (sizet)HashBytes(&value, sizeof(T));
+}
+
 /***********************************************************************************
 *                             MEMORY HELPER FUNCITONS                              *
 ***********************************************************************************/
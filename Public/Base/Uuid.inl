@@ -5,7 +5,11 @@
 
 #if PLT_WINDOWS
 #include "../Win/Win32Uuid.h"
+#else
+#include <sys/random.h>
 #endif
+#include <atomic>
+#include <chrono>
 
 namespace greaper
 {
@@ -147,6 +151,156 @@ namespace greaper
 			}
 			uuid.assign(reinterpret_cast<const achar*>(output), 36);
 		}
+
+		INLINE void FillRandomFromOS(void* buffer, sizet size) noexcept
+		{
+			auto* ptr = (uint8*)buffer;
+#if PLT_WINDOWS
+			while (size > 0)
+			{
+				UUID uuid;
+				UuidCreate(&uuid);
+				const auto count = Min(sizeof(uuid), size);
+				memcpy(ptr, &uuid, count);
+				ptr += count;
+				size -= count;
+			}
+#else
+			while (size > 0)
+			{
+				const auto ret = getrandom(ptr, size, 0);
+				if (ret < 0)
+				{
+					if (errno == EINTR)
+						continue;
+					break;
+				}
+				ptr += ret;
+				size -= (sizet)ret;
+			}
+			// Kernels without getrandom, libuuid reads /dev/urandom by itself
+			while (size > 0)
+			{
+				uuid_t uuid;
+				uuid_generate(uuid);
+				const auto count = Min(sizeof(uuid), size);
+				memcpy(ptr, uuid, count);
+				ptr += count;
+				size -= count;
+			}
+#endif
+		}
+
+		// Increased on the child of every fork, so the generators copied from the parent get seeded again
+		NODISCARD INLINE uint32 GetUuidForkGeneration() noexcept
+		{
+			static std::atomic<uint32> generation{ 0 };
+#if !PLT_WINDOWS
+			UNUSED static const bool registered = pthread_atfork(nullptr, nullptr, []() { generation.fetch_add(1, std::memory_order_relaxed); }) == 0;
+#endif
+			return generation.load(std::memory_order_relaxed);
+		}
+
+		/*** xoshiro256** generator for the Uuids of a thread
+		*	Its 256 bits of state are seeded from the OS, passed through splitmix64 so that
+		*	a seed with few bits set still gives a well mixed state.
+		*/
+		class UuidGenerator
+		{
+			uint64 m_State[4];
+			uint32 m_ForkGeneration;
+			uint64 m_LastTimestampMS = 0;
+			uint32 m_Sequence = 0;
+
+			static constexpr uint64 Rotl(uint64 x, int32 k) noexcept { return (x << k) | (x >> (64 - k)); }
+
+			INLINE void Seed() noexcept
+			{
+				m_ForkGeneration = GetUuidForkGeneration();
+				uint64 seed[4] = { 0, 0, 0, 0 };
+				FillRandomFromOS(seed, sizeof(seed));
+				for (sizet i = 0; i < 4; ++i)
+				{
+					uint64 z = seed[i] + (i + 1) * 0x9E3779B97F4A7C15ull;
+					z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+					z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+					m_State[i] = z ^ (z >> 31);
+				}
+			}
+
+			// Done before anything else is generated, the timestamps keep increasing across the reseed
+			INLINE void SeedAgainAfterFork() noexcept
+			{
+				if (m_ForkGeneration != GetUuidForkGeneration())
+					Seed();
+			}
+
+			INLINE uint64 Next() noexcept
+			{
+				const uint64 result = Rotl(m_State[1] * 5, 7) * 9;
+				const uint64 t = m_State[1] << 17;
+				m_State[2] ^= m_State[0];
+				m_State[3] ^= m_State[1];
+				m_State[1] ^= m_State[2];
+				m_State[0] ^= m_State[3];
+				m_State[2] ^= t;
+				m_State[3] = Rotl(m_State[3], 45);
+				return result;
+			}
+
+			// Variant bits 10 on the top of the third word, the rest of the lower 64 bits are random
+			INLINE void FillLowerHalf(uint32& data2, uint32& data3) noexcept
+			{
+				const auto value = Next();
+				data2 = ((uint32)(value >> 32) & 0x3FFFFFFF) | 0x80000000;
+				data3 = (uint32)value;
+			}
+
+		public:
+			INLINE UuidGenerator() noexcept
+			{
+				Seed();
+			}
+
+			INLINE Uuid GenerateV4() noexcept
+			{
+				SeedAgainAfterFork();
+				const auto value = Next();
+				uint32 data2, data3;
+				FillLowerHalf(data2, data3);
+				return Uuid((uint32)(value >> 32), ((uint32)value & 0xFFFF0FFF) | 0x4000, data2, data3);
+			}
+
+			INLINE Uuid GenerateV7() noexcept
+			{
+				SeedAgainAfterFork();
+				const auto now = std::chrono::system_clock::now().time_since_epoch();
+				const auto timestampMS = (uint64)std::chrono::duration_cast<std::chrono::milliseconds>(now).count() & 0xFFFFFFFFFFFFull;
+
+				// The 12 bits after the version count within a millisecond, starting from a random value
+				// with room for at least 2048 Uuids, when they run out the timestamp is moved forward
+				if (timestampMS > m_LastTimestampMS)
+				{
+					m_LastTimestampMS = timestampMS;
+					m_Sequence = (uint32)Next() & 0x7FF;
+				}
+				else if (++m_Sequence > 0xFFF)
+				{
+					++m_LastTimestampMS;
+					m_Sequence = (uint32)Next() & 0x7FF;
+				}
+
+				uint32 data2, data3;
+				FillLowerHalf(data2, data3);
+				return Uuid((uint32)(m_LastTimestampMS >> 16), ((uint32)(m_LastTimestampMS & 0xFFFF) << 16) | 0x7000 | m_Sequence, data2, data3);
+			}
+		};
+
+		NODISCARD INLINE UuidGenerator& GetUuidGenerator() noexcept
+		{
+			static thread_local UuidGenerator generator;
+			return generator;
+		}
 	}
 
 	/*INLINE constexpr Uuid::Uuid() noexcept
@@ -219,27 +373,43 @@ namespace greaper
 	}
 
 	INLINE Uuid Uuid::GenerateRandom() noexcept
+	{
+		return Impl::GetUuidGenerator().GenerateV4();
+	}
+
+	INLINE Uuid Uuid::GenerateRandomFromOS() noexcept
 	{
 #if PLT_WINDOWS
+		// Laid out in the order of the string representation, so the version and variant end where GetVersion expects them
 		UUID uuid;
 		UuidCreate(&uuid);
-		const auto data0 = uuid.Data1;
-		const auto data1 = uuid.Data2 | (uuid.Data3 << 16);
-		const auto data2 = uuid.Data3 | (uuid.Data4[0] << 16) | (uuid.Data4[1] << 24);
-		const auto data3 = uuid.Data4[2] | (uuid.Data4[3] << 8) | (uuid.Data4[4] << 16) | (uuid.Data4[5] << 24);
+		const auto data0 = (uint32)uuid.Data1;
+		const auto data1 = ((uint32)uuid.Data2 << 16) | (uint32)uuid.Data3;
+		const auto data2 = ((uint32)uuid.Data4[0] << 24) | ((uint32)uuid.Data4[1] << 16) | ((uint32)uuid.Data4[2] << 8) | (uint32)uuid.Data4[3];
+		const auto data3 = ((uint32)uuid.Data4[4] << 24) | ((uint32)uuid.Data4[5] << 16) | ((uint32)uuid.Data4[6] << 8) | (uint32)uuid.Data4[7];
 		return Uuid(data0, data1, data2, data3);
 #elif PLT_LINUX
+		// Laid out in the order of the string representation, so the version and variant end where GetVersion expects them
 		uuid_t nativeUUID;
 		uuid_generate(nativeUUID);
 
-		return Uuid(
-			*(uint32*)&nativeUUID[0],
-			*(uint32*)&nativeUUID[4],
-			*(uint32*)&nativeUUID[8],
-			*(uint32*)&nativeUUID[12]);
+		uint32 data[4];
+		for (sizet i = 0; i < 4; ++i)
+			data[i] = ((uint32)nativeUUID[i * 4] << 24) | ((uint32)nativeUUID[i * 4 + 1] << 16) | ((uint32)nativeUUID[i * 4 + 2] << 8) | (uint32)nativeUUID[i * 4 + 3];
+		return Uuid(data[0], data[1], data[2], data[3]);
 #endif
 	}
 
+	INLINE Uuid Uuid::GenerateTimeOrdered() noexcept
+	{
+		return Impl::GetUuidGenerator().GenerateV7();
+	}
+
+	INLINE constexpr uint8 Uuid::GetVersion() const noexcept
+	{
+		return (uint8)((m_Data[1] >> 12) & 0xF);
+	}
+
 	INLINE constexpr bool Uuid::IsEmpty()const noexcept
 	{
 		return m_Data[0] == 0 && m_Data[1] == 0 && m_Data[2] == 0 && m_Data[3] == 0;
@@ -314,7 +484,7 @@ namespace std
 	{
 		size_t operator()(const greaper::Uuid& val)const noexcept
 		{
-			return ComputeHash(val.m_Data[0], val.m_Data[1], val.m_Data[2], val.m_Data[3]);
+			return (size_t)HashBytes(val.m_Data, sizeof(val.m_Data));
 		}
 	};
 }
\ No newline at end of file
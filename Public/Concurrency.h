@@ -15,6 +15,7 @@
 #endif
 #include <atomic>
 #include <chrono>
+#include <cstring>
 
 /*** Cross-platform concurrency primitives and utilites
 *	
@@ -890,6 +891,239 @@ namespace greaper
 		NODISCARD INLINE const Mutex& GetMutex()const noexcept { return m_Mutex; }
 		NODISCARD INLINE Mutex& GetMutex()noexcept { return m_Mutex; }
 	};
+
+	/*** One-shot gate, the threads calling Wait block until Open is called
+	*	Waits on the address of its state (a futex on Linux, WaitOnAddress on Windows),
+	*	opening a gate nobody is waiting on is a single atomic exchange, otherwise
+	*	it's one wake up call for all the waiters, no mutex is involved.
+	*/
+	class Gate
+	{
+		static constexpr uint32 Closed = 0;
+		static constexpr uint32 ClosedWithWaiters = 1;
+		static constexpr uint32 Opened = 2;
+
+		std::atomic<uint32> m_State;
+
+	public:
+		INLINE Gate()noexcept
+			:m_State(Closed)
+		{
+
+		}
+		Gate(const Gate&) = delete;
+		Gate& operator=(const Gate&) = delete;
+
+		INLINE void Open()noexcept
+		{
+			if (m_State.exchange(Opened, std::memory_order_acq_rel) == ClosedWithWaiters)
+				Impl::AddressWaitImpl::WakeAll(m_State);
+		}
+
+		INLINE void Wait()noexcept
+		{
+			auto state = m_State.load(std::memory_order_acquire);
+			while (state != Opened)
+			{
+				// The opener only wakes when it sees someone announced to be waiting
+				if (state == Closed && !m_State.compare_exchange_weak(state, ClosedWithWaiters, std::memory_order_acq_rel))
+					continue;
+				Impl::AddressWaitImpl::Wait(m_State, ClosedWithWaiters);
+				state = m_State.load(std::memory_order_acquire);
+			}
+		}
+
+		NODISCARD INLINE bool IsOpen()const noexcept { return m_State.load(std::memory_order_acquire) == Opened; }
+	};
+
+	/*** Publishes a trivially copyable value to readers without taking any lock
+	*	Values that fit in a lock-free std::atomic are stored on it, bigger ones are
+	*	split in words guarded by a sequence counter, readers retry the copy if a
+	*	write happened meanwhile, so they never block the writer nor write shared memory.
+	*	Writers must be serialized externally.
+	*/
+	template<class T>
+	class SeqLockValue
+	{
+		static_assert(std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>,
+			"SeqLockValue can only publish trivially copyable types.");
+
+		static constexpr bool UseAtomic = sizeof(T) <= sizeof(uint64) && std::atomic<T>::is_always_lock_free;
+		static constexpr sizet WordCount = (sizeof(T) + sizeof(uint64) - 1) / sizeof(uint64);
+
+		struct Words
+		{
+			std::atomic<uint32> Sequence{ 0 };
+			std::atomic<uint64> Data[WordCount];
+		};
+		std::conditional_t<UseAtomic, std::atomic<T>, Words> m_Storage;
+
+	public:
+		INLINE explicit SeqLockValue(const T& value = T{})noexcept
+		{
+			Store(value);
+		}
+		SeqLockValue(const SeqLockValue&) = delete;
+		SeqLockValue& operator=(const SeqLockValue&) = delete;
+
+		NODISCARD INLINE T Load()const noexcept
+		{
+			if constexpr (UseAtomic)
+			{
+				return m_Storage.load(std::memory_order_acquire);
+			}
+			else
+			{
+				uint64 data[WordCount];
+				while (true)
+				{
+					const auto seq = m_Storage.Sequence.load(std::memory_order_acquire);
+					if ((seq & 1) != 0)
+					{
+						THREAD_YIELD(); // Writer in progress
+						continue;
+					}
+					for (sizet i = 0; i < WordCount; ++i)
+						data[i] = m_Storage.Data[i].load(std::memory_order_relaxed);
+					std::atomic_thread_fence(std::memory_order_acquire);
+					if (m_Storage.Sequence.load(std::memory_order_relaxed) == seq)
+						break;
+				}
+				T value;
+				memcpy(&value, data, sizeof(T));
+				return value;
+			}
+		}
+
+		INLINE void Store(const T& value)noexcept
+		{
+			if constexpr (UseAtomic)
+			{
+				m_Storage.store(value, std::memory_order_release);
+			}
+			else
+			{
+				uint64 data[WordCount] = {};
+				memcpy(data, &value, sizeof(T));
+				const auto seq = m_Storage.Sequence.load(std::memory_order_relaxed);
+				m_Storage.Sequence.store(seq + 1, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_release);
+				for (sizet i = 0; i < WordCount; ++i)
+					m_Storage.Data[i].store(data[i], std::memory_order_relaxed);
+				m_Storage.Sequence.store(seq + 2, std::memory_order_release);
+			}
+		}
+
+		NODISCARD static constexpr bool IsAtomic()noexcept { return UseAtomic; }
+	};
+
+	/*** Publishes a heap object that many threads read and few threads replace.
+	*	Readers take a ReadGuard, which only bumps the reader counter of the current
+	*	epoch, and access the published object through it without locking.
+	*	Publish swaps the object, moves to the next epoch and waits for the readers of
+	*	the previous one to leave before destroying the old object, so a ReadGuard must
+	*	be short lived and never held while publishing from the same thread.
+	*/
+	template<class T, class _Alloc_ = GenericAllocator>
+	class RCUValue
+	{
+		std::atomic<T*> m_Current{ nullptr };
+		std::atomic<uint64> m_Epoch{ 0 };
+		mutable std::atomic<uint32> m_Readers[2] = { 0, 0 };
+		Mutex m_WriteMutex;
+
+		INLINE static void DestroyValue(T* value)noexcept
+		{
+			if (value != nullptr)
+				Destroy<T, _Alloc_>(value);
+		}
+
+	public:
+		class ReadGuard
+		{
+			const RCUValue* m_Owner = nullptr;
+			const T* m_Value = nullptr;
+			uint32 m_Slot = 0;
+
+			friend class RCUValue;
+
+		public:
+			ReadGuard()noexcept = default;
+			ReadGuard(const ReadGuard&) = delete;
+			ReadGuard& operator=(const ReadGuard&) = delete;
+			INLINE ReadGuard(ReadGuard&& other)noexcept
+				:m_Owner(std::exchange(other.m_Owner, nullptr))
+				,m_Value(std::exchange(other.m_Value, nullptr))
+				,m_Slot(other.m_Slot)
+			{
+
+			}
+			ReadGuard& operator=(ReadGuard&&) = delete;
+			INLINE ~ReadGuard()noexcept
+			{
+				if (m_Owner != nullptr)
+					m_Owner->m_Readers[m_Slot].fetch_sub(1, std::memory_order_release);
+			}
+
+			NODISCARD INLINE const T* Get()const noexcept { return m_Value; }
+			NODISCARD INLINE const T* operator->()const noexcept { return m_Value; }
+			NODISCARD INLINE const T& operator*()const noexcept { return *m_Value; }
+			NODISCARD INLINE explicit operator bool()const noexcept { return m_Value != nullptr; }
+		};
+
+		RCUValue()noexcept = default;
+		RCUValue(const RCUValue&) = delete;
+		RCUValue& operator=(const RCUValue&) = delete;
+
+		INLINE ~RCUValue()noexcept
+		{
+			DestroyValue(m_Current.exchange(nullptr, std::memory_order_acq_rel));
+		}
+
+		NODISCARD INLINE ReadGuard Read()const noexcept
+		{
+			ReadGuard guard;
+			while (true)
+			{
+				const auto epoch = m_Epoch.load(std::memory_order_seq_cst);
+				const auto slot = (uint32)(epoch & 1);
+				m_Readers[slot].fetch_add(1, std::memory_order_seq_cst);
+				if (m_Epoch.load(std::memory_order_seq_cst) == epoch)
+				{
+					guard.m_Owner = this;
+					guard.m_Slot = slot;
+					break;
+				}
+				m_Readers[slot].fetch_sub(1, std::memory_order_release); // A writer moved on, retry on the new epoch
+			}
+			guard.m_Value = m_Current.load(std::memory_order_acquire);
+			return guard;
+		}
+
+		// Replaces the published object, returns once no reader can see the previous one
+		INLINE void Publish(T value)noexcept
+		{
+			T* newValue = AllocT<T, _Alloc_>();
+			new((void*)newValue)T(std::move(value));
+			PublishPtr(newValue);
+		}
+
+		INLINE void Reset()noexcept
+		{
+			PublishPtr(nullptr);
+		}
+
+	private:
+		INLINE void PublishPtr(T* newValue)noexcept
+		{
+			LOCK(m_WriteMutex);
+			T* oldValue = m_Current.exchange(newValue, std::memory_order_acq_rel);
+			const auto oldSlot = (uint32)(m_Epoch.fetch_add(1, std::memory_order_seq_cst) & 1);
+			while (m_Readers[oldSlot].load(std::memory_order_acquire) != 0)
+				THREAD_YIELD();
+			DestroyValue(oldValue);
+		}
+	};
 }
 
 #endif /* CORE_CONCURRENCY_H */
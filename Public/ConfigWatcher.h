@@ -0,0 +1,67 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef CORE_CONFIG_WATCHER_H
+#define CORE_CONFIG_WATCHER_H 1
+
+#include "IGreaperLibrary.h"
+#include "IThreadManager.h"
+#include "Base/IThread.h"
+#if PLT_WINDOWS
+#include "Win/WinDirectoryWatcher.h"
+#else
+#include "Lnx/LnxDirectoryWatcher.h"
+#endif
+
+namespace greaper
+{
+	/*** Hot reloads the configuration of the registered libraries
+	*	Watches the Config directory from its own thread, collects the modified config
+	*	files until no new modification arrives during the debounce time and then calls
+	*	IGreaperLibrary::ReloadConfig on the library named as each file.
+	*	ReloadConfig only applies the properties whose value differs, through their
+	*	validators, so the modification events of those properties, and the
+	*	PropertiesChanged event of the library, are triggered from the watcher thread.
+	*	A library being deinitialized waits for its reload in flight, and is not reloaded after.
+	*/
+	class ConfigWatcher
+	{
+	public:
+		static constexpr std::chrono::milliseconds DefaultDebounce = std::chrono::milliseconds(250);
+
+		template<class _Alloc_ = GenericAllocator>
+		static TResult<SPtr<ConfigWatcher>> Create(WThreadManager threadMgr, WApplication application, std::chrono::milliseconds debounce = DefaultDebounce)noexcept;
+
+		~ConfigWatcher()noexcept;
+
+		ConfigWatcher(const ConfigWatcher&) = delete;
+		ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+		void Stop()noexcept;
+
+		NODISCARD bool IsRunning()const noexcept;
+
+	private:
+		WApplication m_Application;
+		OSDirectoryWatcher m_Watcher;
+		std::chrono::milliseconds m_Debounce;
+		std::atomic_bool m_Running;
+		PThread m_Thread;
+
+		ConfigWatcher(WApplication application, std::chrono::milliseconds debounce)noexcept;
+
+		EmptyResult Start(WThreadManager threadMgr)noexcept;
+
+		void Run()noexcept;
+
+		void ReloadLibraries(const Vector<String>& libraryNames)noexcept;
+	};
+}
+
+#include "Base/ConfigWatcher.inl"
+
+#endif /* CORE_CONFIG_WATCHER_H */
@@ -40,6 +40,7 @@ namespace greaper
 	using WThread = WPtr<Thread>; using PThread = SPtr<Thread>;
 
 	struct ThreadConfig;
+	struct ThreadStats;
 	class ICommandManager; using PCommandManager = SPtr<ICommandManager>; using WCommandManager = WPtr<ICommandManager>;
 	class ICommand; using PCommand = SPtr<ICommand>; using WCommand = WPtr<ICommand>;
 	class IConsole; using PConsole = SPtr<IConsole>; using WConsole = WPtr<IConsole>;
@@ -112,6 +113,10 @@ namespace greaper
 			RTI_UnorderedSet,
 			RTI_MultiSet,
 			RTI_UnorderedMultiSet,
+			RTI_FlatMap,
+			RTI_FlatSet,
+			RTI_SmallVector,
+			RTI_StaticVector,
 		};
 
 		template<class T> struct PlainType {  };
@@ -68,7 +68,8 @@ namespace greaper
 	class Event
 	{
 		RecursiveMutex m_Mutex;
-		Vector<EventHandlerID<Args...>> m_Handlers;
+		// Most events have a couple of listeners, they are stored inline
+		SmallVector<EventHandlerID<Args...>, 4> m_Handlers;
 		SPtr<Event<Args...>> m_This;
 
 		String m_Name;
@@ -167,7 +168,7 @@ namespace greaper
 	class Event<void>
 	{
 		Mutex m_Mutex;
-		Vector<EventHandlerID<void>> m_Handlers;
+		SmallVector<EventHandlerID<void>, 4> m_Handlers;
 		SPtr<Event<void>> m_This;
 		String m_Name;
 		uint32 m_LastID;
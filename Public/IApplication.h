@@ -11,8 +11,30 @@
 #include "Interface.h"
 //#include "Result.h"
 
+ENUMERATION(UpdatePhase, PreUpdate, FixedUpdate, Update, PostUpdate);
+
 namespace greaper
 {
+	class PropertyRegistry;
+
+	/**
+	 * @brief Describes a GreaperLibrary that is registered without being loaded, the library
+	 * is loaded the first time it or one of the interfaces it provides is requested.
+	 */
+	struct LibraryManifest
+	{
+		struct InterfaceInfo
+		{
+			Uuid InterfaceUUID;
+			String InterfaceName;
+		};
+
+		String LibraryName;
+		Uuid LibraryUUID;
+		String LibraryPath;
+		Vector<InterfaceInfo> Interfaces;
+	};
+
 	/*** The base of Greaper, provides all the necesary to run a real-time application
 	*	Providing all the plumbing required to have multiple plugins working at the same time
 	*	and allowing interface interchange at run-time, except for itself.
@@ -44,15 +66,49 @@ namespace greaper
 		DEF_PROP(CompilationInfo, String);
 		DEF_PROP(ApplicationVersion, uint32);
 		DEF_PROP(LoadedLibraries, StringVec);
+		DEF_PROP(UpdateMaxRate, uint32);
+		DEF_PROP(FixedUpdateMaxRate, uint32);
 		
 		using OnInterfaceActivationEvent_t = Event<const PInterface&>;
 
+		// Counters of the update loop, updated at the end of each tick
+		struct UpdateStats
+		{
+			uint64 FrameCount = 0;
+			uint64 FixedUpdateCount = 0;
+			Duration_t DeltaTime{};			// Time between the last two ticks
+			Duration_t FixedDeltaTime{};	// Step of each FixedUpdate, zero if disabled
+			float FixedUpdateAlpha = 0.f;	// Leftover of the fixed accumulator, as a fraction of FixedDeltaTime
+			Duration_t LastWaitTime{};		// Time spent pacing the last frame
+			Duration_t LastPhaseTime[(sizet)UpdatePhase_t::COUNT]{};
+			Duration_t TotalPhaseTime[(sizet)UpdatePhase_t::COUNT]{};
+		};
+
 		virtual ~IApplication()noexcept = default;
 
 		virtual TResult<PGreaperLib> RegisterGreaperLibrary(const StringView& libPath)noexcept = 0;
 		
 		virtual TResult<PGreaperLib> RegisterGreaperLibrary(PLibrary library)noexcept = 0;
 
+		/**
+		 * Registers several libraries and initializes them, respecting their GetLibraryDependencies,
+		 * libraries that don't depend on each other are initialized concurrently.
+		 * Nothing is registered if a dependency is missing or there's a dependency cycle.
+		 */
+		virtual TResult<Vector<PGreaperLib>> RegisterGreaperLibraries(const Vector<StringView>& libPaths)noexcept = 0;
+
+		virtual TResult<Vector<PGreaperLib>> RegisterGreaperLibraries(const Vector<PLibrary>& libraries)noexcept = 0;
+
+		/**
+		 * Registers a library without loading it. Requesting the library by name or UUID, or
+		 * requesting one of the interfaces of the manifest, loads and initializes it, interfaces
+		 * requested through GetActiveInterface are also activated.
+		 */
+		virtual EmptyResult RegisterLazyGreaperLibrary(LibraryManifest manifest)noexcept = 0;
+
+		// Whether the library is registered lazily and has not been loaded yet
+		virtual bool IsGreaperLibraryPending(const StringView& libraryName)const noexcept = 0;
+
 		virtual TResult<PGreaperLib> GetGreaperLibrary(const StringView& libraryName)const noexcept = 0;
 
 		virtual TResult<PGreaperLib> GetGreaperLibrary(const Uuid& libraryUUID)const noexcept = 0;
@@ -73,6 +129,12 @@ namespace greaper
 
 		virtual TResult<PInterface> GetActiveInterface(const StringView& interfaceName)const noexcept = 0;
 
+		// Same as GetActiveInterface but without building an error, returns nullptr if not active
+		virtual PInterface FindActiveInterface(const Uuid& interfaceUUID)const noexcept = 0;
+
+		// Incremented each time the set of active interfaces changes
+		virtual const std::atomic<uint64>& GetActiveInterfacesGeneration()const noexcept = 0;
+
 		virtual TResult<PInterface> GetInterface(const Uuid& interfaceUUID, const Uuid& libraryUUID)const noexcept = 0;
 
 		virtual TResult<PInterface> GetInterface(const StringView& interfaceName, const StringView& libraryName)const noexcept = 0;
@@ -95,10 +157,37 @@ namespace greaper
 
 		virtual WPtr<CommandLineProp_t> GetCommandLine()const noexcept = 0;
 
+		virtual WPtr<UpdateMaxRateProp_t> GetUpdateMaxRate()const noexcept = 0;
+
+		virtual WPtr<FixedUpdateMaxRateProp_t> GetFixedUpdateMaxRate()const noexcept = 0;
+
+		/**
+		 * Runs a single update tick on the calling thread: PreUpdate, as many FixedUpdate as
+		 * the fixed accumulator allows, Update and PostUpdate. Interfaces that report
+		 * IsUpdateThreadSafe run their phase concurrently while the update loop scheduler exists.
+		 */
+		virtual void Tick()noexcept = 0;
+
+		// Ticks on the calling thread until StopUpdateLoop, pacing the frames to UpdateMaxRate
+		virtual void RunUpdateLoop()noexcept = 0;
+
+		virtual void StopUpdateLoop()noexcept = 0;
+
+		virtual bool IsUpdateLoopRunning()const noexcept = 0;
+
+		virtual UpdateStats GetUpdateStats()const noexcept = 0;
+
 		virtual Vector<PGreaperLib> GetRegisteredLibrariesCopy()const noexcept = 0;
 
 		virtual Vector<PInterface> GetActiveInterfacesCopy()const noexcept = 0;
 
+		// Process-wide index of the properties of every initialized library
+		virtual PropertyRegistry& GetPropertyRegistry()const noexcept = 0;
+
+		// Runs workFn on a single worker shared by the libraries, i.e. for their config exports. Fails without
+		// an active ThreadManager or once the Application is deinitializing, the caller runs it itself then
+		virtual EmptyResult AddBackgroundTask(StringView name, std::function<void()> workFn)noexcept = 0;
+
 		template<class T>
 		INLINE TResult<WPtr<T>> GetGreaperLibraryT(const StringView& libraryName)const noexcept
 		{
@@ -189,6 +278,54 @@ namespace greaper
 			return Result::CreateSuccess(interface);
 		}
 	};
+
+	/**
+	 * @brief Caches the active implementation of the interface T, while the active
+	 * interfaces generation of the Application does not change Get only loads and compares
+	 * the generation. Not thread-safe, each user keeps its own handle, and it must not
+	 * outlive the Application.
+	 */
+	template<class T>
+	class TActiveInterfaceHandle
+	{
+		static_assert(IsInterface<T>::value, "Trying to create a handle to an interface that does not derive from IInterface.");
+
+		const IApplication* m_Application = nullptr;
+		const std::atomic<uint64>* m_Generation = nullptr;
+		uint64 m_CachedGeneration = 0;
+		SPtr<T> m_Interface;
+
+	public:
+		TActiveInterfaceHandle()noexcept = default;
+		INLINE explicit TActiveInterfaceHandle(const IApplication& application)noexcept
+			:m_Application(&application)
+			,m_Generation(&application.GetActiveInterfacesGeneration())
+		{
+
+		}
+
+		NODISCARD INLINE const SPtr<T>& Get()noexcept
+		{
+			VerifyNotNull(m_Application, "Trying to use an unbound active interface handle.");
+			const auto generation = m_Generation->load(std::memory_order_acquire);
+			if (generation != m_CachedGeneration)
+			{
+				m_Interface = (SPtr<T>)m_Application->FindActiveInterface(T::InterfaceUUID);
+				m_CachedGeneration = generation;
+			}
+			return m_Interface;
+		}
+
+		NODISCARD INLINE T* operator->()noexcept { return Get().get(); }
+		NODISCARD INLINE bool IsBound()const noexcept { return m_Application != nullptr; }
+		INLINE void Reset()noexcept
+		{
+			m_Interface.reset();
+			m_Application = nullptr;
+			m_Generation = nullptr;
+			m_CachedGeneration = 0;
+		}
+	};
 }
 
 #endif /* CORE_I_APPLICATION_H */
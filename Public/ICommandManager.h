@@ -13,6 +13,7 @@
 #include "Base/ICommand.h"
 //#include "Result.h"
 #include "Base/IConsole.h"
+#include <future>
 
 namespace greaper
 {
@@ -22,10 +23,26 @@ namespace greaper
 		static constexpr Uuid InterfaceUUID = Uuid{ 0x557FF73A, 0x6C4144AF, 0xB02DE998, 0x0D378CCA };
 		static constexpr StringView InterfaceName = StringView{ "CommandManager" };
 
+		DEF_PROP(UndoDepth, uint32);
+
 		virtual ~ICommandManager() = default;
 
+		virtual WPtr<UndoDepthProp_t> GetUndoDepth()const noexcept = 0;
+
 		virtual EmptyResult HandleCommand(const CommandInfo& info)noexcept = 0;
 
+		// Runs the command on the CommandManager workers, or on the calling thread if there are none
+		virtual std::future<EmptyResult> HandleCommandAsync(CommandInfo info)noexcept = 0;
+
+		/**
+		 * @brief Runs a script with one command per line, empty lines and the ones starting
+		 * with '#' are skipped. The whole script is parsed and resolved before running
+		 * anything, consecutive commands that CanRunInParallel are run at the same time,
+		 * the rest run alone once the previous ones have finished.
+		 * Stops at the first batch that fails.
+		 */
+		virtual EmptyResult RunCommandScript(StringView script)noexcept = 0;
+
 		virtual EmptyResult UndoLastCommand()noexcept = 0;
 
 		virtual EmptyResult UndoCommand(const String& cmdName)noexcept = 0;
@@ -38,6 +55,15 @@ namespace greaper
 
 		virtual bool HasCommand(const String& cmdName)const noexcept = 0;
 
+		// Names of the commands starting with prefix, sorted
+		virtual Vector<String> GetCommandsWithPrefix(StringView prefix)const noexcept = 0;
+
+		// Extends prefix as far as every command starting with it agrees, for console autocompletion
+		virtual String CompleteCommand(StringView prefix)const noexcept = 0;
+
+		// Names of the commands closest to cmdName, for when it was mistyped
+		virtual Vector<String> SuggestCommands(StringView cmdName, sizet maxSuggestions = 3)const noexcept = 0;
+
 		virtual void AccessCommandStack(const std::function<void(CSpan<CommandInfo>)>& accessFn)const noexcept = 0;
 
 		virtual PConsole GetConsole()const noexcept = 0;
@@ -15,6 +15,12 @@
 #include "ILogManager.h"
 #include "IApplication.h"
 #include "Property.h"
+#include "PropertyTransaction.h"
+#include "PropertyRegistry.h"
+#include <filesystem>
+#include <future>
+
+ENUMERATION(ConfigFormat, JSON, Binary);
 
 namespace greaper
 {
@@ -24,6 +30,9 @@ namespace greaper
 	protected:
 		EmptyResult RegisterProperty(const PIProperty& property)noexcept;
 
+		// Adds the property to the Application's PropertyRegistry, if there's an Application
+		void RegisterPropertyGlobally(const PIProperty& property)noexcept;
+
 		// Used normally to initialize sub libraries (SDL, FreeImage...)
 		virtual void Initialize()noexcept;
 		// Used normally to deinitialize sub libraries (SDL, FreeImage...)
@@ -46,12 +55,32 @@ namespace greaper
 		// Allows the import and export of the configuration (Properties) of the library, if not overrided defaults to true
 		virtual bool ShouldImportExportConfig()const noexcept;
 
+		// Format used to export the configuration, if not overrided defaults to JSON
+		virtual ConfigFormat_t GetConfigFormat()const noexcept;
+
 		// Exports all the configuration (Properties) of the library, can be overriden but usually is not needed
+		// Skipped when no property changed since the last import or export, serialized and written on the Application's background scheduler
 		virtual void ExportConfig()noexcept;
 		// Imports all the configuration (Properties) of the library, can be overriden but usually is not needed
 		virtual void ImportConfig()noexcept;
 
+		// Whether any stored property has changed since the last import or export
+		bool IsConfigDirty()const noexcept;
+
 	public:
+		// Fired once per PropertyTransaction commit with the properties of this library that changed
+		using PropertiesChangedEvent_t = Event<CSpan<IProperty*>>;
+
+		// Time spent on each step of InitLibrary
+		struct InitTimings
+		{
+			Duration_t Initialize{};
+			Duration_t Managers{};
+			Duration_t Properties{};
+			Duration_t ImportConfig{};
+			Duration_t Total{};
+		};
+
 		static constexpr Uuid LibraryUUID = Uuid{  };
 		static constexpr StringView LibraryName = StringView{ "Unknown Greaper Library" };
 
@@ -59,6 +88,14 @@ namespace greaper
 
 		void InitLibrary(PLibrary lib, PApplication app)noexcept;
 
+		/* InitLibrary split in its steps, called in this order. Initialize and the config import don't
+		*  touch the Application, so the Application may run them in parallel with other libraries,
+		*  registering the managers and the properties in it is done by a single thread */
+		void StartInitLibrary(PLibrary lib, PApplication app)noexcept;
+		void RegisterLibraryContents()noexcept;
+		void ImportLibraryConfig()noexcept;
+		void FinishInitLibrary()noexcept;
+
 		void DeinitLibrary()noexcept;
 
 		virtual const Uuid& GetLibraryUuid()const noexcept = 0;
@@ -75,8 +112,26 @@ namespace greaper
 
 		TResult<WIProperty> GetProperty(const StringView& name)const noexcept;
 
+		PropertiesChangedEvent_t& GetOnPropertiesChangedEvent()const noexcept;
+
+		// Blocks until the pending config export, if any, has been written
+		void WaitForConfigExport()noexcept;
+
+		/**
+		 * Reads the stored config again and applies, in a single PropertyTransaction, only
+		 * the properties whose stored value differs from the current one. Nothing is done
+		 * if the file content has not changed since the last import, export or reload.
+		 * Returns the amount of properties changed.
+		 */
+		TResult<sizet> ReloadConfig()noexcept;
+
 		virtual uint32 GetLibraryVersion()const noexcept = 0;
 
+		// Names of the libraries that must be initialized before this one, none by default
+		virtual Vector<StringView> GetLibraryDependencies()const noexcept;
+
+		const InitTimings& GetInitTimings()const noexcept;
+
 		bool IsInitialized()const noexcept;
 
 		InitState_t GetInitializationState()const noexcept;
@@ -97,19 +152,52 @@ namespace greaper
 
 	private:
 		PLibrary m_Library;
+		mutable Mutex m_LogMutex;	// Libraries log from any thread, ie. a config reload on the ConfigWatcher thread
 		mutable Vector<LogData> m_InitLogs;
 		PLogManager m_LogManager;
 		bool m_LogActivated = false;
 		IApplication::OnInterfaceActivationEvent_t::HandlerType m_OnNewLog;
 		IInterface::ActivationEvt_t::HandlerType m_OnLogActivation;
-		InitState_t m_InitializationState = InitState_t::Stopped;
+		mutable PropertiesChangedEvent_t m_OnPropertiesChanged{ "PropertiesChanged"sv };
+		std::atomic<InitState_t> m_InitializationState{ InitState_t::Stopped };	// Read by ReloadConfig from the ConfigWatcher thread
+		InitTimings m_InitTimings;
+
+		// Orders m_Managers so each interface comes after the ones it depends on
+		void SortManagersByDependencies()noexcept;
 
 		void OnNewLog(const PInterface& newInterface)noexcept;
 
 		void OnLogActivation(bool active, UNUSED IInterface* oldLog, const PInterface& newLog)noexcept;
 
+		void LogWithLevel(LogLevel_t level, const String& message)const noexcept;
+
+		void SetLogManager(PLogManager logManager)noexcept;
+
 		void DumpStoredLogs()noexcept;
 
+		// Property and its version at the moment of the last import or export
+		Vector<std::pair<const IProperty*, uint64>> m_ConfigVersions;
+		uint64 m_ConfigFileHash = 0;	// Hash of the config file content last imported or exported
+		std::future<TResult<uint64>> m_ConfigExportTask;	// Gives the hash of the written file
+		RecursiveMutex m_ConfigMutex;	// ReloadConfig may be called from a ConfigWatcher thread
+
+		static constexpr uint32 BinaryConfigMagic = 0x47464347; // 'GCFG'
+		static constexpr uint32 BinaryConfigVersion = 1;
+
+		void StoreConfigVersions()noexcept;
+		std::filesystem::path GetConfigFilePath(ConfigFormat_t format)const noexcept;
+		// Static so the export task can run them on a copy of the properties
+		static String SerializeConfigJSON(const Vector<PIProperty>& properties)noexcept;
+		static TResult<String> SerializeConfigBinary(const Vector<PIProperty>& properties)noexcept;
+		TResult<sizet> DeserializeConfigJSON(const String& text)noexcept;
+		TResult<sizet> DeserializeConfigBinary(const String& data)noexcept;
+		// Calls visitFn with the stream placed at the value of each known property stored in data
+		EmptyResult VisitConfigBinary(const String& data, const std::function<void(const PIProperty&, IStream&)>& visitFn)noexcept;
+		// Reads the stored config file, falling back to the other format, empty if there is none
+		TResult<String> ReadStoredConfig(ConfigFormat_t& format)const noexcept;
+		static EmptyResult WriteConfigFile(const std::filesystem::path& filePath, const String& data)noexcept;
+		static TResult<String> ReadConfigFile(const std::filesystem::path& filePath)noexcept;
+
 	protected:
 		PApplication m_Application;
 		Vector<PInterface> m_Managers;
@@ -140,6 +228,8 @@ namespace greaper
 #include "Base/IGreaperLibrary.inl"
 //// Property methods to avoid circle dependency
 #include "Base/Property.inl"
+#include "Base/PropertyTransaction.inl"
+#include "Base/PropertyRegistry.inl"
 //// Interface methods to avoid circle dependency
 #include "Base/IInterface.inl"
 
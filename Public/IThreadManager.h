@@ -32,11 +32,17 @@ namespace greaper
 
 		virtual TResult<PThread> CreateThread(const ThreadConfig& config)noexcept = 0;
 
+		// Creates every thread before starting any of them, if one fails none of them runs its function
+		virtual TResult<Vector<PThread>> CreateThreads(const Vector<ThreadConfig>& configs)noexcept = 0;
+
 		virtual ThreadCreationEvent_t& GetThreadCreationEvent()const noexcept = 0;
 
 		virtual ThreadDestructionEvent_t& GetThreadDestructionEvent()const noexcept = 0;
 
 		virtual void AccessThreads(const std::function<void(CSpan<PThread>)>& accessFn)const noexcept = 0;
+
+		// Stats of every running thread, the threads that cannot be queried are left out
+		virtual Vector<ThreadStats> GetThreadStats()const noexcept = 0;
 	};
 }
 
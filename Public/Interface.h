@@ -71,6 +71,21 @@ namespace greaper
 
 		virtual void DeinitProperties()noexcept = 0;
 
+		// UUIDs of the interfaces of the same library that must be initialized before this one
+		virtual Vector<Uuid> GetInterfaceDependencies()const noexcept;
+
+		// Update phases, called by the Application on each tick while the interface is active
+		virtual void PreUpdate()noexcept;
+
+		virtual void FixedUpdate()noexcept;
+
+		virtual void Update()noexcept;
+
+		virtual void PostUpdate()noexcept;
+
+		// Whether the update phases of this interface may run at the same time as the ones of other interfaces
+		virtual bool IsUpdateThreadSafe()const noexcept;
+
 		bool IsActive()const noexcept;
 		
 		bool IsInitialized()const noexcept;
@@ -89,7 +104,7 @@ namespace greaper
 		WGreaperLib m_Library;
 		mutable InitializationEvt_t m_InitEvent;
 		mutable ActivationEvt_t m_ActivationEvent;
-		Vector<WIProperty> m_Properties;
+		SmallVector<WIProperty, 8> m_Properties;
 
 	private:
 		InitState_t m_InitializationState;
@@ -21,12 +21,19 @@ namespace greaper
 	{
 		using Type = retType(*)(types...);
 	};
+	/**
+	 * @brief Owns an OS library handle, resolved symbols are cached per library so each one
+	 * is looked up in the OS only once, the cache is dropped when the library is closed.
+	 */
 	class Library
 	{
 		OSLibrary::LibraryHandle m_Handle;
+		mutable RWMutex m_SymbolMutex;
+		mutable Deque<String> m_SymbolNames;
+		mutable UnorderedMap<StringView, FuncPtr> m_SymbolCache;
 
 	public:
-		INLINE constexpr Library()noexcept
+		INLINE Library()noexcept
 			:m_Handle(nullptr)
 		{
 			
@@ -50,18 +57,24 @@ namespace greaper
 
 		}
 
-		constexpr INLINE Library(Library&& other)noexcept
+		INLINE Library(Library&& other)noexcept
 			:m_Handle(other.m_Handle)
 		{
+			LOCK(other.m_SymbolMutex);
+			m_SymbolNames = std::move(other.m_SymbolNames);
+			m_SymbolCache = std::move(other.m_SymbolCache);
 			other.m_Handle = nullptr;
 		}
 
-		constexpr INLINE Library& operator=(Library&& other)noexcept
+		INLINE Library& operator=(Library&& other)noexcept
 		{
 			if(this != &other)
 			{
 				Close();
+				LOCK(other.m_SymbolMutex);
 				m_Handle = other.m_Handle;
+				m_SymbolNames = std::move(other.m_SymbolNames);
+				m_SymbolCache = std::move(other.m_SymbolCache);
 				other.m_Handle = nullptr;
 			}
 			return *this;
@@ -103,6 +116,7 @@ namespace greaper
 		{
 			if (IsOpen())
 			{
+				ClearSymbolCache();
 				auto res = OSLibrary::Unload(m_Handle);
 				m_Handle = nullptr;
 				return res;
@@ -122,10 +136,43 @@ namespace greaper
 
 		inline TResult<FuncPtr> GetFunction(StringView funcName)const noexcept
 		{
-			if (IsOpen())
-				return OSLibrary::FuncLoad(m_Handle, std::move(funcName));
+			if (!IsOpen())
+				return Result::CreateFailure<FuncPtr>(Format("Couldn't obtain the function '%s', the library was closed.", funcName.data()));
+
+			{
+				SHAREDLOCK(m_SymbolMutex);
+				const auto it = m_SymbolCache.find(funcName);
+				if (it != m_SymbolCache.end())
+					return Result::CreateSuccess(it->second);
+			}
+
+			// FuncLoad expects a null-terminated name
+			const String name{ funcName };
+			auto res = OSLibrary::FuncLoad(m_Handle, StringView{ name });
+			if (res.HasFailed())
+				return res;
 
-			return Result::CreateFailure<FuncPtr>(Format("Couldn't obtain the function '%s', the library was closed.", funcName.data()));
+			LOCK(m_SymbolMutex);
+			const auto it = m_SymbolCache.find(funcName);
+			if (it != m_SymbolCache.end())
+				return Result::CreateSuccess(it->second);
+			const StringView cachedName = m_SymbolNames.emplace_back(name);
+			m_SymbolCache.insert_or_assign(cachedName, res.GetValue());
+			return res;
+		}
+
+		// Amount of symbols resolved so far
+		NODISCARD INLINE sizet GetCachedSymbolCount()const noexcept
+		{
+			SHAREDLOCK(m_SymbolMutex);
+			return m_SymbolCache.size();
+		}
+
+		INLINE void ClearSymbolCache()noexcept
+		{
+			LOCK(m_SymbolMutex);
+			m_SymbolCache.clear();
+			m_SymbolNames.clear();
 		}
 		
 		template<typename retType = void, class... types>
@@ -0,0 +1,120 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef CORE_LNX_CONSOLE_IO_H
+#define CORE_LNX_CONSOLE_IO_H 1
+
+#include "../PHAL.h"
+#include <limits.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+
+namespace greaper
+{
+	/*** Standard input and output of the process, multiplexed with poll
+	*	Wait blocks on stdin, on stdout when there's something to write, and on an
+	*	eventfd, so Wake can interrupt it from any thread. Read and Write are only
+	*	called after Wait reports the descriptor as ready, so they don't block.
+	*/
+	class LnxConsoleIO
+	{
+		int m_WakeFD = -1;
+		bool m_InputClosed = false;
+
+	public:
+		// Writes of up to this size don't block once stdout is reported as writable
+		static constexpr sizet MaxAtomicWrite = PIPE_BUF;
+
+		LnxConsoleIO()noexcept = default;
+		LnxConsoleIO(const LnxConsoleIO&) = delete;
+		LnxConsoleIO& operator=(const LnxConsoleIO&) = delete;
+
+		INLINE ~LnxConsoleIO()noexcept
+		{
+			Close();
+		}
+
+		INLINE EmptyResult Open()noexcept
+		{
+			Close();
+			m_WakeFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+			if (m_WakeFD < 0)
+				return Result::CreateFailure(Format("Couldn't create the wake eventfd, error: '%s'.", strerror(errno)));
+			m_InputClosed = false;
+			return Result::CreateSuccess();
+		}
+
+		INLINE void Close()noexcept
+		{
+			if (m_WakeFD >= 0)
+				close(m_WakeFD);
+			m_WakeFD = -1;
+		}
+
+		NODISCARD INLINE bool IsOpen()const noexcept { return m_WakeFD >= 0; }
+
+		/**
+		 * @brief Waits until stdin has data, stdout can be written if wantWrite is set,
+		 * Wake is called or the timeout expires, a negative timeout waits indefinitely.
+		 */
+		INLINE EmptyResult Wait(bool wantWrite, int32 timeoutMS, bool& readable, bool& writable)noexcept
+		{
+			readable = false;
+			writable = false;
+
+			pollfd fds[3];
+			fds[0] = pollfd{ m_WakeFD, POLLIN, 0 };
+			fds[1] = pollfd{ m_InputClosed ? -1 : STDIN_FILENO, POLLIN, 0 }; // Negative descriptors are ignored
+			fds[2] = pollfd{ wantWrite ? STDOUT_FILENO : -1, POLLOUT, 0 };
+			const auto ret = poll(fds, 3, timeoutMS);
+			if (ret < 0)
+			{
+				if (errno == EINTR)
+					return Result::CreateSuccess();
+				return Result::CreateFailure(Format("Couldn't poll the console, error: '%s'.", strerror(errno)));
+			}
+
+			if ((fds[0].revents & POLLIN) != 0)
+			{
+				uint64 count;
+				UNUSED auto readRet = read(m_WakeFD, &count, sizeof(count));
+			}
+
+			readable = (fds[1].revents & (POLLIN | POLLHUP)) != 0;
+			writable = (fds[2].revents & POLLOUT) != 0;
+			return Result::CreateSuccess();
+		}
+
+		// Returns the amount of bytes read, 0 once stdin is closed and negative on failure
+		INLINE ssizet Read(char* buffer, sizet size)noexcept
+		{
+			const auto ret = read(STDIN_FILENO, buffer, size);
+			if (ret == 0)
+				m_InputClosed = true; // poll would report stdin as readable forever
+			return (ssizet)ret;
+		}
+
+		INLINE ssizet Write(const char* data, sizet size)noexcept
+		{
+			return (ssizet)write(STDOUT_FILENO, data, Min(size, MaxAtomicWrite));
+		}
+
+		NODISCARD INLINE bool IsInputClosed()const noexcept { return m_InputClosed; }
+
+		INLINE void Wake()noexcept
+		{
+			if (m_WakeFD < 0)
+				return;
+			const uint64 one = 1;
+			UNUSED auto writeRet = write(m_WakeFD, &one, sizeof(one));
+		}
+	};
+
+	using OSConsoleIO = LnxConsoleIO;
+}
+
+#endif /* CORE_LNX_CONSOLE_IO_H */
@@ -0,0 +1,134 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef CORE_LNX_DIRECTORY_WATCHER_H
+#define CORE_LNX_DIRECTORY_WATCHER_H 1
+
+#include "../PHAL.h"
+#include <filesystem>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+
+namespace greaper
+{
+	/*** Notifies about files written or moved into a directory, based on inotify
+	*	Wait blocks on both the inotify descriptor and an eventfd, so Wake can
+	*	interrupt it from any thread.
+	*/
+	class LnxDirectoryWatcher
+	{
+		int m_NotifyFD = -1;
+		int m_WakeFD = -1;
+		int m_WatchFD = -1;
+
+	public:
+		LnxDirectoryWatcher()noexcept = default;
+		LnxDirectoryWatcher(const LnxDirectoryWatcher&) = delete;
+		LnxDirectoryWatcher& operator=(const LnxDirectoryWatcher&) = delete;
+
+		INLINE ~LnxDirectoryWatcher()noexcept
+		{
+			Close();
+		}
+
+		INLINE EmptyResult Open(const std::filesystem::path& directory)noexcept
+		{
+			Close();
+			m_NotifyFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+			if (m_NotifyFD < 0)
+				return Result::CreateFailure(Format("Couldn't initialize inotify, error: '%s'.", strerror(errno)));
+
+			m_WakeFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+			if (m_WakeFD < 0)
+			{
+				const auto msg = Format("Couldn't create the wake eventfd, error: '%s'.", strerror(errno));
+				Close();
+				return Result::CreateFailure(msg);
+			}
+
+			// Editors either rewrite the file in place or rename a temporal over it
+			m_WatchFD = inotify_add_watch(m_NotifyFD, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+			if (m_WatchFD < 0)
+			{
+				const auto msg = Format("Couldn't watch the directory '%s', error: '%s'.", directory.c_str(), strerror(errno));
+				Close();
+				return Result::CreateFailure(msg);
+			}
+			return Result::CreateSuccess();
+		}
+
+		INLINE void Close()noexcept
+		{
+			if (m_NotifyFD >= 0)
+				close(m_NotifyFD);
+			if (m_WakeFD >= 0)
+				close(m_WakeFD);
+			m_NotifyFD = -1;
+			m_WakeFD = -1;
+			m_WatchFD = -1;
+		}
+
+		NODISCARD INLINE bool IsOpen()const noexcept { return m_WatchFD >= 0; }
+
+		/**
+		 * @brief Waits until a file is modified, Wake is called or the timeout expires,
+		 * a negative timeout waits indefinitely. The names of the modified files are
+		 * appended to fileNames.
+		 */
+		INLINE EmptyResult Wait(Vector<String>& fileNames, int32 timeoutMS)noexcept
+		{
+			pollfd fds[2];
+			fds[0] = pollfd{ m_NotifyFD, POLLIN, 0 };
+			fds[1] = pollfd{ m_WakeFD, POLLIN, 0 };
+			const auto ret = poll(fds, 2, timeoutMS);
+			if (ret < 0)
+			{
+				if (errno == EINTR)
+					return Result::CreateSuccess();
+				return Result::CreateFailure(Format("Couldn't poll the watched directory, error: '%s'.", strerror(errno)));
+			}
+
+			if ((fds[1].revents & POLLIN) != 0)
+			{
+				uint64 count;
+				UNUSED auto readRet = read(m_WakeFD, &count, sizeof(count));
+			}
+
+			if ((fds[0].revents & POLLIN) == 0)
+				return Result::CreateSuccess();
+
+			alignas(inotify_event) char buffer[4096];
+			while (true)
+			{
+				const auto length = read(m_NotifyFD, buffer, sizeof(buffer));
+				if (length <= 0)
+					break; // EAGAIN, everything has been read
+				for (ssizet offset = 0; offset < length;)
+				{
+					const auto* evt = (const inotify_event*)(buffer + offset);
+					if (evt->len > 0 && (evt->mask & IN_ISDIR) == 0)
+						fileNames.emplace_back(evt->name);
+					offset += sizeof(inotify_event) + evt->len;
+				}
+			}
+			return Result::CreateSuccess();
+		}
+
+		INLINE void Wake()noexcept
+		{
+			if (m_WakeFD < 0)
+				return;
+			const uint64 one = 1;
+			UNUSED auto writeRet = write(m_WakeFD, &one, sizeof(one));
+		}
+	};
+
+	using OSDirectoryWatcher = LnxDirectoryWatcher;
+}
+
+#endif /* CORE_LNX_DIRECTORY_WATCHER_H */
@@ -10,6 +10,10 @@
 #include "../IApplication.h"
 #include "../Platform.h"
 #include "../IThreadManager.h"
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
 
 namespace greaper
 {
@@ -21,11 +25,17 @@ namespace greaper
 		std::atomic_int8_t m_State;
         std::function<void()> m_ThreadFn;
         bool m_JoinsAtDestruction;
+		bool m_NeedsJoin;
         String m_Name;
 		IInterface::ActivationEvt_t::HandlerType m_OnManagerActivation;
 		IApplication::OnInterfaceActivationEvent_t::HandlerType m_OnNewManager;
 		PThread m_This;
-		Barrier m_Barrier;
+		Gate m_StartGate;
+		std::atomic<pid_t> m_NativeID;
+		String m_StartError;
+		// Only set when the thread has to apply a nice value, it opens m_NiceGate once it has tried
+		int32 m_NiceValue;
+		mutable Gate m_NiceGate;
 
 		static INLINE void* RunFn(void* data)
 		{
@@ -34,23 +44,38 @@ namespace greaper
 			if (lnxThread == nullptr)
 				return nullptr;
 
-			if(!lnxThread->m_Manager.expired())
+			const auto nativeID = (pid_t)syscall(SYS_gettid);
+			lnxThread->m_NativeID.store(nativeID, std::memory_order_release);
+
+			// The nice value can only be set by kernel ID, the thread sets its own while its creator goes on
+			if (lnxThread->m_NiceValue != 0)
 			{
-				auto mgr = lnxThread->m_Manager.lock();
-				mgr->GetThreadCreationEvent().Trigger(lnxThread);
+				if (setpriority(PRIO_PROCESS, (id_t)nativeID, lnxThread->m_NiceValue) != 0)
+				{
+					lnxThread->m_StartError = Format("Trying to set the nice value %d to the thread '%s', but something went wrong, error:'%s'.",
+						lnxThread->m_NiceValue, lnxThread->m_Name.c_str(), strerror(errno));
+				}
+				lnxThread->m_NiceGate.Open();
 			}
 
-			while (lnxThread->GetState() != ThreadState_t::RUNNING)
-				THREAD_YIELD();
+			lnxThread->m_StartGate.Wait();
 
-			lnxThread->m_Barrier.sync();
+			// Discarded threads and the ones that couldn't get their nice value finish without being announced
+			const bool started = lnxThread->m_ThreadFn != nullptr && lnxThread->m_StartError.empty();
+			if (started)
+			{
+				if (!lnxThread->m_Manager.expired())
+				{
+					auto mgr = lnxThread->m_Manager.lock();
+					mgr->GetThreadCreationEvent().Trigger(lnxThread);
+				}
 
-			if(lnxThread->m_ThreadFn != nullptr)
 				lnxThread->m_ThreadFn();
+			}
 
 			lnxThread->m_State = ThreadState_t::STOPPED;
 
-			if (!lnxThread->m_Manager.expired())
+			if (started && !lnxThread->m_Manager.expired())
 			{
 				auto mgr = lnxThread->m_Manager.lock();
 				mgr->GetThreadDestructionEvent().Trigger(lnxThread);
@@ -100,19 +125,169 @@ namespace greaper
 			m_OnNewManager.Disconnect();
 		}
 
+		static INLINE int GetNativePolicy(ThreadSchedPolicy_t policy)noexcept
+		{
+			switch (policy)
+			{
+			case ThreadSchedPolicy_t::Batch: return SCHED_BATCH;
+			case ThreadSchedPolicy_t::Idle: return SCHED_IDLE;
+			case ThreadSchedPolicy_t::FIFO: return SCHED_FIFO;
+			case ThreadSchedPolicy_t::RoundRobin: return SCHED_RR;
+			default: return SCHED_OTHER;
+			}
+		}
+
+		static INLINE bool IsRealTimePolicy(ThreadSchedPolicy_t policy)noexcept
+		{
+			return policy == ThreadSchedPolicy_t::FIFO || policy == ThreadSchedPolicy_t::RoundRobin;
+		}
+
+		// Real-time policies are set through the attributes, so a thread that cannot have them is never created
+		INLINE String SetSchedulingAttributes(pthread_attr_t& threadAttrib, const ThreadScheduling& scheduling)const noexcept
+		{
+			if (!IsRealTimePolicy(scheduling.Policy))
+				return {};
+
+			const int policy = GetNativePolicy(scheduling.Policy);
+			const int minPriority = sched_get_priority_min(policy);
+			const int maxPriority = sched_get_priority_max(policy);
+			if (scheduling.Priority < minPriority || scheduling.Priority > maxPriority)
+			{
+				return Format("Trying to create the thread '%s' with the %s policy, but its priority %d is outside [%d, %d].",
+					m_Name.c_str(), TEnum<ThreadSchedPolicy_t>::ToString(scheduling.Policy).data(), scheduling.Priority, minPriority, maxPriority);
+			}
+
+			sched_param param{};
+			param.sched_priority = scheduling.Priority;
+			// Without explicit scheduling the thread would take the policy of its creator
+			auto ret = pthread_attr_setinheritsched(&threadAttrib, PTHREAD_EXPLICIT_SCHED);
+			if (ret == 0)
+				ret = pthread_attr_setschedpolicy(&threadAttrib, policy);
+			if (ret == 0)
+				ret = pthread_attr_setschedparam(&threadAttrib, &param);
+			if (ret != 0)
+			{
+				return Format("Trying to create the thread '%s' with the %s policy, but something went wrong setting its attributes, error:'%s'.",
+					m_Name.c_str(), TEnum<ThreadSchedPolicy_t>::ToString(scheduling.Policy).data(), strerror(ret));
+			}
+			return {};
+		}
+
+		// Batch and Idle are not accepted by the thread attributes, they are applied once the thread exists, while it waits to run its function
+		INLINE String SetTimeSharedPolicy(const ThreadScheduling& scheduling)noexcept
+		{
+			if (scheduling.Policy != ThreadSchedPolicy_t::Batch && scheduling.Policy != ThreadSchedPolicy_t::Idle)
+				return {};
+
+			const sched_param param{};
+			const auto ret = pthread_setschedparam(m_Handle, GetNativePolicy(scheduling.Policy), &param);
+			if (ret != 0)
+			{
+				return Format("Trying to set the %s policy to the thread '%s', but something went wrong, error:'%s'.",
+					TEnum<ThreadSchedPolicy_t>::ToString(scheduling.Policy).data(), m_Name.c_str(), strerror(ret));
+			}
+			return {};
+		}
+
+		// Real-time and Idle threads ignore the nice value
+		static INLINE int32 GetAppliedNiceValue(const ThreadScheduling& scheduling)noexcept
+		{
+			if (IsRealTimePolicy(scheduling.Policy) || scheduling.Policy == ThreadSchedPolicy_t::Idle)
+				return 0;
+			return scheduling.NiceValue;
+		}
+
+		// Reads a whole procfs file into buffer, which is always null terminated, returns the length read
+		static INLINE sizet ReadProcFile(const char* path, char* buffer, sizet bufferSize)noexcept
+		{
+			const int fd = open(path, O_RDONLY | O_CLOEXEC);
+			if (fd < 0)
+			{
+				buffer[0] = '\0';
+				return 0;
+			}
+			sizet size = 0;
+			while (size + 1 < bufferSize)
+			{
+				const auto ret = read(fd, buffer + size, bufferSize - size - 1);
+				if (ret < 0 && errno == EINTR)
+					continue;
+				if (ret <= 0)
+					break;
+				size += (sizet)ret;
+			}
+			close(fd);
+			buffer[size] = '\0';
+			return size;
+		}
+
+		static INLINE uint64 ParseStatusField(const char* status, const char* field)noexcept
+		{
+			const char* line = strstr(status, field);
+			if (line == nullptr)
+				return 0;
+			return strtoull(line + strlen(field), nullptr, 10);
+		}
+
+		static INLINE void ReadSchedulingStats(pid_t nativeID, ThreadStats& stats)noexcept
+		{
+			char path[64];
+			char buffer[4096];
+
+			snprintf(path, sizeof(path), "/proc/self/task/%d/stat", (int)nativeID);
+			if (ReadProcFile(path, buffer, sizeof(buffer)) > 0)
+			{
+				// The name of field 2 is between parentheses and may contain spaces, the fields are counted from its end
+				const char* field = strrchr(buffer, ')');
+				if (field != nullptr && field[1] == ' ')
+				{
+					++field;
+					uint64 utime = 0, stime = 0;
+					for (int32 index = 3; field != nullptr && index <= 39; ++index)
+					{
+						++field; // Skip the separator
+						if (index == 14)
+							utime = strtoull(field, nullptr, 10);
+						else if (index == 15)
+							stime = strtoull(field, nullptr, 10);
+						else if (index == 39)
+							stats.LastCPU = (int32)strtol(field, nullptr, 10);
+						field = strchr(field, ' ');
+					}
+					const auto ticksPerSecond = (uint64)sysconf(_SC_CLK_TCK);
+					if (ticksPerSecond > 0)
+					{
+						stats.UserTime = std::chrono::nanoseconds(utime * 1000000000ull / ticksPerSecond);
+						stats.SystemTime = std::chrono::nanoseconds(stime * 1000000000ull / ticksPerSecond);
+					}
+				}
+			}
+
+			// The context switch counters are only given by the status file
+			snprintf(path, sizeof(path), "/proc/self/task/%d/status", (int)nativeID);
+			if (ReadProcFile(path, buffer, sizeof(buffer)) > 0)
+			{
+				stats.VoluntaryContextSwitches = ParseStatusField(buffer, "\nvoluntary_ctxt_switches:");
+				stats.InvoluntaryContextSwitches = ParseStatusField(buffer, "\nnonvoluntary_ctxt_switches:");
+			}
+		}
+
 	public:
 		INLINE LnxThreadImpl(WThreadManager manager, PThread self, const ThreadConfig& config)noexcept
 			:m_Manager(std::move(manager))
 			,m_State(ThreadState_t::SUSPENDED)
             ,m_ThreadFn(config.ThreadFN)
             ,m_JoinsAtDestruction(config.JoinAtDestruction)
+			,m_NeedsJoin(false)
             ,m_Name(config.Name)
 			,m_This(std::move(self))
-			,m_Barrier(2)
+			,m_NativeID(0)
+			,m_NiceValue(GetAppliedNiceValue(config.Scheduling))
 		{
 			if (m_Manager == nullptr || m_ThreadFn == nullptr)
 			{
 				m_State = ThreadState_t::STOPPED;
+				m_NiceValue = 0;
 				return;
 			}
 
@@ -125,20 +300,47 @@ namespace greaper
 				ret = pthread_attr_setstacksize(&threadAttrib, config.StackSize);
 				VerifyEqual(ret, 0, "Trying to create a thread, but something went wrong setting it stack size, error:'%d'.", ret);
 			}
-			
-			ret = pthread_create(&m_Handle, &threadAttrib, &LnxThreadImpl::RunFn, &m_This);
-			VerifyEqual(ret, 0, "Trying to create a thread, but something went wrong, error:'%d'.", ret);
 
-			ret = pthread_setname_np(m_Handle, m_Name.c_str());
+			m_StartError = SetSchedulingAttributes(threadAttrib, config.Scheduling);
+			if (m_StartError.empty())
+			{
+				ret = pthread_create(&m_Handle, &threadAttrib, &LnxThreadImpl::RunFn, &m_This);
+				if (ret != 0)
+				{
+					m_StartError = Format("Trying to create the thread '%s', but something went wrong, error:'%s'.", m_Name.c_str(), strerror(ret));
+					if (ret == EPERM)
+						m_StartError.append(" The scheduling policy requires privileges.");
+				}
+			}
+			pthread_attr_destroy(&threadAttrib);
 
-			ret = pthread_attr_destroy(&threadAttrib);
+			if (!m_StartError.empty())
+			{
+				m_State = ThreadState_t::STOPPED;
+				m_NiceValue = 0;
+				m_This.reset();
+				return;
+			}
+
+			ret = pthread_setname_np(m_Handle, m_Name.c_str());
 
 			m_ID = m_Handle;
-			if (!config.StartSuspended)
+			m_NeedsJoin = true;
+
+			auto policyError = SetTimeSharedPolicy(config.Scheduling);
+			if (!policyError.empty())
 			{
-				m_State = ThreadState_t::RUNNING;
-				m_Barrier.sync();
+				// The thread may still be writing its own error, so it's only replaced once it's done
+				if (m_NiceValue != 0)
+					m_NiceGate.Wait();
+				m_StartError = std::move(policyError);
+				Discard();
+				return;
 			}
+
+			// The thread doesn't need to be waited, it only waits for the gate to be opened
+			if (!config.StartSuspended)
+				Resume();
 		}
 
 		INLINE LnxThreadImpl(WThreadManager manager, ThreadHandle handle, ThreadID_t id, StringView name, bool setName = false)noexcept
@@ -148,8 +350,14 @@ namespace greaper
 			,m_State(ThreadState_t::UNMANAGED)
 			,m_ThreadFn(nullptr)
 			,m_JoinsAtDestruction(false)
+			,m_NeedsJoin(false)
 			,m_Name(name)
+			,m_NativeID(0)
+			,m_NiceValue(0)
 		{
+			// The kernel ID can only be known from the thread itself
+			if (pthread_equal(m_Handle, pthread_self()))
+				m_NativeID = (pid_t)syscall(SYS_gettid);
 			if (setName)
 			{
 				auto err = pthread_setname_np(m_Handle, m_Name.c_str());
@@ -162,45 +370,59 @@ namespace greaper
 
 		INLINE ~LnxThreadImpl()noexcept
 		{
-			if (m_JoinsAtDestruction && Joinable())
+			if (!m_NeedsJoin)
+				return;
+			// The last reference may be released by the thread itself, which cannot join itself
+			if (m_JoinsAtDestruction && !pthread_equal(m_Handle, pthread_self()))
 				Join();
+			else
+				pthread_detach(m_Handle);
 		}
 
 		INLINE void Detach()noexcept
 		{
-			auto ret = pthread_detach(m_Handle);
-			VerifyEqual(ret, 0, "Trying to detach a thread, but something went wrong, error:'%d'.", ret);
+			if (m_NeedsJoin)
+			{
+				auto ret = pthread_detach(m_Handle);
+				VerifyEqual(ret, 0, "Trying to detach a thread, but something went wrong, error:'%d'.", ret);
+				m_NeedsJoin = false;
+			}
 			m_State = ThreadState_t::UNMANAGED;
 			m_JoinsAtDestruction = false;
 		}
 
+		// A thread that already stopped is still joined, so its resources are given back
 		INLINE void Join()noexcept
 		{
-			if (m_State == ThreadState_t::STOPPED)
+			if (!m_NeedsJoin)
 				return;
 
 			Verify(Joinable(), "Trying to join a non-joinable thread");
 			void* thRet = nullptr;
 			auto ret = pthread_join(m_Handle, &thRet);
 			VerifyEqual(ret, 0, "Trying to join a thread, but something went wrong, error:'%d'.", ret);
+			m_NeedsJoin = false;
 		}
 
 		INLINE bool Joinable()const noexcept 
 		{
-			return m_State == ThreadState_t::RUNNING;
+			return m_NeedsJoin && GetState() != ThreadState_t::SUSPENDED;
 		}
 
 		INLINE bool TryJoin()noexcept
 		{
-			if (m_State == ThreadState_t::STOPPED)
-				return true;
+			if (!m_NeedsJoin)
+				return GetState() == ThreadState_t::STOPPED;
 
 			if (!Joinable())
 				return false;
 
 			void* thRet = nullptr;
 			auto ret = pthread_tryjoin_np(m_Handle, &thRet);
-			return ret == 0;
+			if (ret != 0)
+				return false;
+			m_NeedsJoin = false;
+			return true;
 		}
 
 		INLINE ThreadHandle GetOSHandle()const noexcept  { return m_Handle; }
@@ -219,7 +441,23 @@ namespace greaper
 				return;
 
 			m_State = ThreadState_t::RUNNING;
-			m_Barrier.sync();
+			m_StartGate.Open();
+		}
+
+		// A suspended thread finishes without running its function, nobody has to join it
+		INLINE void Discard()noexcept
+		{
+			if (GetState() != ThreadState_t::SUSPENDED)
+				return;
+
+			m_ThreadFn = nullptr;
+			m_JoinsAtDestruction = false;
+			if (m_NeedsJoin)
+			{
+				pthread_detach(m_Handle);
+				m_NeedsJoin = false;
+			}
+			Resume();
 		}
 
 		INLINE ThreadID_t GetID()const noexcept  { return m_ID; }
@@ -229,5 +467,48 @@ namespace greaper
 		INLINE const String& GetName()const noexcept  { return m_Name; }
 
 		INLINE ThreadState_t GetState()const noexcept  { return (ThreadState_t)m_State.load(); }
+
+		/**
+		 * Whether the thread was created with the requested configuration, if it has to set its
+		 * nice value this waits until it has tried, a thread that failed never runs its function.
+		 */
+		INLINE EmptyResult GetStartResult()const noexcept
+		{
+			if (m_NiceValue != 0)
+				m_NiceGate.Wait();
+			if (m_StartError.empty())
+				return Result::CreateSuccess();
+			return Result::CreateFailure(m_StartError);
+		}
+
+		/**
+		 * @brief Queries the CPU time, the user and system time, the context switches and the
+		 * last CPU of the thread. The CPU time comes from the thread clock, with nanosecond
+		 * precision, the rest from procfs, user and system time only have clock tick precision.
+		 */
+		INLINE TResult<ThreadStats> GetStats()const noexcept
+		{
+			if (GetState() == ThreadState_t::STOPPED)
+				return Result::CreateFailure<ThreadStats>(Format("Trying to get the stats of the thread '%s', but it has already stopped.", m_Name.c_str()));
+
+			ThreadStats stats;
+			stats.ID = m_ID;
+			stats.Name = m_Name;
+
+			clockid_t clockID;
+			const auto ret = pthread_getcpuclockid(m_Handle, &clockID);
+			if (ret != 0)
+				return Result::CreateFailure<ThreadStats>(Format("Trying to get the CPU clock of the thread '%s', but something went wrong, error:'%d'.", m_Name.c_str(), ret));
+			timespec cpuTime;
+			if (clock_gettime(clockID, &cpuTime) != 0)
+				return Result::CreateFailure<ThreadStats>(Format("Trying to read the CPU clock of the thread '%s', but something went wrong, error:'%s'.", m_Name.c_str(), strerror(errno)));
+			stats.CPUTime = std::chrono::seconds(cpuTime.tv_sec) + std::chrono::nanoseconds(cpuTime.tv_nsec);
+
+			// Until the thread starts running its kernel ID is unknown
+			const auto nativeID = m_NativeID.load(std::memory_order_acquire);
+			if (nativeID > 0)
+				ReadSchedulingStats(nativeID, stats);
+			return Result::CreateSuccess(stats);
+		}
 	};
 }
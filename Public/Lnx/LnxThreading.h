@@ -9,6 +9,10 @@
 #define CORE_LNX_THREADING_H 1
 
 #include "../CorePrerequisites.h"
+#include <atomic>
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
 
 namespace greaper
 {
@@ -252,6 +256,26 @@ namespace greaper
 			}
 		};
 		using SignalImpl = LnxSignalImpl;
+
+		struct LnxAddressWaitImpl
+		{
+			static_assert(sizeof(std::atomic<uint32>) == sizeof(uint32), "The futex word must be a plain 32bit integer.");
+
+			// Blocks while the value at the address equals expected, it may return spuriously
+			INLINE static void Wait(const std::atomic<uint32>& value, uint32 expected) noexcept
+			{
+				syscall(SYS_futex, (const uint32*)&value, FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+			}
+			INLINE static void WakeOne(std::atomic<uint32>& value) noexcept
+			{
+				syscall(SYS_futex, (uint32*)&value, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+			}
+			INLINE static void WakeAll(std::atomic<uint32>& value) noexcept
+			{
+				syscall(SYS_futex, (uint32*)&value, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+			}
+		};
+		using AddressWaitImpl = LnxAddressWaitImpl;
 	}
 }
 
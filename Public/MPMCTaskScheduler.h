@@ -57,11 +57,15 @@ namespace greaper
 		};
 	}
 
+	// Handles of a batch of tasks, small batches are kept inline
+	using TaskHandles_t = SmallVector<Impl::HTask, 8>;
+
 	class MPMCTaskScheduler
 	{
 	public:
+		// Fails if the workers couldn't be created, ie. a ThreadScheduling the process isn't allowed to use
 		template<class _Alloc_ = GenericAllocator>
-		static PTaskScheduler Create(WThreadManager threadMgr, StringView name, sizet workerCount, bool allowGrowth = true)noexcept;
+		static TResult<PTaskScheduler> Create(WThreadManager threadMgr, StringView name, sizet workerCount, bool allowGrowth = true, ThreadScheduling scheduling = {})noexcept;
 
 		~MPMCTaskScheduler()noexcept;
 
@@ -73,7 +77,7 @@ namespace greaper
 
 		TResult<Impl::HTask> AddTask(StringView name, std::function<void()> workFn)noexcept;
 
-		TResult<Vector<Impl::HTask>> AddTasks(const Vector<std::tuple<StringView, std::function<void()>>>& tasks)noexcept;
+		TResult<TaskHandles_t> AddTasks(const Vector<std::tuple<StringView, std::function<void()>>>& tasks)noexcept;
 
 		void WaitUntilTaskIsFinish(const Impl::HTask& hTask)noexcept;
 		void WaitUntilAllTasksFinished()noexcept;
@@ -83,12 +87,16 @@ namespace greaper
 		bool IsGrowthEnabled()const noexcept;
 		void EnableGrowth(bool enable)noexcept;
 
+		// Scheduling of the workers, ThreadScheduling::Background() or ThreadScheduling::Latency() for the usual classes
+		const ThreadScheduling& GetScheduling()const noexcept;
+
 	private:
 		WThreadManager m_ThreadManager;
 		String m_Name;
 
 		Vector<PThread> m_TaskWorkers;
 		mutable RWMutex m_TaskWorkersMutex;
+		Mutex m_WorkerCountMutex;
 
 		Deque<SPtr<Impl::Task>> m_TaskQueue;
 		mutable Mutex m_TaskQueueMutex;
@@ -99,6 +107,7 @@ namespace greaper
 
 		SPtr<MPMCTaskScheduler> m_This;
 		bool m_AllowGrowth;
+		ThreadScheduling m_Scheduling;
 
 		IInterface::ActivationEvt_t::HandlerType m_OnManagerActivation;
 		IApplication::OnInterfaceActivationEvent_t::HandlerType m_OnNewManager;
@@ -110,7 +119,7 @@ namespace greaper
 
 		bool AreThereAnyAvailableWorker()const noexcept;
 		
-		MPMCTaskScheduler(WThreadManager threadMgr, StringView name, sizet workerCount, bool allowGrowth)noexcept;
+		MPMCTaskScheduler(WThreadManager threadMgr, StringView name, ThreadScheduling scheduling)noexcept;
 
 		bool CanWorkerContinueWorking(sizet workerID)const noexcept;
 
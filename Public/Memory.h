@@ -68,6 +68,8 @@ namespace greaper
 #include "Platform.h"
 
 #include "Base/Span.h"
+#include "Base/FlatMap.h"
+#include "Base/SmallVector.h"
 
 namespace greaper::Impl
 {
@@ -59,6 +59,9 @@ namespace greaper
 		void Close()noexcept override;
 
 		uint8* DisownMemory()noexcept;
+
+		/* Ensures that at least bytes of capacity are available without reallocating, reallocates to exactly bytes if needed */
+		void Reserve(sizet bytes)noexcept;
 	};
 }
 
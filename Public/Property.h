@@ -20,6 +20,9 @@
 
 namespace greaper
 {
+	class IPropertyChange;
+	using PPropertyChange = SPtr<IPropertyChange>;
+
 	/**
 	* @brief Base property interface, provides the foundation to use properties
 	* without the templated interaction.
@@ -43,6 +46,7 @@ namespace greaper
 		virtual ModificationEvent_t& GetOnModificationEvent()const noexcept = 0;
 		virtual const WGreaperLib& GetLibrary()const noexcept = 0;
 		virtual std::size_t GetValueHash()const noexcept = 0;
+		virtual uint64 GetVersion()const noexcept = 0;
 		virtual const ReflectedTypeID_t& _ValueTypeID()const noexcept = 0;
 		virtual TResult<ssizet> _ValueToStream(IStream& stream)const noexcept = 0;
 		virtual TResult<ssizet> _ValueFromStream(IStream& stream)noexcept = 0;
@@ -50,8 +54,32 @@ namespace greaper
 		virtual EmptyResult _ValueFromJSON(cJSON* json, StringView name)noexcept = 0;
 		virtual int64 _GetDynamicSize()const noexcept = 0;
 		virtual int64 _GetStaticSize()const noexcept = 0;
+		virtual TResult<PPropertyChange> _CreateChangeFromString(const String& value)noexcept = 0;
+		virtual TResult<PPropertyChange> _CreateChangeFromJSON(cJSON* json, StringView name)noexcept = 0;
+		virtual TResult<PPropertyChange> _CreateChangeFromStream(IStream& stream)noexcept = 0;
 	};
 
+	/**
+	 * @brief A staged value for a property, used by PropertyTransaction.
+	 * _Validate and _Apply must be called with the property mutex locked.
+	 */
+	class IPropertyChange
+	{
+	public:
+		virtual ~IPropertyChange() = default;
+
+		virtual IProperty* GetProperty()const noexcept = 0;
+		virtual RWMutex& _GetMutex()const noexcept = 0;
+		// Whether the staged value differs from the current one, takes the property mutex for reading
+		virtual bool _Differs()const noexcept = 0;
+		// Checks constness and runs the validator, nothing is modified
+		virtual EmptyResult _Validate()noexcept = 0;
+		// Stores the validated value, returns whether the property changed
+		virtual bool _Apply()noexcept = 0;
+	};
+
+	template<class T> class TPropertyChange;
+
 	template<class T, class _Alloc_ = GenericAllocator>
 	TResult<PProperty<T>> CreateProperty(WGreaperLib library, StringView propertyName, T initialValue, StringView propertyInfo = {},
 		bool isConstant = false, bool isStatic = false, SPtr<TPropertyValidator<T>> validator = SPtr<TPropertyValidator<T>>());
@@ -75,10 +103,24 @@ namespace greaper
 	template<class T>
 	class TProperty final : public IProperty
 	{
+	public:
+		/**
+		 * Small trivially copyable values are mirrored on a SeqLockValue, so
+		 * GetValueCopy and AccessValue read them without touching m_Mutex.
+		 */
+		static constexpr bool HasLockFreeRead = std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T> && sizeof(T) <= 16;
+
+	private:
+		struct NoPublishedValue {};
+
 		T m_Value;
+		std::conditional_t<HasLockFreeRead, SeqLockValue<T>, NoPublishedValue> m_PublishedValue;
 		String m_PropertyName;
 		String m_PropertyInfo;
-		String m_StringValue;	// When a property is changed, needs to update this value
+		mutable String m_StringValue;	// Lazily rebuilt when m_StringVersion falls behind m_Version
+		mutable uint64 m_StringVersion;
+		mutable Mutex m_StringMutex;
+		std::atomic<uint64> m_Version;	// Increased on each value change, under m_Mutex
 		mutable ModificationEvent_t m_OnModificationEvent;
 		SPtr<TPropertyValidator<T>> m_PropertyValidator;
 		WGreaperLib m_Library;
@@ -93,7 +135,12 @@ namespace greaper
 		template<class _T_, class _Alloc_>
 		friend TResult<PProperty<T>> CreateProperty(WGreaperLib library, StringView propertyName, _T_ initialValue, StringView propertyInfo,
 			bool isConstant, bool isStatic, SPtr<TPropertyValidator<T>> validator);
+		friend class TPropertyChange<T>;
 		MemoryFriend();
+
+		void _UpdateStringValue()const noexcept;
+		bool _StoreValue(const T& newValue)noexcept;
+
 	public:
 		using value_type = T;
 
@@ -123,6 +170,68 @@ namespace greaper
 		ModificationEvent_t& GetOnModificationEvent()const noexcept override;
 		const WGreaperLib& GetLibrary()const noexcept override;
 		std::size_t GetValueHash()const noexcept override;
+		uint64 GetVersion()const noexcept override;
+		TResult<PPropertyChange> _CreateChangeFromString(const String& value)noexcept override;
+		TResult<PPropertyChange> _CreateChangeFromJSON(cJSON* json, StringView name)noexcept override;
+		TResult<PPropertyChange> _CreateChangeFromStream(IStream& stream)noexcept override;
+	};
+
+	template<class T>
+	class TPropertyChange final : public IPropertyChange
+	{
+		TProperty<T>* m_Property;	// Kept alive by the owner of the change
+		T m_StagedValue;
+		T m_ValidatedValue;
+
+	public:
+		TPropertyChange(TProperty<T>* prop, T value)noexcept;
+
+		IProperty* GetProperty()const noexcept override;
+		RWMutex& _GetMutex()const noexcept override;
+		bool _Differs()const noexcept override;
+		EmptyResult _Validate()noexcept override;
+		bool _Apply()noexcept override;
+	};
+
+	/**
+	 * @brief Cached handle to a property, meant to be kept by the code that reads
+	 * it on hot paths. The property is pinned on acquisition, so reads neither lock
+	 * a WPtr nor, for lock-free properties, take the property mutex.
+	 * Must be reset once the owner stops using the property.
+	 */
+	template<class T>
+	class TPropertyAccessor
+	{
+		PProperty<T> m_Property;
+
+	public:
+		TPropertyAccessor()noexcept = default;
+		INLINE explicit TPropertyAccessor(PProperty<T> prop)noexcept
+			:m_Property(std::move(prop))
+		{
+
+		}
+		INLINE explicit TPropertyAccessor(const WProperty<T>& prop)noexcept
+			:m_Property(prop.lock())
+		{
+
+		}
+
+		NODISCARD INLINE T Get()const noexcept
+		{
+			VerifyNotNull(m_Property.get(), "Trying to read from an empty property accessor.");
+			return m_Property->GetValueCopy();
+		}
+		INLINE bool Set(const T& value, bool triggerEvent = true)const noexcept
+		{
+			VerifyNotNull(m_Property.get(), "Trying to write to an empty property accessor.");
+			return m_Property->SetValue(value, triggerEvent);
+		}
+
+		NODISCARD INLINE TProperty<T>* operator->()const noexcept { return m_Property.get(); }
+		NODISCARD INLINE const PProperty<T>& GetProperty()const noexcept { return m_Property; }
+		NODISCARD INLINE bool IsValid()const noexcept { return m_Property != nullptr; }
+		INLINE void Reset()noexcept { m_Property.reset(); }
 	};
 }
 
@@ -0,0 +1,96 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef CORE_PROPERTY_REGISTRY_H
+#define CORE_PROPERTY_REGISTRY_H 1
+
+#include "Property.h"
+#include "Concurrency.h"
+
+namespace greaper
+{
+	using PropertyID_t = uint32;
+	static constexpr PropertyID_t InvalidPropertyID = std::numeric_limits<PropertyID_t>::max();
+
+	/**
+	 * @brief Process-wide index of every registered property, owned by the Application.
+	 * Each property is keyed by its interned "Library.Property" atom, which is given a
+	 * PropertyID_t the first time it is seen. IDs are never reused, if a library is
+	 * unloaded and loaded again its properties keep their previous IDs, so they can be
+	 * cached and resolved later with GetByID, which is a plain index.
+	 */
+	class PropertyRegistry
+	{
+	public:
+		struct SnapshotEntry
+		{
+			PropertyID_t ID;
+			ReflectedTypeID_t TypeID;
+			uint32 Offset;
+			uint32 Size;
+		};
+
+		/**
+		 * @brief Values of all the registered properties serialized one after the other
+		 * into Data, Entries tells where each one lives and its type.
+		 */
+		struct Snapshot
+		{
+			Vector<SnapshotEntry> Entries;
+			Vector<uint8> Data;
+
+			template<class T>
+			TResult<T> GetValue(sizet index)const noexcept;
+		};
+
+	private:
+		struct Slot
+		{
+			StringView Name;
+			PIProperty Property;
+		};
+
+		mutable RWMutex m_Mutex;
+		Deque<String> m_Atoms;
+		UnorderedMap<StringView, PropertyID_t> m_AtomMap;
+		Vector<Slot> m_Slots;
+		sizet m_RegisteredCount = 0;
+
+		static String MakeAtom(StringView libraryName, StringView propertyName)noexcept;
+
+	public:
+		PropertyRegistry()noexcept = default;
+		PropertyRegistry(const PropertyRegistry&) = delete;
+		PropertyRegistry& operator=(const PropertyRegistry&) = delete;
+
+		TResult<PropertyID_t> Register(StringView libraryName, const PIProperty& property)noexcept;
+
+		void Unregister(StringView libraryName, const PIProperty& property)noexcept;
+
+		NODISCARD TResult<PropertyID_t> GetID(StringView atom)const noexcept;
+
+		NODISCARD TResult<PropertyID_t> GetID(StringView libraryName, StringView propertyName)const noexcept;
+
+		NODISCARD StringView GetName(PropertyID_t id)const noexcept;
+
+		NODISCARD TResult<PIProperty> GetByID(PropertyID_t id)const noexcept;
+
+		template<class T>
+		NODISCARD TResult<TPropertyAccessor<T>> GetAccessor(PropertyID_t id)const noexcept;
+
+		// Amount of properties currently registered
+		NODISCARD sizet GetCount()const noexcept;
+
+		// Amount of IDs handed out, valid IDs are always lower than this
+		NODISCARD sizet GetIDCount()const noexcept;
+
+		// Copies the value of every registered property into a single buffer, in ID order
+		NODISCARD TResult<Snapshot> TakeSnapshot()const noexcept;
+	};
+}
+
+#endif /* CORE_PROPERTY_REGISTRY_H */
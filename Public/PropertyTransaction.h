@@ -0,0 +1,74 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef CORE_PROPERTY_TRANSACTION_H
+#define CORE_PROPERTY_TRANSACTION_H 1
+
+#include "Property.h"
+
+namespace greaper
+{
+	/**
+	 * @brief Groups changes to several properties, possibly from different libraries,
+	 * so they are applied as a whole.
+	 * Changes are staged without touching the properties, on Commit every involved
+	 * property is locked, all the staged values are validated and only if all of them
+	 * pass they are stored. Staging the same property twice keeps the last value.
+	 * Once unlocked, each changed property fires its modification event once and each
+	 * involved library fires its PropertiesChanged event once with all its changes.
+	 */
+	class PropertyTransaction
+	{
+		struct Entry
+		{
+			PIProperty Property;
+			PPropertyChange Change;
+		};
+		Vector<Entry> m_Entries;
+
+		EmptyResult AddChange(PIProperty prop, TResult<PPropertyChange> changeRes)noexcept;
+
+	public:
+		PropertyTransaction()noexcept = default;
+		PropertyTransaction(const PropertyTransaction&) = delete;
+		PropertyTransaction& operator=(const PropertyTransaction&) = delete;
+		PropertyTransaction(PropertyTransaction&&)noexcept = default;
+		PropertyTransaction& operator=(PropertyTransaction&&)noexcept = default;
+
+		template<class T>
+		EmptyResult Stage(const PProperty<T>& prop, T value)noexcept;
+
+		template<class T>
+		EmptyResult Stage(const WProperty<T>& prop, T value)noexcept;
+
+		EmptyResult StageFromString(const PIProperty& prop, const String& value)noexcept;
+
+		// Stages a change created by the property itself, see IProperty::_CreateChangeFrom*
+		EmptyResult StageChange(const PIProperty& prop, PPropertyChange change)noexcept;
+
+		// Reads the value from the json item named as the property
+		EmptyResult StageFromJSON(const PIProperty& prop, cJSON* json)noexcept;
+
+		/**
+		 * @brief Validates and stores all the staged changes, nothing is modified if any
+		 * of them fails. The transaction is emptied either way.
+		 * 
+		 * @return The amount of properties whose value changed
+		 */
+		TResult<sizet> Commit(bool triggerEvents = true)noexcept;
+
+		INLINE void Clear()noexcept { m_Entries.clear(); }
+
+		NODISCARD INLINE sizet GetStagedCount()const noexcept { return m_Entries.size(); }
+
+		NODISCARD INLINE bool IsEmpty()const noexcept { return m_Entries.empty(); }
+	};
+}
+
+// Methods are in Base/PropertyTransaction.inl, included by IGreaperLibrary.h to avoid circle dependency
+
+#endif /* CORE_PROPERTY_TRANSACTION_H */
@@ -12,6 +12,7 @@
 #include "../Stream.h"
 #include "../StringUtils.h"
 #include "../Enumeration.h"
+#include <algorithm>
 //#include "../Result.h"
 #define CJSON_IMPORT_SYMBOLS
 #define CJSON_API_VISIBILITY
@@ -130,6 +131,129 @@ namespace greaper::refl
 		{
 			Break("[refl::BaseType<T>]::SetArrayValue Trying to use the generic refl::BaseType!");
 		}
+
+		NODISCARD static sizet Hash(UNUSED const T& data)
+		{
+			Break("[refl::BaseType<T>]::Hash Trying to use the generic refl::BaseType!");
+			return 0ll;
+		}
+
+		NODISCARD static bool Equals(UNUSED const T& left, UNUSED const T& right)
+		{
+			Break("[refl::BaseType<T>]::Equals Trying to use the generic refl::BaseType!");
+			return false;
+		}
+	};
+
+	namespace Impl
+	{
+		/* Values of T can be hashed and compared through its bytes when equal values share representation */
+		template<class T>
+		static inline constexpr bool IsBytewiseComparable = std::has_unique_object_representations_v<T>;
+
+		/* Values of T are serialized as a raw copy of their memory */
+		template<class T>
+		static inline constexpr bool IsMemcpySerializable = std::is_same_v<typename TypeInfo<T>::Type, PlainType<T>>
+			&& std::is_trivially_copyable_v<T> && TypeInfo<T>::Type::StaticSize == sizeof(T);
+
+		/* Values of T always take StaticSize bytes once serialized, GetDynamicSize can be skipped */
+		template<class T>
+		struct HasFixedSerializedSize : std::bool_constant<TypeInfo<T>::Type::Category == TypeCategory_t::Plain> {};
+		template<class First, class Second>
+		struct HasFixedSerializedSize<std::pair<First, Second>> : std::bool_constant<HasFixedSerializedSize<First>::value && HasFixedSerializedSize<Second>::value> {};
+		template<class T, sizet N>
+		struct HasFixedSerializedSize<std::array<T, N>> : HasFixedSerializedSize<T> {};
+
+		template<class T>
+		NODISCARD INLINE sizet HashPlainValue(const T& value)
+		{
+			if constexpr (IsBytewiseComparable<T>)
+				return HashObjectBytes(value);
+			else
+				return std::hash<T>()(value); // floating points, handles +0.0 == -0.0
+		}
+
+		template<class FirstCat, class SecondCat>
+		struct PairCat
+		{
+			template<class P>
+			NODISCARD static sizet Hash(const P& data)
+			{
+				sizet seed = FirstCat::Hash(data.first);
+				HashCombineHash(seed, SecondCat::Hash(data.second));
+				return seed;
+			}
+
+			template<class P>
+			NODISCARD static bool Equals(const P& left, const P& right)
+			{
+				return FirstCat::Equals(left.first, right.first) && SecondCat::Equals(left.second, right.second);
+			}
+		};
+
+		/* Order dependent hash, for sequences and ordered containers */
+		template<class Cat, class C>
+		NODISCARD INLINE sizet HashSequence(const C& data)
+		{
+			sizet seed = data.size();
+			for (const auto& elem : data)
+				HashCombineHash(seed, Cat::Hash(elem));
+			return seed;
+		}
+
+		/* Order independent hash, for unordered containers, each element is mixed before adding it */
+		template<class Cat, class C>
+		NODISCARD INLINE sizet HashUnordered(const C& data)
+		{
+			sizet sum = 0;
+			for (const auto& elem : data)
+				sum += (sizet)HashBytes(nullptr, 0, Cat::Hash(elem));
+			sizet seed = data.size();
+			HashCombineHash(seed, sum);
+			return seed;
+		}
+
+		template<class Cat, class C>
+		NODISCARD INLINE bool EqualsSequence(const C& left, const C& right)
+		{
+			if (left.size() != right.size())
+				return false;
+			return std::equal(left.begin(), left.end(), right.begin(),
+				[](const auto& l, const auto& r) { return Cat::Equals(l, r); });
+		}
+
+		/* Compares each equal-key range of both containers as a permutation, keyOf extracts the lookup key */
+		template<class Cat, class C, class KeyFn>
+		NODISCARD INLINE bool EqualsUnordered(const C& left, const C& right, KeyFn keyOf)
+		{
+			if (left.size() != right.size())
+				return false;
+			for (auto it = left.begin(); it != left.end();)
+			{
+				const auto leftRange = left.equal_range(keyOf(*it));
+				const auto rightRange = right.equal_range(keyOf(*it));
+				if (std::distance(leftRange.first, leftRange.second) != std::distance(rightRange.first, rightRange.second))
+					return false;
+				if (!std::is_permutation(leftRange.first, leftRange.second, rightRange.first,
+					[](const auto& l, const auto& r) { return Cat::Equals(l, r); }))
+					return false;
+				it = leftRange.second;
+			}
+			return true;
+		}
+	}
+
+	/* Functors to use reflected types as keys of hashed containers */
+	template<class T>
+	struct Hasher
+	{
+		NODISCARD INLINE sizet operator()(const T& value)const { return TypeInfo<T>::Type::Hash(value); }
+	};
+
+	template<class T>
+	struct EqualTo
+	{
+		NODISCARD INLINE bool operator()(const T& left, const T& right)const { return TypeInfo<T>::Type::Equals(left, right); }
 	};
 }
 
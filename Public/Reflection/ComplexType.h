@@ -20,8 +20,32 @@ namespace greaper::refl
 
 		static inline constexpr TypeCategory_t Category = TypeCategory_t::Complex;
 
+		/* Fields are only known at runtime, the whole serialized size is reported by GetDynamicSize */
 		static inline constexpr ssizet StaticSize = 0;
 
+		/* Serialized size information that doesn't depend on the instance, computed once per type */
+		struct SizeCache
+		{
+			int64 FixedSize = 0;
+			Vector<const IField*> DynamicFields;
+		};
+
+		NODISCARD static const SizeCache& GetSizeCache()
+		{
+			static const SizeCache cache = []()
+				{
+					SizeCache c;
+					for (const auto& field : Fields)
+					{
+						c.FixedSize += field->GetStaticSize();
+						if (!field->HasFixedSize())
+							c.DynamicFields.push_back(field.get());
+					}
+					return c;
+				}();
+			return cache;
+		}
+
 		static TResult<ssizet> ToStream(const T& data, IStream& stream)
 		{
 			ssizet totalSize = 0;
@@ -97,11 +121,10 @@ namespace greaper::refl
 
 		NODISCARD static int64 GetDynamicSize(const T& data)
 		{
-			int64 size = 0;
-			for (const auto& field : Fields)
-			{
-				size += field->GetStaticSize() + field->GetDynamicSize(&data);
-			}
+			const SizeCache& cache = GetSizeCache();
+			int64 size = cache.FixedSize;
+			for (const IField* field : cache.DynamicFields)
+				size += field->GetDynamicSize(&data);
 			return size;
 		}
 		
@@ -127,6 +150,27 @@ namespace greaper::refl
 		{
 			Break("[refl::ComplexType<T>]::SetArrayValue Trying to use a PlainType for array operations!");
 		}
+
+		/* Combines the hash of every reflected field, plain fields are hashed through their bytes */
+		NODISCARD static sizet Hash(const T& data)
+		{
+			sizet seed = TypeInfo<T>::ID;
+			for (const auto& field : Fields)
+				HashCombineHash(seed, field->Hash(&data));
+			return seed;
+		}
+
+		NODISCARD static bool Equals(const T& left, const T& right)
+		{
+			if (&left == &right)
+				return true;
+			for (const auto& field : Fields)
+			{
+				if (!field->Equals(&left, &right))
+					return false;
+			}
+			return true;
+		}
 	};
 }
 
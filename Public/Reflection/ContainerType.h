@@ -138,6 +138,16 @@ namespace greaper::refl
 			if(index < GetArraySize(data))
 				data[index] = value;
 		}
+
+		NODISCARD static sizet Hash(const Type& data)
+		{
+			return (sizet)HashBytes(data.data(), data.size() * sizeof(ArrayValueType));
+		}
+
+		NODISCARD static bool Equals(const Type& left, const Type& right)
+		{
+			return left == right;
+		}
 	};
 
 	template<>
@@ -267,6 +277,16 @@ namespace greaper::refl
 			if(index < GetArraySize(data))
 				data[index] = value;
 		}
+
+		NODISCARD static sizet Hash(const Type& data)
+		{
+			return (sizet)HashBytes(data.data(), data.size() * sizeof(ArrayValueType));
+		}
+
+		NODISCARD static bool Equals(const Type& left, const Type& right)
+		{
+			return left == right;
+		}
 	};
 
 	template<class T, sizet N>
@@ -282,11 +302,14 @@ namespace greaper::refl
 
 		static inline constexpr TypeCategory_t Category = TypeCategory_t::Container;
 
+		/* Contiguous plain elements are hashed and compared as a single block */
+		static inline constexpr bool HashAsBytes = std::is_same_v<ValueCat, PlainType<ArrayValueType>> && Impl::IsBytewiseComparable<ArrayValueType>;
+
 		static TResult<ssizet> ToStream(const Type& data, IStream& stream)
 		{
 			ssizet size = 0;
 			ssizet dynamicSize = GetDynamicSize(data);
-			if constexpr(std::is_same_v<ValueCat, PlainType<ArrayValueType>>)
+			if constexpr(Impl::IsMemcpySerializable<ArrayValueType>)
 			{
 				size += stream.Write(data.data(), StaticSize);
 			}
@@ -311,7 +334,7 @@ namespace greaper::refl
 		{
 			ssizet size = 0;
 			ssizet dynamicSize = 0;
-			if constexpr(std::is_same_v<ValueCat, PlainType<ArrayValueType>>)
+			if constexpr(Impl::IsMemcpySerializable<ArrayValueType>)
 			{
 				size += stream.Read(data.data(), StaticSize);
 			}
@@ -424,7 +447,7 @@ namespace greaper::refl
 #endif
 		NODISCARD static int64 GetDynamicSize(const Type& data)
 		{
-			if constexpr (std::is_same_v<ValueCat, PlainType<ArrayValueType>>)
+			if constexpr (Impl::IsMemcpySerializable<ArrayValueType>)
 				return 0ll;
 			
 			int64 size = 0;
@@ -459,6 +482,22 @@ namespace greaper::refl
 			if(index < GetArraySize(data))
 				data[index] = value;
 		}
+
+		NODISCARD static sizet Hash(const Type& data)
+		{
+			if constexpr (HashAsBytes)
+				return (sizet)HashBytes(data.data(), data.size() * sizeof(ArrayValueType));
+			else
+				return Impl::HashSequence<ValueCat>(data);
+		}
+
+		NODISCARD static bool Equals(const Type& left, const Type& right)
+		{
+			if constexpr (HashAsBytes)
+				return left.size() == right.size() && memcmp(left.data(), right.data(), left.size() * sizeof(ArrayValueType)) == 0;
+			else
+				return Impl::EqualsSequence<ValueCat>(left, right);
+		}
 	};
 
 	template<class T, class A>
@@ -474,6 +513,9 @@ namespace greaper::refl
 
 		static inline constexpr TypeCategory_t Category = TypeCategory_t::Container;
 
+		/* Contiguous plain elements are hashed and compared as a single block */
+		static inline constexpr bool HashAsBytes = std::is_same_v<ValueCat, PlainType<ArrayValueType>> && Impl::IsBytewiseComparable<ArrayValueType> && !std::is_same_v<ArrayValueType, bool>;
+
 		static TResult<ssizet> ToStream(const Type& data, IStream& stream)
 		{
 			int64 elementCount = data.size();
@@ -482,7 +524,7 @@ namespace greaper::refl
 
 			auto dynamicSize = GetDynamicSize(data);
 
-			if constexpr(std::is_same_v<ValueCat, PlainType<ArrayValueType>>)
+			if constexpr(Impl::IsMemcpySerializable<ArrayValueType>)
 			{
 				size += stream.Write(data.data(), dynamicSize);
 			}
@@ -512,7 +554,7 @@ namespace greaper::refl
 			data.clear();
 			data.resize(elementCount);
 			int64 dynamicSize = 0;
-			if constexpr(std::is_same_v<ValueCat, PlainType<ArrayValueType>>)
+			if constexpr(Impl::IsMemcpySerializable<ArrayValueType>)
 			{
 				dynamicSize = elementCount * sizeof(ArrayValueType);
 				size += stream.Read(data.data(), dynamicSize);
@@ -628,7 +670,7 @@ namespace greaper::refl
 #endif
 		NODISCARD static int64 GetDynamicSize(const Type& data)
 		{
-			if constexpr (std::is_same_v<ValueCat, PlainType<ArrayValueType>>)
+			if constexpr (Impl::IsMemcpySerializable<ArrayValueType>)
 			{
 				return sizeof(ArrayValueType) * data.size();
 			}
@@ -664,6 +706,22 @@ namespace greaper::refl
 			if(index < GetArraySize(data))
 				data[index] = value;
 		}
+
+		NODISCARD static sizet Hash(const Type& data)
+		{
+			if constexpr (HashAsBytes)
+				return (sizet)HashBytes(data.data(), data.size() * sizeof(ArrayValueType));
+			else
+				return Impl::HashSequence<ValueCat>(data);
+		}
+
+		NODISCARD static bool Equals(const Type& left, const Type& right)
+		{
+			if constexpr (HashAsBytes)
+				return left.size() == right.size() && memcmp(left.data(), right.data(), left.size() * sizeof(ArrayValueType)) == 0;
+			else
+				return Impl::EqualsSequence<ValueCat>(left, right);
+		}
 	};
 
 	template<class T, class A>
@@ -860,6 +918,16 @@ namespace greaper::refl
 				}	
 			}
 		}
+
+		NODISCARD static sizet Hash(const Type& data)
+		{
+			return Impl::HashSequence<ValueCat>(data);
+		}
+
+		NODISCARD static bool Equals(const Type& left, const Type& right)
+		{
+			return Impl::EqualsSequence<ValueCat>(left, right);
+		}
 	};
 
 	template<class T, class A>
@@ -1039,6 +1107,16 @@ namespace greaper::refl
 			if(index < GetArraySize(data))
 				data[index] = value;
 		}
+
+		NODISCARD static sizet Hash(const Type& data)
+		{
+			return Impl::HashSequence<ValueCat>(data);
+		}
+
+		NODISCARD static bool Equals(const Type& left, const Type& right)
+		{
+			return Impl::EqualsSequence<ValueCat>(left, right);
+		}
 	};
 
 	template<class T, class C, class A>
@@ -1233,6 +1311,16 @@ namespace greaper::refl
 				data.emplace(value);
 			}
 		}
+
+		NODISCARD static sizet Hash(const Type& data)
+		{
+			return Impl::HashSequence<ValueCat>(data);
+		}
+
+		NODISCARD static bool Equals(const Type& left, const Type& right)
+		{
+			return Impl::EqualsSequence<ValueCat>(left, right);
+		}
 	};
 
 	template<class T, class C, class A>
@@ -1427,6 +1515,16 @@ namespace greaper::refl
 				data.emplace(value);
 			}
 		}
+
+		NODISCARD static sizet Hash(const Type& data)
+		{
+			return Impl::HashSequence<ValueCat>(data);
+		}
+
+		NODISCARD static bool Equals(const Type& left, const Type& right)
+		{
+			return Impl::EqualsSequence<ValueCat>(left, right);
+		}
 	};
 
 	template<class T, class H, class C, class A>
@@ -1621,6 +1719,16 @@ namespace greaper::refl
 				data.emplace(value);
 			}
 		}
+
+		NODISCARD static sizet Hash(const Type& data)
+		{
+			return Impl::HashUnordered<ValueCat>(data);
+		}
+
+		NODISCARD static bool Equals(const Type& left, const Type& right)
+		{
+			return Impl::EqualsUnordered<ValueCat>(left, right, [](const ArrayValueType& elem) -> const ArrayValueType& { return elem; });
+		}
 	};
 
 	template<class T, class H, class C, class A>
@@ -1815,6 +1923,16 @@ namespace greaper::refl
 				data.emplace(value);
 			}
 		}
+
+		NODISCARD static sizet Hash(const Type& data)
+		{
+			return Impl::HashUnordered<ValueCat>(data);
+		}
+
+		NODISCARD static bool Equals(const Type& left, const Type& right)
+		{
+			return Impl::EqualsUnordered<ValueCat>(left, right, [](const ArrayValueType& elem) -> const ArrayValueType& { return elem; });
+		}
 	};
 
 	template<class K, class V, class P, class A>
@@ -2022,6 +2140,16 @@ namespace greaper::refl
 				data.emplace(value);
 			}
 		}
+
+		NODISCARD static sizet Hash(const Type& data)
+		{
+			return Impl::HashSequence<Impl::PairCat<KeyCat, ValueCat>>(data);
+		}
+
+		NODISCARD static bool Equals(const Type& left, const Type& right)
+		{
+			return Impl::EqualsSequence<Impl::PairCat<KeyCat, ValueCat>>(left, right);
+		}
 	};
 
 	template<class K, class V, class P, class A>
@@ -2229,6 +2357,16 @@ namespace greaper::refl
 				data.emplace(value);
 			}
 		}
+
+		NODISCARD static sizet Hash(const Type& data)
+		{
+			return Impl::HashSequence<Impl::PairCat<KeyCat, ValueCat>>(data);
+		}
+
+		NODISCARD static bool Equals(const Type& left, const Type& right)
+		{
+			return Impl::EqualsSequence<Impl::PairCat<KeyCat, ValueCat>>(left, right);
+		}
 	};
 
 	template<class K, class V, class H, class C, class A>
@@ -2436,6 +2574,16 @@ namespace greaper::refl
 				data.emplace(value);
 			}
 		}
+
+		NODISCARD static sizet Hash(const Type& data)
+		{
+			return Impl::HashUnordered<Impl::PairCat<KeyCat, ValueCat>>(data);
+		}
+
+		NODISCARD static bool Equals(const Type& left, const Type& right)
+		{
+			return Impl::EqualsUnordered<Impl::PairCat<KeyCat, ValueCat>>(left, right, [](const ArrayValueType& elem) -> const K& { return elem.first; });
+		}
 	};
 
 	template<class K, class V, class H, class C, class A>
@@ -2643,6 +2791,891 @@ namespace greaper::refl
 				data.emplace(value);
 			}
 		}
+
+		NODISCARD static sizet Hash(const Type& data)
+		{
+			return Impl::HashUnordered<Impl::PairCat<KeyCat, ValueCat>>(data);
+		}
+
+		NODISCARD static bool Equals(const Type& left, const Type& right)
+		{
+			return Impl::EqualsUnordered<Impl::PairCat<KeyCat, ValueCat>>(left, right, [](const ArrayValueType& elem) -> const K& { return elem.first; });
+		}
+	};
+
+	template<class T, class H, class E, class A>
+	struct ContainerType<FlatSet<T, H, E, A>> : public BaseType<FlatSet<T, H, E, A>>
+	{
+		using Type = FlatSet<T, H, E, A>;
+		using ArrayValueType = typename Type::value_type;
+		using ValueCat = typename TypeInfo<ArrayValueType>::Type;
+
+		static_assert(!std::is_same_v<ValueCat, void>, "[refl::ContainerType<FlatSet>] Trying to use a Container with not refl value_type!");
+
+		static inline constexpr ssizet StaticSize = sizeof(int64);
+
+		static inline constexpr TypeCategory_t Category = TypeCategory_t::Container;
+
+		static TResult<ssizet> ToStream(const Type& data, IStream& stream)
+		{
+			int64 elementCount = data.size();
+			ssizet size = 0;
+			size += stream.Write(&elementCount, sizeof(elementCount));
+
+			auto dynamicSize = GetDynamicSize(data);
+
+			for(const ArrayValueType& elem : data)
+			{
+				TResult<ssizet> res = ValueCat::ToStream(elem, stream);
+				if(res.HasFailed())
+					return res;
+				
+				size += res.GetValue();
+			}
+			ssizet expectedSize = StaticSize + dynamicSize;
+			if(size == expectedSize)
+				return Result::CreateSuccess(size);
+			return Result::CreateFailure<ssizet>(Format("[refl::ContainerType<FlatSet>]::ToStream Failure while writing to stream, not all data was written, expected:%" PRIiPTR " obtained:%" PRIiPTR ".", expectedSize, size));
+		}
+
+		static TResult<ssizet> FromStream(Type& data, IStream& stream)
+		{
+			int64 elementCount;
+			ssizet size = 0;
+			size += stream.Read(&elementCount, sizeof(elementCount));
+
+			int64 dynamicSize = 0;
+			data.clear();
+			data.reserve((sizet)elementCount);
+			for(decltype(elementCount) i = 0; i < elementCount; ++i)
+			{
+				ArrayValueType elem;
+				TResult<ssizet> res = ValueCat::FromStream(elem, stream);
+				if(res.HasFailed())
+					return res;
+				
+				data.emplace(elem);
+				dynamicSize += ValueCat::StaticSize + ValueCat::GetDynamicSize(elem);
+				size += res.GetValue();
+			}
+			ssizet expectedSize = StaticSize + dynamicSize;
+			if(size == expectedSize)
+				return Result::CreateSuccess(size);
+			return Result::CreateFailure<ssizet>(Format("[refl::ContainerType<FlatSet>]::FromStream Failure while reading from stream, not all data was read, expected:%" PRIiPTR " obtained:%" PRIiPTR ".", expectedSize, size));
+		}
+
+		static TResult<std::pair<Type, ssizet>> CreateFromStream(IStream& stream)
+		{
+			Type elem;
+			TResult<ssizet> res = FromStream(elem, stream);
+			if (res.HasFailed())
+				return Result::CopyFailure<std::pair<Type, ssizet>, ssizet>(res);
+			return Result::CreateSuccess(std::make_pair(elem, res.GetValue()));
+		}
+
+		static SPtr<cJSON> CreateJSON(const Type& data, StringView name)
+		{
+			cJSON* obj = cJSON_CreateObject();
+			ToJSON(data, obj, name);
+			return SPtr<cJSON>(obj, cJSON_Delete);
+		}
+
+		static cJSON* ToJSON(const Type& data, cJSON* json, StringView name)
+		{
+			cJSON* arr = cJSON_AddArrayToObject(json, name.data());
+			achar buff[128];
+			sizet i = 0;
+			for(const auto& elem : data)
+			{
+				snprintf(buff, ArraySize(buff), "Elem_%" PRIiPTR, i++);
+				cJSON* obj = cJSON_CreateObject();
+				ValueCat::ToJSON(elem, obj, StringView{buff});
+				cJSON_AddItemToArray(arr, obj);
+			}
+			return arr;
+		}
+		
+		static EmptyResult FromJSON(Type& data, cJSON* json, StringView name)
+		{
+			cJSON* arr = cJSON_GetObjectItemCaseSensitive(json, name.data());
+			if(arr == nullptr)
+				return Result::CreateFailure(Format("[refl::ContainerType<FlatSet>]::FromJSON Couldn't obtain the value from json, the item with name '%s' was not found.", name.data()));
+			if(!cJSON_IsArray(arr))
+				return Result::CreateFailure("[refl::ContainerType<FlatSet>]::FromJSON expected an Array."sv);
+			
+			achar buff[128];
+			sizet N = cJSON_GetArraySize(arr);
+			data.clear();
+			for(sizet i = 0; i < N; ++i)
+			{
+				cJSON* item = cJSON_GetArrayItem(arr, i);
+				snprintf(buff, ArraySize(buff), "Elem_%" PRIiPTR, i);
+				ArrayValueType elem;
+				EmptyResult res = ValueCat::FromJSON(elem, item, StringView{buff});
+				if(res.HasFailed())
+					return res;
+				
+				data.emplace(elem);
+			}
+			return Result::CreateSuccess();
+		}
+
+		static TResult<Type> CreateFromJSON(cJSON* json, StringView name)
+		{
+			Type elem;
+			EmptyResult res = FromJSON(elem, json, name);
+			if (res.HasFailed())
+				return Result::CopyFailure<Type>(res);
+			return Result::CreateSuccess(elem);
+		}
+
+		static String ToString(const Type& data)
+		{
+			SPtr<cJSON> json = CreateJSON(data, TypeInfo<Type>::Name);
+			SPtr<char> jsonStr = SPtr<char>(cJSON_Print(json.get()));
+			return String {jsonStr.get() };
+		}
+
+		static EmptyResult FromString(const String& str, Type& data)
+		{
+			SPtr<cJSON> json = SPtr<cJSON>(cJSON_Parse(str.c_str()), cJSON_Delete);
+			return FromJSON(data, json.get(), TypeInfo<Type>::Name);
+		}
+
+		static TResult<Type> CreateFromString(const String& str)
+		{
+			Type elem;
+			EmptyResult res = FromString(str, elem);
+			if (res.HasFailed())
+				return Result::CopyFailure<Type>(res);
+			return Result::CreateSuccess(elem);
+		}
+
+		NODISCARD static int64 GetDynamicSize(const Type& data)
+		{
+			int64 size = 0;
+			for(const auto& e : data)
+				size += ValueCat::StaticSize + ValueCat::GetDynamicSize(e);
+			return size;
+		}
+
+		NODISCARD static sizet GetArraySize(const Type& data)
+		{
+			return data.size();
+		}
+
+		static void SetArraySize(Type& data, sizet size)
+		{
+			while(data.size() < size)
+				data.emplace(ArrayValueType{});
+			while(data.size() > size)
+				data.erase(data.begin());
+		}
+
+		NODISCARD static const ArrayValueType& GetArrayValue(const Type& data, sizet index)
+		{
+			static ArrayValueType tmp;
+			if (index < GetArraySize(data))
+			{
+				sizet i = 0;
+				for (const auto& elem : data)
+				{
+					if (i == index)
+						return elem;
+					++i;
+				}
+			}
+			return tmp;
+		}
+
+		static void SetArrayValue(Type& data, const ArrayValueType& value, sizet index)
+		{
+			if (index < GetArraySize(data))
+			{
+				data.erase(GetArrayValue(data, index));
+				data.emplace(value);
+			}
+		}
+
+		NODISCARD static sizet Hash(const Type& data)
+		{
+			return Impl::HashUnordered<ValueCat>(data);
+		}
+
+		NODISCARD static bool Equals(const Type& left, const Type& right)
+		{
+			return Impl::EqualsUnordered<ValueCat>(left, right, [](const ArrayValueType& elem) -> const ArrayValueType& { return elem; });
+		}
+	};
+
+	template<class K, class V, class H, class E, class A>
+	struct ContainerType<FlatMap<K, V, H, E, A>> : public BaseType<FlatMap<K, V, H, E, A>>
+	{
+		using Type = FlatMap<K, V, H, E, A>;
+		using ArrayValueType = typename Type::value_type;
+		using KeyCat = typename TypeInfo<K>::Type;
+		using ValueCat = typename TypeInfo<V>::Type;
+
+		static_assert(!std::is_same_v<ValueCat, void>, "[refl::ContainerType<FlatMap>] Trying to use a Container with not refl value_type!");
+
+		static inline constexpr ssizet StaticSize = sizeof(int64);
+
+		static inline constexpr TypeCategory_t Category = TypeCategory_t::Container;
+
+		static TResult<ssizet> ToStream(const Type& data, IStream& stream)
+		{
+			int64 elementCount = data.size();
+			ssizet size = 0;
+			size += stream.Write(&elementCount, sizeof(elementCount));
+
+			auto dynamicSize = GetDynamicSize(data);
+			for(const auto& [key, value] : data)
+			{
+				TResult<ssizet> res = KeyCat::ToStream(key, stream);
+				if(res.HasFailed())
+					return res;
+				
+				size += res.GetValue();
+
+				res = ValueCat::ToStream(value, stream);
+				if(res.HasFailed())
+					return res;
+				
+				size += res.GetValue();
+			}
+			ssizet expectedSize = StaticSize + dynamicSize;
+			if(size == expectedSize)
+				return Result::CreateSuccess(size);
+			return Result::CreateFailure<ssizet>(Format("[refl::ContainerType<FlatMap>]::ToStream Failure while writing to stream, not all data was written, expected:%" PRIiPTR " obtained:%" PRIiPTR ".", expectedSize, size));
+		}
+
+		static TResult<ssizet> FromStream(Type& data, IStream& stream)
+		{
+			int64 elementCount;
+			ssizet size = 0;
+			size += stream.Read(&elementCount, sizeof(elementCount));
+
+			data.clear();
+			data.reserve((sizet)elementCount);
+			int64 dynamicSize = 0;
+			for(decltype(elementCount) i = 0; i < elementCount; ++i)
+			{
+				K key;
+				TResult<ssizet> res = KeyCat::FromStream(key, stream);
+				if(res.HasFailed())
+					return res;
+
+				size += res.GetValue();
+				dynamicSize += KeyCat::StaticSize + KeyCat::GetDynamicSize(key);
+
+				V value;
+				res = ValueCat::FromStream(value, stream);
+				if(res.HasFailed())
+					return res;
+				
+				size += res.GetValue();
+				dynamicSize += ValueCat::StaticSize + ValueCat::GetDynamicSize(value);
+				
+				data.emplace(std::move(key), std::move(value));
+			}
+			ssizet expectedSize = StaticSize + dynamicSize;
+			if(size == expectedSize)
+				return Result::CreateSuccess(size);
+			return Result::CreateFailure<ssizet>(Format("[refl::ContainerType<FlatMap>]::FromStream Failure while reading from stream, not all data was read, expected:%" PRIiPTR " obtained:%" PRIiPTR ".", expectedSize, size));
+		}
+
+		static TResult<std::pair<Type, ssizet>> CreateFromStream(IStream& stream)
+		{
+			Type elem;
+			TResult<ssizet> res = FromStream(elem, stream);
+			if (res.HasFailed())
+				return Result::CopyFailure<std::pair<Type, ssizet>, ssizet>(res);
+			return Result::CreateSuccess(std::make_pair(elem, res.GetValue()));
+		}
+
+		static SPtr<cJSON> CreateJSON(const Type& data, StringView name)
+		{
+			cJSON* obj = cJSON_CreateObject();
+			ToJSON(data, obj, name);
+			return SPtr<cJSON>(obj, cJSON_Delete);
+		}
+
+		static cJSON* ToJSON(const Type& data, cJSON* json, StringView name)
+		{
+			cJSON* arr = cJSON_AddArrayToObject(json, name.data());
+			for(const auto& [key, value] : data)
+			{
+				cJSON* obj = cJSON_CreateObject();
+				KeyCat::ToJSON(key, obj, "key"sv);
+				ValueCat::ToJSON(value, obj, "value"sv);
+				cJSON_AddItemToArray(arr, obj);
+			}
+			return arr;
+		}
+		
+		static EmptyResult FromJSON(Type& data, cJSON* json, StringView name)
+		{
+			cJSON* arr = cJSON_GetObjectItemCaseSensitive(json, name.data());
+			if(arr == nullptr)
+				return Result::CreateFailure(Format("[refl::ContainerType<FlatMap>]::FromJSON Couldn't obtain the value from json, the item with name '%s' was not found.", name.data()));
+			if(!cJSON_IsArray(arr))
+				return Result::CreateFailure("[refl::ContainerType<FlatMap>]::FromJSON expected an Array."sv);
+			
+			sizet N = cJSON_GetArraySize(arr);
+			data.clear();
+			for(sizet i = 0; i < N; ++i)
+			{
+				cJSON* item = cJSON_GetArrayItem(arr, i);
+				K key;
+				EmptyResult res = KeyCat::FromJSON(key, item, "key"sv);
+				if(res.HasFailed())
+					return res;
+				
+				V value;
+				res = ValueCat::FromJSON(value, item, "value"sv);
+				if(res.HasFailed())
+					return res;
+
+				data.emplace(std::move(key), std::move(value));
+			}
+			return Result::CreateSuccess();
+		}
+
+		static TResult<Type> CreateFromJSON(cJSON* json, StringView name)
+		{
+			Type elem;
+			EmptyResult res = FromJSON(elem, json, name);
+			if (res.HasFailed())
+				return Result::CopyFailure<Type>(res);
+			return Result::CreateSuccess(elem);
+		}
+
+		static String ToString(const Type& data)
+		{
+			SPtr<cJSON> json = CreateJSON(data, TypeInfo<Type>::Name);
+			SPtr<char> jsonStr = SPtr<char>(cJSON_Print(json.get()));
+			return String{ jsonStr.get() };
+		}
+
+		static EmptyResult FromString(const String& str, Type& data)
+		{
+			SPtr<cJSON> json = SPtr<cJSON>(cJSON_Parse(str.c_str()), cJSON_Delete);
+			return FromJSON(data, json.get(), TypeInfo<Type>::Name);
+		}
+
+		static TResult<Type> CreateFromString(const String& str)
+		{
+			Type elem;
+			EmptyResult res = FromString(str, elem);
+			if (res.HasFailed())
+				return Result::CopyFailure<Type>(res);
+			return Result::CreateSuccess(elem);
+		}
+
+		NODISCARD static int64 GetDynamicSize(const Type& data)
+		{
+			int64 size = 0;
+			for(const auto& [key, value] : data)
+				size += KeyCat::StaticSize + ValueCat::StaticSize + KeyCat::GetDynamicSize(key) + ValueCat::GetDynamicSize(value);
+			return size;
+		}
+
+		NODISCARD static sizet GetArraySize(const Type& data)
+		{
+			return data.size();
+		}
+
+		static void SetArraySize(UNUSED Type& data, UNUSED sizet size)
+		{
+			/* No-op */
+		}
+
+		NODISCARD static const ArrayValueType& GetArrayValue(const Type& data, sizet index)
+		{
+			static ArrayValueType tmp;
+			if (index < GetArraySize(data))
+			{
+				sizet i = 0;
+				for (const auto& elem : data)
+				{
+					if (i == index)
+						return elem;
+					++i;
+				}
+			}
+			return tmp;
+		}
+
+		static void SetArrayValue(Type& data, const ArrayValueType& value, sizet index)
+		{
+			if (index < GetArraySize(data))
+			{
+				data.erase(GetArrayValue(data, index).first);
+				data.insert(value);
+			}
+		}
+
+		NODISCARD static sizet Hash(const Type& data)
+		{
+			return Impl::HashUnordered<Impl::PairCat<KeyCat, ValueCat>>(data);
+		}
+
+		NODISCARD static bool Equals(const Type& left, const Type& right)
+		{
+			return Impl::EqualsUnordered<Impl::PairCat<KeyCat, ValueCat>>(left, right, [](const ArrayValueType& elem) -> const K& { return elem.first; });
+		}
+	};
+
+	template<class T, sizet N, class A>
+	struct ContainerType<SmallVector<T, N, A>> : public BaseType<SmallVector<T, N, A>>
+	{
+		using Type = SmallVector<T, N, A>;
+		using ArrayValueType = typename Type::value_type;
+		using ValueCat = typename TypeInfo<ArrayValueType>::Type;
+
+		static_assert(!std::is_same_v<ValueCat, void>, "[refl::ContainerType<SmallVector>] Trying to use a Container with not refl value_type!");
+
+		static inline constexpr ssizet StaticSize = sizeof(int64);
+
+		static inline constexpr TypeCategory_t Category = TypeCategory_t::Container;
+
+		/* Contiguous plain elements are hashed and compared as a single block */
+		static inline constexpr bool HashAsBytes = std::is_same_v<ValueCat, PlainType<ArrayValueType>> && Impl::IsBytewiseComparable<ArrayValueType> && !std::is_same_v<ArrayValueType, bool>;
+
+		static TResult<ssizet> ToStream(const Type& data, IStream& stream)
+		{
+			int64 elementCount = data.size();
+			ssizet size = 0;
+			size += stream.Write(&elementCount, sizeof(elementCount));
+
+			auto dynamicSize = GetDynamicSize(data);
+
+			if constexpr(Impl::IsMemcpySerializable<ArrayValueType>)
+			{
+				size += stream.Write(data.data(), dynamicSize);
+			}
+			else
+			{
+				for(const ArrayValueType& elem : data)
+				{
+					TResult<ssizet> res = ValueCat::ToStream(elem, stream);
+					if(res.HasFailed())
+						return res;
+					
+					size += res.GetValue();
+				}
+			}
+			ssizet expectedSize = dynamicSize + StaticSize; 
+			if(size == expectedSize)
+				return Result::CreateSuccess(size);
+			return Result::CreateFailure<ssizet>(Format("[refl::ContainerType<SmallVector>]::ToStream Failure while writing to stream, not all data was written, expected:%" PRIiPTR " obtained:%" PRIiPTR ".", expectedSize, size));
+		}
+
+		static TResult<ssizet> FromStream(Type& data, IStream& stream)
+		{
+			int64 elementCount;
+			ssizet size = 0;
+			size += stream.Read(&elementCount, sizeof(elementCount));
+
+			data.clear();
+			data.resize(elementCount);
+			int64 dynamicSize = 0;
+			if constexpr(Impl::IsMemcpySerializable<ArrayValueType>)
+			{
+				dynamicSize = elementCount * sizeof(ArrayValueType);
+				size += stream.Read(data.data(), dynamicSize);
+			}
+			else
+			{
+				for(auto it = data.begin(); it != data.end(); ++it)
+				{
+					ArrayValueType elem;
+					TResult<ssizet> res = ValueCat::FromStream(elem, stream);
+					if(res.HasFailed())
+						return res;
+					
+					(*it) = elem;
+					dynamicSize += ValueCat::StaticSize + ValueCat::GetDynamicSize(elem);
+					size += res.GetValue();
+				}
+			}
+			ssizet expectedSize = dynamicSize + StaticSize; 
+			if(size == expectedSize)
+				return Result::CreateSuccess(size);
+			return Result::CreateFailure<ssizet>(Format("[refl::ContainerType<SmallVector>]::FromStream Failure while reading from stream, not all data was read, expected:%" PRIiPTR " obtained:%" PRIiPTR ".", expectedSize, size));
+		}
+
+		static TResult<std::pair<Type, ssizet>> CreateFromStream(IStream& stream)
+		{
+			Type elem;
+			TResult<ssizet> res = FromStream(elem, stream);
+			if (res.HasFailed())
+				return Result::CopyFailure<std::pair<Type, ssizet>, ssizet>(res);
+			return Result::CreateSuccess(std::make_pair(elem, res.GetValue()));
+		}
+
+		static SPtr<cJSON> CreateJSON(const Type& data, StringView name)
+		{
+			cJSON* obj = cJSON_CreateObject();
+			ToJSON(data, obj, name);
+			return SPtr<cJSON>(obj, cJSON_Delete);
+		}
+
+		static cJSON* ToJSON(const Type& data, cJSON* json, StringView name)
+		{
+			cJSON* arr = cJSON_AddArrayToObject(json, name.data());
+			achar buff[128];
+			sizet i = 0;
+			for(const auto& elem : data)
+			{
+				snprintf(buff, ArraySize(buff), "Elem_%" PRIiPTR, i++);
+				cJSON* obj = cJSON_CreateObject();
+				ValueCat::ToJSON(elem, obj, StringView{ buff });
+				cJSON_AddItemToArray(arr, obj);
+			}
+			return arr;
+		}
+		
+		static EmptyResult FromJSON(Type& data, cJSON* json, StringView name)
+		{
+			cJSON* arr = cJSON_GetObjectItemCaseSensitive(json, name.data());
+			if(arr == nullptr)
+				return Result::CreateFailure(Format("[refl::ContainerType<SmallVector>]::FromJSON Couldn't obtain the value from json, the item with name '%s' was not found.", name.data()));
+			if(!cJSON_IsArray(arr))
+				return Result::CreateFailure("[refl::ContainerType<SmallVector>]::FromJSON expected an Array."sv);
+			
+			achar buff[128];
+			auto count = cJSON_GetArraySize(arr);
+			data.clear();
+			data.resize(count);
+			for(decltype(count) i = 0; i < count; ++i)
+			{
+				cJSON* item = cJSON_GetArrayItem(arr, i);
+				snprintf(buff, ArraySize(buff), "Elem_%" PRIi32, i);
+				EmptyResult res = ValueCat::FromJSON(data[i], item, StringView{buff});
+				if(res.HasFailed())
+					return res;
+			}
+			return Result::CreateSuccess();
+		}
+
+		static TResult<Type> CreateFromJSON(cJSON* json, StringView name)
+		{
+			Type elem;
+			EmptyResult res = FromJSON(elem, json, name);
+			if (res.HasFailed())
+				return Result::CopyFailure<Type>(res);
+			return Result::CreateSuccess(elem);
+		}
+
+		static String ToString(const Type& data)
+		{
+			SPtr<cJSON> json = CreateJSON(data, TypeInfo<Type>::Name);
+			SPtr<char> jsonStr = SPtr<char>(cJSON_Print(json.get()));
+			return String{ jsonStr.get() };
+		}
+
+		static EmptyResult FromString(const String& str, Type& data)
+		{
+			SPtr<cJSON> json = SPtr<cJSON>(cJSON_Parse(str.c_str()), cJSON_Delete);
+			return FromJSON(data, json.get(), TypeInfo<Type>::Name);
+		}
+
+		static TResult<Type> CreateFromString(const String& str)
+		{
+			Type elem;
+			EmptyResult res = FromString(str, elem);
+			if (res.HasFailed())
+				return Result::CopyFailure<Type>(res);
+			return Result::CreateSuccess(elem);
+		}
+
+#if COMPILER_MSVC
+#pragma warning(push)
+#pragma warning(disable:4702)
+#endif
+		NODISCARD static int64 GetDynamicSize(const Type& data)
+		{
+			if constexpr (Impl::IsMemcpySerializable<ArrayValueType>)
+			{
+				return sizeof(ArrayValueType) * data.size();
+			}
+			int64 size = 0;
+			for(const auto& e : data)
+				size += ValueCat::StaticSize + ValueCat::GetDynamicSize(e);
+			return size;
+		}
+#if COMPILER_MSVC
+#pragma warning(pop)
+#endif
+
+		NODISCARD static sizet GetArraySize(const Type& data)
+		{
+			return data.size();
+		}
+
+		static void SetArraySize(Type& data, sizet size)
+		{
+			data.resize(size);
+		}
+
+		NODISCARD static const ArrayValueType& GetArrayValue(const Type& data, sizet index)
+		{
+			static ArrayValueType tmp;
+			if(index < GetArraySize(data))
+				return data[index];
+			return tmp;
+		}
+
+		static void SetArrayValue(Type& data, const ArrayValueType& value, sizet index)
+		{
+			if(index < GetArraySize(data))
+				data[index] = value;
+		}
+
+		NODISCARD static sizet Hash(const Type& data)
+		{
+			if constexpr (HashAsBytes)
+				return (sizet)HashBytes(data.data(), data.size() * sizeof(ArrayValueType));
+			else
+				return Impl::HashSequence<ValueCat>(data);
+		}
+
+		NODISCARD static bool Equals(const Type& left, const Type& right)
+		{
+			if constexpr (HashAsBytes)
+				return left.size() == right.size() && memcmp(left.data(), right.data(), left.size() * sizeof(ArrayValueType)) == 0;
+			else
+				return Impl::EqualsSequence<ValueCat>(left, right);
+		}
+	};
+
+	template<class T, sizet N>
+	struct ContainerType<StaticVector<T, N>> : public BaseType<StaticVector<T, N>>
+	{
+		using Type = StaticVector<T, N>;
+		using ArrayValueType = typename Type::value_type;
+		using ValueCat = typename TypeInfo<ArrayValueType>::Type;
+
+		static_assert(!std::is_same_v<ValueCat, void>, "[refl::ContainerType<StaticVector>] Trying to use a Container with not refl value_type!");
+
+		static inline constexpr ssizet StaticSize = sizeof(int64);
+
+		static inline constexpr TypeCategory_t Category = TypeCategory_t::Container;
+
+		/* Contiguous plain elements are hashed and compared as a single block */
+		static inline constexpr bool HashAsBytes = std::is_same_v<ValueCat, PlainType<ArrayValueType>> && Impl::IsBytewiseComparable<ArrayValueType> && !std::is_same_v<ArrayValueType, bool>;
+
+		static TResult<ssizet> ToStream(const Type& data, IStream& stream)
+		{
+			int64 elementCount = data.size();
+			ssizet size = 0;
+			size += stream.Write(&elementCount, sizeof(elementCount));
+
+			auto dynamicSize = GetDynamicSize(data);
+
+			if constexpr(Impl::IsMemcpySerializable<ArrayValueType>)
+			{
+				size += stream.Write(data.data(), dynamicSize);
+			}
+			else
+			{
+				for(const ArrayValueType& elem : data)
+				{
+					TResult<ssizet> res = ValueCat::ToStream(elem, stream);
+					if(res.HasFailed())
+						return res;
+					
+					size += res.GetValue();
+				}
+			}
+			ssizet expectedSize = dynamicSize + StaticSize; 
+			if(size == expectedSize)
+				return Result::CreateSuccess(size);
+			return Result::CreateFailure<ssizet>(Format("[refl::ContainerType<StaticVector>]::ToStream Failure while writing to stream, not all data was written, expected:%" PRIiPTR " obtained:%" PRIiPTR ".", expectedSize, size));
+		}
+
+		static TResult<ssizet> FromStream(Type& data, IStream& stream)
+		{
+			int64 elementCount;
+			ssizet size = 0;
+			size += stream.Read(&elementCount, sizeof(elementCount));
+			if (elementCount < 0 || elementCount > (int64)N)
+				return Result::CreateFailure<ssizet>(Format("[refl::ContainerType<StaticVector>]::FromStream Trying to read %" PRIi64 " elements, but the capacity is %" PRIuPTR ".", elementCount, N));
+
+			data.clear();
+			data.resize(elementCount);
+			int64 dynamicSize = 0;
+			if constexpr(Impl::IsMemcpySerializable<ArrayValueType>)
+			{
+				dynamicSize = elementCount * sizeof(ArrayValueType);
+				size += stream.Read(data.data(), dynamicSize);
+			}
+			else
+			{
+				for(auto it = data.begin(); it != data.end(); ++it)
+				{
+					ArrayValueType elem;
+					TResult<ssizet> res = ValueCat::FromStream(elem, stream);
+					if(res.HasFailed())
+						return res;
+					
+					(*it) = elem;
+					dynamicSize += ValueCat::StaticSize + ValueCat::GetDynamicSize(elem);
+					size += res.GetValue();
+				}
+			}
+			ssizet expectedSize = dynamicSize + StaticSize; 
+			if(size == expectedSize)
+				return Result::CreateSuccess(size);
+			return Result::CreateFailure<ssizet>(Format("[refl::ContainerType<StaticVector>]::FromStream Failure while reading from stream, not all data was read, expected:%" PRIiPTR " obtained:%" PRIiPTR ".", expectedSize, size));
+		}
+
+		static TResult<std::pair<Type, ssizet>> CreateFromStream(IStream& stream)
+		{
+			Type elem;
+			TResult<ssizet> res = FromStream(elem, stream);
+			if (res.HasFailed())
+				return Result::CopyFailure<std::pair<Type, ssizet>, ssizet>(res);
+			return Result::CreateSuccess(std::make_pair(elem, res.GetValue()));
+		}
+
+		static SPtr<cJSON> CreateJSON(const Type& data, StringView name)
+		{
+			cJSON* obj = cJSON_CreateObject();
+			ToJSON(data, obj, name);
+			return SPtr<cJSON>(obj, cJSON_Delete);
+		}
+
+		static cJSON* ToJSON(const Type& data, cJSON* json, StringView name)
+		{
+			cJSON* arr = cJSON_AddArrayToObject(json, name.data());
+			achar buff[128];
+			sizet i = 0;
+			for(const auto& elem : data)
+			{
+				snprintf(buff, ArraySize(buff), "Elem_%" PRIiPTR, i++);
+				cJSON* obj = cJSON_CreateObject();
+				ValueCat::ToJSON(elem, obj, StringView{ buff });
+				cJSON_AddItemToArray(arr, obj);
+			}
+			return arr;
+		}
+		
+		static EmptyResult FromJSON(Type& data, cJSON* json, StringView name)
+		{
+			cJSON* arr = cJSON_GetObjectItemCaseSensitive(json, name.data());
+			if(arr == nullptr)
+				return Result::CreateFailure(Format("[refl::ContainerType<StaticVector>]::FromJSON Couldn't obtain the value from json, the item with name '%s' was not found.", name.data()));
+			if(!cJSON_IsArray(arr))
+				return Result::CreateFailure("[refl::ContainerType<StaticVector>]::FromJSON expected an Array."sv);
+			
+			achar buff[128];
+			auto count = cJSON_GetArraySize(arr);
+			if (count < 0 || (sizet)count > N)
+				return Result::CreateFailure(Format("[refl::ContainerType<StaticVector>]::FromJSON Trying to read %d elements, but the capacity is %" PRIuPTR ".", count, N));
+			data.clear();
+			data.resize(count);
+			for(decltype(count) i = 0; i < count; ++i)
+			{
+				cJSON* item = cJSON_GetArrayItem(arr, i);
+				snprintf(buff, ArraySize(buff), "Elem_%" PRIi32, i);
+				EmptyResult res = ValueCat::FromJSON(data[i], item, StringView{buff});
+				if(res.HasFailed())
+					return res;
+			}
+			return Result::CreateSuccess();
+		}
+
+		static TResult<Type> CreateFromJSON(cJSON* json, StringView name)
+		{
+			Type elem;
+			EmptyResult res = FromJSON(elem, json, name);
+			if (res.HasFailed())
+				return Result::CopyFailure<Type>(res);
+			return Result::CreateSuccess(elem);
+		}
+
+		static String ToString(const Type& data)
+		{
+			SPtr<cJSON> json = CreateJSON(data, TypeInfo<Type>::Name);
+			SPtr<char> jsonStr = SPtr<char>(cJSON_Print(json.get()));
+			return String{ jsonStr.get() };
+		}
+
+		static EmptyResult FromString(const String& str, Type& data)
+		{
+			SPtr<cJSON> json = SPtr<cJSON>(cJSON_Parse(str.c_str()), cJSON_Delete);
+			return FromJSON(data, json.get(), TypeInfo<Type>::Name);
+		}
+
+		static TResult<Type> CreateFromString(const String& str)
+		{
+			Type elem;
+			EmptyResult res = FromString(str, elem);
+			if (res.HasFailed())
+				return Result::CopyFailure<Type>(res);
+			return Result::CreateSuccess(elem);
+		}
+
+#if COMPILER_MSVC
+#pragma warning(push)
+#pragma warning(disable:4702)
+#endif
+		NODISCARD static int64 GetDynamicSize(const Type& data)
+		{
+			if constexpr (Impl::IsMemcpySerializable<ArrayValueType>)
+			{
+				return sizeof(ArrayValueType) * data.size();
+			}
+			int64 size = 0;
+			for(const auto& e : data)
+				size += ValueCat::StaticSize + ValueCat::GetDynamicSize(e);
+			return size;
+		}
+#if COMPILER_MSVC
+#pragma warning(pop)
+#endif
+
+		NODISCARD static sizet GetArraySize(const Type& data)
+		{
+			return data.size();
+		}
+
+		static void SetArraySize(Type& data, sizet size)
+		{
+			data.resize(Min(size, N));
+		}
+
+		NODISCARD static const ArrayValueType& GetArrayValue(const Type& data, sizet index)
+		{
+			static ArrayValueType tmp;
+			if(index < GetArraySize(data))
+				return data[index];
+			return tmp;
+		}
+
+		static void SetArrayValue(Type& data, const ArrayValueType& value, sizet index)
+		{
+			if(index < GetArraySize(data))
+				data[index] = value;
+		}
+
+		NODISCARD static sizet Hash(const Type& data)
+		{
+			if constexpr (HashAsBytes)
+				return (sizet)HashBytes(data.data(), data.size() * sizeof(ArrayValueType));
+			else
+				return Impl::HashSequence<ValueCat>(data);
+		}
+
+		NODISCARD static bool Equals(const Type& left, const Type& right)
+		{
+			if constexpr (HashAsBytes)
+				return left.size() == right.size() && memcmp(left.data(), right.data(), left.size() * sizeof(ArrayValueType)) == 0;
+			else
+				return Impl::EqualsSequence<ValueCat>(left, right);
+		}
 	};
 }
 
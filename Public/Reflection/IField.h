@@ -46,6 +46,8 @@ namespace greaper::refl
 		virtual void SetArraySize(void* complexPtr, sizet size)const = 0;
 		virtual const void* GetArrayValue(const void* complexPtr, sizet index)const = 0;
 		virtual void SetArrayValue(void* complexPtr, const void* value, sizet index)const = 0;
+		virtual sizet Hash(const void* complexPtr)const = 0;
+		virtual bool Equals(const void* leftComplexPtr, const void* rightComplexPtr)const = 0;
 
 
 		NODISCARD INLINE const void* GetValue(const void* complexPtr)const noexcept
@@ -60,6 +62,7 @@ namespace greaper::refl
 				m_SetValueFn(complexPtr, value);
 		}
 		virtual bool IsArray()const noexcept = 0;
+		virtual bool HasFixedSize()const noexcept = 0;
 		virtual ReflectedTypeID_t GetTypeID()const noexcept = 0;
 		NODISCARD INLINE constexpr StringView GetFieldName()const noexcept { return m_FieldName; }
 	};
@@ -84,6 +87,8 @@ namespace greaper::refl
 
 		INLINE ReflectedTypeID_t GetTypeID()const noexcept override { return tInfo::ID; }
 
+		INLINE bool HasFixedSize()const noexcept override { return Impl::HasFixedSerializedSize<Type>::value; }
+
 		INLINE TResult<ssizet> ToStream(const void* complexPtr, IStream& stream)const override
 		{
 			const Type* valuePtr = (const Type*)GetValue(complexPtr);
@@ -179,6 +184,21 @@ namespace greaper::refl
 				return;
 			tInfo::Type::SetArrayValue(*arrPtr, *((const ArrayValueType*)value), index);
 		}
+		NODISCARD INLINE sizet Hash(const void* complexPtr)const override
+		{
+			const Type* valuePtr = (const Type*)GetValue(complexPtr);
+			if(valuePtr == nullptr)
+				return 0ll;
+			return tInfo::Type::Hash(*valuePtr);
+		}
+		NODISCARD INLINE bool Equals(const void* leftComplexPtr, const void* rightComplexPtr)const override
+		{
+			const Type* leftPtr = (const Type*)GetValue(leftComplexPtr);
+			const Type* rightPtr = (const Type*)GetValue(rightComplexPtr);
+			if(leftPtr == nullptr || rightPtr == nullptr)
+				return leftPtr == rightPtr;
+			return tInfo::Type::Equals(*leftPtr, *rightPtr);
+		}
 	};
 }
 
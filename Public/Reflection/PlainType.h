@@ -90,6 +90,12 @@ namespace greaper::refl { \
 		static void SetArrayValue(UNUSED type& data, UNUSED const int32& value, UNUSED sizet index){\
 			Break("[refl::PlainType<"#type">]]::GetArraySize Trying to use a PlainType for array operations!");\
 		}\
+		NODISCARD static sizet Hash(const type& data){\
+			return Impl::HashPlainValue(data);\
+		}\
+		NODISCARD static bool Equals(const type& left, const type& right){\
+			return left == right;\
+		}\
 	};\
 }
 
@@ -174,6 +180,18 @@ namespace greaper::refl
 		{
 			Break("[refl::BaseType<TEnum>]::SetArrayValue Trying to use the generic refl::BaseType!");
 		}
+
+		NODISCARD static sizet Hash(UNUSED const T& data)
+		{
+			Break("[refl::BaseType<TEnum>]::Hash Trying to use the generic refl::BaseType!");
+			return 0ll;
+		}
+
+		NODISCARD static bool Equals(UNUSED const T& left, UNUSED const T& right)
+		{
+			Break("[refl::BaseType<TEnum>]::Equals Trying to use the generic refl::BaseType!");
+			return false;
+		}
 	};
 
 	template<class T>
@@ -277,6 +295,16 @@ namespace greaper::refl
 		{
 			Break("[refl::PlainType<TEnum>]::SetArrayValue Trying to use a PlainType for array operations!");
 		}
+
+		NODISCARD static sizet Hash(const T& data)
+		{
+			return HashObjectBytes(data);
+		}
+
+		NODISCARD static bool Equals(const T& left, const T& right)
+		{
+			return left == right;
+		}
 	};
 
 	template<class First, class Second>
@@ -436,6 +464,16 @@ namespace greaper::refl
 		{
 			Break("[refl::PlainType<std::pair>]::SetArrayValue Trying to use a PlainType for array operations!");
 		}
+
+		NODISCARD static sizet Hash(const Type& data)
+		{
+			return Impl::PairCat<FirstCat, SecondCat>::Hash(data);
+		}
+
+		NODISCARD static bool Equals(const Type& left, const Type& right)
+		{
+			return Impl::PairCat<FirstCat, SecondCat>::Equals(left, right);
+		}
 	};
 }
 
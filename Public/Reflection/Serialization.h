@@ -0,0 +1,75 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef CORE_REFLECTION_SERIALIZATION_H
+#define CORE_REFLECTION_SERIALIZATION_H 1
+
+#include "ComplexType.h"
+#include "../MemoryStream.h"
+
+namespace greaper::refl
+{
+	/**
+	 * @brief Computes the exact amount of bytes that ToStream will write for the given value
+	 */
+	template<class T>
+	NODISCARD INLINE int64 GetSerializedSize(const T& data)
+	{
+		using Cat = typename TypeInfo<T>::Type;
+		if constexpr (Impl::HasFixedSerializedSize<T>::value)
+			return Cat::StaticSize;
+		else
+			return Cat::StaticSize + Cat::GetDynamicSize(data);
+	}
+
+	/**
+	 * @brief Serializes a value at the cursor of a MemoryStream, the stream grows at
+	 * most once before writing, to at least the size needed. The growth is geometric, so
+	 * appending many values stays amortized. Each write still goes through
+	 * MemoryStream::Write and its bounds check.
+	 */
+	template<class T>
+	TResult<ssizet> SerializeToBuffer(const T& data, MemoryStream& stream)
+	{
+		using Cat = typename TypeInfo<T>::Type;
+		const int64 size = GetSerializedSize(data);
+		const int64 needed = stream.Tell() + size;
+		if (needed > stream.Size())
+			stream.Reserve((sizet)Max(needed, (int64)(stream.Size() + (stream.Size() >> 1))));
+
+		TResult<ssizet> res = Cat::ToStream(data, stream);
+		if (res.HasFailed())
+			return res;
+		if (res.GetValue() != size)
+			return Result::CreateFailure<ssizet>(Format("[refl::SerializeToBuffer]<%s> Serialized size mismatch, expected:%" PRIi64 " obtained:%" PRIiPTR ".", TypeInfo<T>::Name.data(), size, res.GetValue()));
+		return res;
+	}
+
+	/**
+	 * @brief Serializes a value into a new buffer, the size is computed in a single
+	 * traversal and the buffer is allocated once at that exact size, so it's never
+	 * reallocated. Each write still goes through MemoryStream::Write and its bounds check,
+	 * a value writing more than computed is truncated and reported as a size mismatch.
+	 */
+	template<class T>
+	TResult<Vector<uint8>> SerializeToBuffer(const T& data)
+	{
+		using Cat = typename TypeInfo<T>::Type;
+		const int64 size = GetSerializedSize(data);
+		Vector<uint8> buffer((sizet)size);
+		MemoryStream stream(buffer.data(), buffer.size());
+
+		TResult<ssizet> res = Cat::ToStream(data, stream);
+		if (res.HasFailed())
+			return Result::CopyFailure<Vector<uint8>>(res);
+		if (res.GetValue() != size)
+			return Result::CreateFailure<Vector<uint8>>(Format("[refl::SerializeToBuffer]<%s> Serialized size mismatch, expected:%" PRIi64 " obtained:%" PRIiPTR ".", TypeInfo<T>::Name.data(), size, res.GetValue()));
+		return Result::CreateSuccess(std::move(buffer));
+	}
+}
+
+#endif /* CORE_REFLECTION_SERIALIZATION_H */
@@ -88,5 +88,15 @@ namespace greaper::refl
 			{
 				Break("[refl::PlainType<Uuid>]::SetArrayValue Trying to use a PlainType for array operations!");
 			}
+
+			NODISCARD static sizet Hash(const Uuid& data)
+			{
+				return std::hash<Uuid>()(data);
+			}
+
+			NODISCARD static bool Equals(const Uuid& left, const Uuid& right)
+			{
+				return left == right;
+			}
 		};
 	}
\ No newline at end of file
@@ -0,0 +1,120 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef CORE_STD_CONSOLE_H
+#define CORE_STD_CONSOLE_H 1
+
+#include "ICommandManager.h"
+#include "IThreadManager.h"
+#include "Base/IThread.h"
+#if PLT_WINDOWS
+#include "Win/WinConsoleIO.h"
+#else
+#include "Lnx/LnxConsoleIO.h"
+#endif
+
+namespace greaper
+{
+	/*** Console over the standard input and output of the process
+	*	A dedicated thread waits on stdin and stdout, every complete line read is split
+	*	into views over the input buffer and, unless a ReadFromConsole is waiting for it,
+	*	sent to ICommandManager::HandleCommandAsync as a command. All the lines of a read
+	*	are sent at once, their failures are written back once they finish.
+	*	WriteToConsole only appends to a bounded buffer, which the console thread flushes
+	*	at a limited rate, when the buffer is full the new output is dropped and counted,
+	*	so a busy console never stalls the caller.
+	*/
+	class StdConsole final : public IConsole
+	{
+	public:
+		static constexpr sizet InputBufferSize = 4096;
+		static constexpr sizet MaxBufferedOutput = 256 * 1024;
+		static constexpr sizet OutputBytesPerSecond = 256 * 1024;
+		static constexpr sizet OutputBurstSize = 32 * 1024;
+
+		template<class _Alloc_ = GenericAllocator>
+		static TResult<SPtr<StdConsole>> Create(WThreadManager threadMgr, WPtr<ICommandManager> commandMgr)noexcept;
+
+		~StdConsole()noexcept;
+
+		StdConsole(const StdConsole&) = delete;
+		StdConsole& operator=(const StdConsole&) = delete;
+
+		// Also callable from a ConsoleEvent handler, the console thread then stops once it returns
+		void Stop()noexcept;
+
+		NODISCARD bool IsRunning()const noexcept;
+
+		ConsoleType_t GetConsoleType()const noexcept override { return ConsoleType_t::EXTERNAL; }
+
+		void WriteToConsole(const String& msg)noexcept override;
+
+		// The next line read is given to the future instead of being run as a command
+		std::future<String> ReadFromConsole()noexcept override;
+
+		// Triggered from the console thread with every line read
+		ConsoleEvt_t* GetConsoleEvent()const noexcept override { return &m_ConsoleEvent; }
+
+		void SetCursorPosition(std::pair<int16, int16> position)noexcept override;
+
+		// Last position set, the terminal is not queried
+		std::pair<int16, int16> GetCursorPosition()noexcept override;
+
+		// Bytes of output dropped because the buffer was full
+		NODISCARD sizet GetDroppedOutput()const noexcept;
+
+	private:
+		struct PendingCommand
+		{
+			String CommandName;
+			std::future<EmptyResult> Result;
+		};
+
+		WPtr<ICommandManager> m_CommandManager;
+		OSConsoleIO m_IO;
+		std::atomic_bool m_Running;
+		PThread m_Thread;
+		mutable ConsoleEvt_t m_ConsoleEvent;
+
+		// Only touched by the console thread
+		char m_Input[InputBufferSize];
+		sizet m_InputSize = 0;
+		bool m_DiscardingLine = false;
+		Vector<PendingCommand> m_PendingCommands;
+
+		mutable Mutex m_ReadMutex;
+		Deque<std::promise<String>> m_ReadRequests;
+
+		mutable Mutex m_OutputMutex;
+		String m_Output;
+		sizet m_OutputOffset = 0;
+		sizet m_DroppedOutput = 0;
+		sizet m_ReportedDroppedOutput = 0;
+		std::pair<int16, int16> m_CursorPosition{ 0, 0 };
+
+		StdConsole(WPtr<ICommandManager> commandMgr)noexcept;
+
+		EmptyResult Start(WThreadManager threadMgr)noexcept;
+
+		void Run()noexcept;
+
+		void ProcessInput()noexcept;
+
+		void HandleLine(StringView line)noexcept;
+
+		void CollectFinishedCommands()noexcept;
+
+		// Writes up to maxSize bytes of the pending output, returns the amount written
+		sizet FlushOutput(sizet maxSize)noexcept;
+
+		NODISCARD bool HasPendingOutput()const noexcept;
+	};
+}
+
+#include "Base/StdConsole.inl"
+
+#endif /* CORE_STD_CONSOLE_H */
@@ -560,6 +560,30 @@ namespace greaper::StringUtils
 		return rtn;
 	}
 
+	/**
+	 * @brief Joins a SmallVector of strings into a single string with a given separator
+	 *
+	 * @tparam T Type of char, auto deducted from vec and separator
+	 * @tparam _Alloca_ The Allocator of the Strings inside the vector
+	 * @tparam N The inline capacity of the vector
+	 * @tparam _VAlloca_ The Allocator of the vector
+	 * @param vec Vector of strings to compose into one
+	 * @param separator The character that will be between the strings (NULL/0) no in-between character
+	 * @return BasicString<T, _Alloca_> The string composed from all the strings in the vector
+	 */
+	template<typename T, class _Alloca_, sizet N, class _VAlloca_>
+	BasicString<T, _Alloca_> ComposeString(const SmallVector<BasicString<T, _Alloca_>, N, _VAlloca_>& vec, T separator = T(0)) noexcept
+	{
+		BasicString<T, _Alloca_> rtn;
+		for (sizet i = 0; i < vec.size(); ++i)
+		{
+			if (i != 0 && separator != T(0))
+				rtn += separator;
+			rtn += vec[i];
+		}
+		return rtn;
+	}
+
 	/**
 	 * @brief Joins a vector of string into a single string with a given separator
 	 *
@@ -0,0 +1,99 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef CORE_THREAD_LOCAL_H
+#define CORE_THREAD_LOCAL_H 1
+
+#include "IThreadManager.h"
+#include "IApplication.h"
+#include "Base/IThread.h"
+
+namespace greaper
+{
+	namespace Impl
+	{
+		// ThreadLocal instances used by the calling thread, keyed by ThreadLocal, keys are never reused
+		NODISCARD FlatMap<uint64, void*>& GetThreadLocalCache()noexcept;
+
+		NODISCARD uint64 NextThreadLocalKey()noexcept;
+	}
+
+	/*** Per thread instance of T, tracked by a registry
+	*	Each thread gets its own instance the first time it calls Get, made by the factory or
+	*	default constructed. The instances of the threads created through the ThreadManager
+	*	are destroyed from the thread itself as it finishes, through the ThreadDestructionEvent,
+	*	the rest live until Reset is called from their thread or the ThreadLocal is destroyed.
+	*	ForEach and Aggregate visit the instances of every thread, the owners keep using theirs
+	*	meanwhile, so anything read from other threads must be synchronized by T, i.e. atomics.
+	*	The ThreadLocal must outlive every thread that keeps using it.
+	*/
+	template<class T>
+	class ThreadLocal
+	{
+	public:
+		using Factory_t = std::function<T()>;
+
+		explicit ThreadLocal(WThreadManager threadMgr, Factory_t factory = nullptr)noexcept;
+
+		~ThreadLocal()noexcept;
+
+		ThreadLocal(const ThreadLocal&) = delete;
+		ThreadLocal& operator=(const ThreadLocal&) = delete;
+
+		// Instance of the calling thread, constructed on its first call
+		NODISCARD T& Get()noexcept;
+
+		// Instance of the calling thread, nullptr if it hasn't been constructed yet
+		NODISCARD T* TryGet()noexcept;
+
+		// Destroys the instance of the calling thread, the next Get constructs it again
+		void Reset()noexcept;
+
+		NODISCARD sizet GetInstanceCount()const noexcept;
+
+		/**
+		 * @brief Calls fn with the instance of every thread, while the registry is locked
+		 *
+		 * The lock keeps the finishing threads from destroying their instances meanwhile, so fn
+		 * must not use this ThreadLocal, a Get from a thread without an instance would deadlock.
+		 */
+		void ForEach(const std::function<void(ThreadID_t, T&)>& fn)noexcept;
+
+		void ForEach(const std::function<void(ThreadID_t, const T&)>& fn)const noexcept;
+
+		// Folds every instance into init, i.e. summing per thread counters, op runs like the ForEach callbacks
+		template<class TAcc, class BinaryOp>
+		NODISCARD TAcc Aggregate(TAcc init, BinaryOp op)const noexcept;
+
+	private:
+		const uint64 m_Key;
+		Factory_t m_Factory;
+		WThreadManager m_ThreadManager;
+
+		mutable RWMutex m_InstancesMutex;
+		FlatMap<ThreadID_t, T*> m_Instances;
+
+		IThreadManager::ThreadCreationEvent_t::HandlerType m_OnThreadCreation;
+		IThreadManager::ThreadDestructionEvent_t::HandlerType m_OnThreadDestruction;
+		IInterface::ActivationEvt_t::HandlerType m_OnManagerActivation;
+		IApplication::OnInterfaceActivationEvent_t::HandlerType m_OnNewManager;
+
+		T& CreateInstance()noexcept;
+
+		void RemoveInstance(ThreadID_t id)noexcept;
+
+		void ConnectToManager(const PThreadManager& threadMgr)noexcept;
+
+		void OnManagerActivation(bool active, IInterface* oldInterface, const PInterface& newInterface)noexcept;
+
+		void OnNewManager(const PInterface& newInterface)noexcept;
+	};
+}
+
+#include "Base/ThreadLocal.inl"
+
+#endif /* CORE_THREAD_LOCAL_H */
@@ -44,12 +44,35 @@ namespace greaper
 		void FromString(const String& str) noexcept;
 
 		/**
-		 * @brief Requests to the OS a random Uuid
+		 * @brief Generates a random Uuid (RFC-4122 version 4) from a generator of the calling thread
+		 * 
+		 * The generator is seeded from the OS the first time a thread uses it, and again
+		 * on the child of a fork, afterwards no system calls are made.
 		 * 
 		 * @return Uuid The new random Uuid 
 		 */
 		NODISCARD static Uuid GenerateRandom() noexcept;
 
+		/**
+		 * @brief Requests to the OS a random Uuid, slower than GenerateRandom
+		 * 
+		 * @return Uuid The new random Uuid 
+		 */
+		NODISCARD static Uuid GenerateRandomFromOS() noexcept;
+
+		/**
+		 * @brief Generates a time ordered Uuid (RFC-4122 version 7), the first 48 bits are
+		 * the unix time in milliseconds and the rest come from the generator of GenerateRandom
+		 * 
+		 * The ones generated by the same thread are strictly increasing, so they sort by creation.
+		 * 
+		 * @return Uuid The new time ordered Uuid 
+		 */
+		NODISCARD static Uuid GenerateTimeOrdered() noexcept;
+
+		// Only meaningful for the Uuids that follow RFC-4122, 4 for GenerateRandom and 7 for GenerateTimeOrdered
+		NODISCARD constexpr uint8 GetVersion()const noexcept;
+
 		constexpr bool IsEmpty()const noexcept;
 		constexpr const uint32* GetData()const noexcept;
 		
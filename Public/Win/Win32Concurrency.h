@@ -252,6 +252,57 @@ ResumeThread(
 	HANDLE hThread
 );
 
+#define THREAD_PRIORITY_LOWEST          (-2)
+#define THREAD_PRIORITY_BELOW_NORMAL    (-1)
+#define THREAD_PRIORITY_NORMAL          0
+#define THREAD_PRIORITY_HIGHEST         2
+#define THREAD_PRIORITY_ABOVE_NORMAL    1
+#define THREAD_PRIORITY_TIME_CRITICAL   15
+#define THREAD_PRIORITY_IDLE            (-15)
+
+WINBASEAPI
+BOOL
+WINAPI
+SetThreadPriority(
+	HANDLE hThread,
+	int nPriority
+);
+
+WINBASEAPI
+BOOL
+WINAPI
+WaitOnAddress(
+	volatile VOID* Address,
+	PVOID CompareAddress,
+	SIZE_T AddressSize,
+	DWORD dwMilliseconds
+);
+
+WINBASEAPI
+VOID
+WINAPI
+WakeByAddressSingle(
+	PVOID Address
+);
+
+WINBASEAPI
+VOID
+WINAPI
+WakeByAddressAll(
+	PVOID Address
+);
+
+WINBASEAPI
+BOOL
+WINAPI
+GetThreadTimes(
+	HANDLE hThread,
+	LPFILETIME lpCreationTime,
+	LPFILETIME lpExitTime,
+	LPFILETIME lpKernelTime,
+	LPFILETIME lpUserTime
+);
+
 #ifndef _INC_PROCESS
 
 typedef unsigned(__stdcall* _beginthreadex_proc_type)(void*);
@@ -0,0 +1,189 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef CORE_WIN32_CONSOLE_H
+#define CORE_WIN32_CONSOLE_H 1
+
+#include "Win32Base.h"
+
+#if WIN32_USE_GREAPER_HEADERS
+
+extern "C" {
+#if COMPILER_MSVC
+#pragma warning(push)
+#pragma warning(disable : 4201)
+#endif
+typedef struct _COORD {
+	SHORT X;
+	SHORT Y;
+} COORD, * PCOORD;
+
+typedef struct _KEY_EVENT_RECORD {
+	BOOL bKeyDown;
+	WORD wRepeatCount;
+	WORD wVirtualKeyCode;
+	WORD wVirtualScanCode;
+	union {
+		WCHAR UnicodeChar;
+		CHAR   AsciiChar;
+	} uChar;
+	DWORD dwControlKeyState;
+} KEY_EVENT_RECORD, * PKEY_EVENT_RECORD;
+
+typedef struct _MOUSE_EVENT_RECORD {
+	COORD dwMousePosition;
+	DWORD dwButtonState;
+	DWORD dwControlKeyState;
+	DWORD dwEventFlags;
+} MOUSE_EVENT_RECORD, * PMOUSE_EVENT_RECORD;
+
+typedef struct _WINDOW_BUFFER_SIZE_RECORD {
+	COORD dwSize;
+} WINDOW_BUFFER_SIZE_RECORD, * PWINDOW_BUFFER_SIZE_RECORD;
+
+typedef struct _MENU_EVENT_RECORD {
+	UINT dwCommandId;
+} MENU_EVENT_RECORD, * PMENU_EVENT_RECORD;
+
+typedef struct _FOCUS_EVENT_RECORD {
+	BOOL bSetFocus;
+} FOCUS_EVENT_RECORD, * PFOCUS_EVENT_RECORD;
+
+typedef struct _INPUT_RECORD {
+	WORD EventType;
+	union {
+		KEY_EVENT_RECORD KeyEvent;
+		MOUSE_EVENT_RECORD MouseEvent;
+		WINDOW_BUFFER_SIZE_RECORD WindowBufferSizeEvent;
+		MENU_EVENT_RECORD MenuEvent;
+		FOCUS_EVENT_RECORD FocusEvent;
+	} Event;
+} INPUT_RECORD, * PINPUT_RECORD;
+#if COMPILER_MSVC
+#pragma warning(pop)
+#endif
+
+#define KEY_EVENT         0x0001
+
+#define FILE_TYPE_UNKNOWN   0x0000
+#define FILE_TYPE_DISK      0x0001
+#define FILE_TYPE_CHAR      0x0002
+#define FILE_TYPE_PIPE      0x0003
+
+#define ERROR_HANDLE_EOF                 38L
+#define ERROR_BROKEN_PIPE                109L
+
+typedef struct _OVERLAPPED* LPOVERLAPPED;
+
+WINBASEAPI
+HANDLE
+WINAPI
+GetStdHandle(
+	DWORD nStdHandle
+);
+
+WINBASEAPI
+DWORD
+WINAPI
+GetFileType(
+	HANDLE hFile
+);
+
+WINBASEAPI
+BOOL
+WINAPI
+GetConsoleMode(
+	HANDLE hConsoleHandle,
+	LPDWORD lpMode
+);
+
+WINBASEAPI
+BOOL
+WINAPI
+GetNumberOfConsoleInputEvents(
+	HANDLE hConsoleInput,
+	LPDWORD lpNumberOfEvents
+);
+
+WINBASEAPI
+BOOL
+WINAPI
+ReadConsoleInputW(
+	HANDLE hConsoleInput,
+	PINPUT_RECORD lpBuffer,
+	DWORD nLength,
+	LPDWORD lpNumberOfEventsRead
+);
+
+WINBASEAPI
+BOOL
+WINAPI
+PeekNamedPipe(
+	HANDLE hNamedPipe,
+	LPVOID lpBuffer,
+	DWORD nBufferSize,
+	LPDWORD lpBytesRead,
+	LPDWORD lpTotalBytesAvail,
+	LPDWORD lpBytesLeftThisMessage
+);
+
+WINBASEAPI
+BOOL
+WINAPI
+ReadFile(
+	HANDLE hFile,
+	LPVOID lpBuffer,
+	DWORD nNumberOfBytesToRead,
+	LPDWORD lpNumberOfBytesRead,
+	LPOVERLAPPED lpOverlapped
+);
+
+WINBASEAPI
+BOOL
+WINAPI
+WriteFile(
+	HANDLE hFile,
+	LPCVOID lpBuffer,
+	DWORD nNumberOfBytesToWrite,
+	LPDWORD lpNumberOfBytesWritten,
+	LPOVERLAPPED lpOverlapped
+);
+
+WINBASEAPI
+HANDLE
+WINAPI
+CreateEventW(
+	LPSECURITY_ATTRIBUTES lpEventAttributes,
+	BOOL bManualReset,
+	BOOL bInitialState,
+	LPCWSTR lpName
+);
+
+WINBASEAPI
+BOOL
+WINAPI
+SetEvent(
+	HANDLE hEvent
+);
+
+WINBASEAPI
+DWORD
+WINAPI
+WaitForMultipleObjects(
+	DWORD nCount,
+	CONST HANDLE* lpHandles,
+	BOOL bWaitAll,
+	DWORD dwMilliseconds
+);
+
+}
+
+#else
+
+#endif
+
+#endif /* CORE_WIN32_CONSOLE_H */
@@ -0,0 +1,254 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef CORE_WIN_CONSOLE_IO_H
+#define CORE_WIN_CONSOLE_IO_H 1
+
+#include "../PHAL.h"
+#include "Win32Console.h"
+
+namespace greaper
+{
+	/*** Standard input and output of the process, multiplexed with WaitForMultipleObjects
+	*	Wait blocks on an auto-reset event, so Wake can interrupt it from any thread, and on
+	*	the console input when stdin is a console. Console input is read as key events, so
+	*	nothing blocks until Enter, the line is edited and echoed here and given to Read once
+	*	it's complete. Pipes can't be waited on, they are polled with PeekNamedPipe, and files
+	*	are always readable. stdout can't be waited on either, it's always reported as writable.
+	*/
+	class WinConsoleIO
+	{
+		// Interval at which a redirected stdin is polled
+		static constexpr int32 PipePollMS = 20;
+		static constexpr sizet MaxEditedLine = 4096;
+
+		HANDLE m_WakeEvent = nullptr;
+		HANDLE m_Input = nullptr;
+		HANDLE m_Output = nullptr;
+		DWORD m_InputType = FILE_TYPE_UNKNOWN;
+		bool m_InputIsConsole = false;
+		bool m_InputClosed = false;
+
+		// Only used with console input, the line being typed and the finished lines not read yet
+		String m_EditedLine;
+		String m_ReadyInput;
+		WCHAR m_HighSurrogate = 0;
+
+		INLINE void Echo(const char* text, sizet size)noexcept
+		{
+			DWORD written = 0;
+			WriteFile(m_Output, text, (DWORD)size, &written, nullptr);
+		}
+
+		INLINE void EditLine(WCHAR ch)noexcept
+		{
+			if (ch == L'\r' || ch == L'\n')
+			{
+				Echo("\r\n", 2);
+				m_ReadyInput.append(m_EditedLine);
+				m_ReadyInput.push_back('\n');
+				m_EditedLine.clear();
+				return;
+			}
+			if (ch == L'\b')
+			{
+				if (m_EditedLine.empty())
+					return;
+				// Removes a whole UTF-8 sequence
+				while (m_EditedLine.size() > 1 && (m_EditedLine.back() & 0xC0) == 0x80)
+					m_EditedLine.pop_back();
+				m_EditedLine.pop_back();
+				Echo("\b \b", 3);
+				return;
+			}
+			if (ch < 0x20 && ch != L'\t')
+				return;
+
+			WCHAR utf16[2];
+			int utf16Size = 0;
+			if (ch >= 0xD800 && ch <= 0xDBFF)
+			{
+				m_HighSurrogate = ch; // Comes with the next key event
+				return;
+			}
+			if (ch >= 0xDC00 && ch <= 0xDFFF)
+			{
+				if (m_HighSurrogate == 0)
+					return;
+				utf16[utf16Size++] = m_HighSurrogate;
+			}
+			m_HighSurrogate = 0;
+			utf16[utf16Size++] = ch;
+
+			char utf8[4];
+			const auto size = WideCharToMultiByte(CP_UTF8, 0, utf16, utf16Size, utf8, (int)sizeof(utf8), nullptr, nullptr);
+			if (size <= 0 || m_EditedLine.size() + (sizet)size > MaxEditedLine)
+				return;
+			m_EditedLine.append(utf8, (sizet)size);
+			Echo(utf8, (sizet)size);
+		}
+
+		INLINE void ProcessConsoleInput()noexcept
+		{
+			DWORD count = 0;
+			if (GetNumberOfConsoleInputEvents(m_Input, &count) == FALSE || count == 0)
+				return;
+
+			INPUT_RECORD records[64];
+			if (ReadConsoleInputW(m_Input, records, Min(count, (DWORD)64), &count) == FALSE)
+				return;
+
+			for (DWORD i = 0; i < count; ++i)
+			{
+				const auto& record = records[i];
+				// Mouse, focus and key release events signal the input too, they are dropped
+				if (record.EventType != KEY_EVENT || record.Event.KeyEvent.bKeyDown == FALSE)
+					continue;
+				const auto ch = record.Event.KeyEvent.uChar.UnicodeChar;
+				if (ch == 0)
+					continue; // Keys without a character, i.e. arrows
+				for (WORD repeat = 0; repeat < Max(record.Event.KeyEvent.wRepeatCount, (WORD)1); ++repeat)
+					EditLine(ch);
+			}
+		}
+
+		NODISCARD INLINE bool PipeHasInput()const noexcept
+		{
+			DWORD available = 0;
+			if (PeekNamedPipe(m_Input, nullptr, 0, nullptr, &available, nullptr) == FALSE)
+				return true; // The pipe was closed, Read reports it
+			return available > 0;
+		}
+
+	public:
+		static constexpr sizet MaxAtomicWrite = 4096;
+
+		WinConsoleIO()noexcept = default;
+		WinConsoleIO(const WinConsoleIO&) = delete;
+		WinConsoleIO& operator=(const WinConsoleIO&) = delete;
+
+		INLINE ~WinConsoleIO()noexcept
+		{
+			Close();
+		}
+
+		INLINE EmptyResult Open()noexcept
+		{
+			Close();
+			m_WakeEvent = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+			if (m_WakeEvent == nullptr)
+				return Result::CreateFailure(Format("Couldn't create the wake event, error: %lu.", GetLastError()));
+
+			m_Input = GetStdHandle(STD_INPUT_HANDLE);
+			m_Output = GetStdHandle(STD_OUTPUT_HANDLE);
+			m_InputClosed = m_Input == nullptr || m_Input == INVALID_HANDLE_VALUE;
+			DWORD mode = 0;
+			m_InputIsConsole = !m_InputClosed && GetConsoleMode(m_Input, &mode) != FALSE;
+			m_InputType = m_InputClosed ? FILE_TYPE_UNKNOWN : GetFileType(m_Input);
+			m_EditedLine.clear();
+			m_ReadyInput.clear();
+			m_HighSurrogate = 0;
+			return Result::CreateSuccess();
+		}
+
+		INLINE void Close()noexcept
+		{
+			// The standard handles belong to the process, only the event is closed
+			if (m_WakeEvent != nullptr)
+				CloseHandle(m_WakeEvent);
+			m_WakeEvent = nullptr;
+		}
+
+		NODISCARD INLINE bool IsOpen()const noexcept { return m_WakeEvent != nullptr; }
+
+		/**
+		 * @brief Waits until stdin has data, stdout can be written if wantWrite is set,
+		 * Wake is called or the timeout expires, a negative timeout waits indefinitely.
+		 */
+		INLINE EmptyResult Wait(bool wantWrite, int32 timeoutMS, bool& readable, bool& writable)noexcept
+		{
+			readable = false;
+			writable = wantWrite;
+			// Writes to stdout are never waited for, a pending write doesn't let the wait block
+			if (wantWrite || !m_ReadyInput.empty())
+				timeoutMS = 0;
+
+			const bool pipeInput = !m_InputClosed && !m_InputIsConsole && m_InputType == FILE_TYPE_PIPE;
+			if (pipeInput)
+				timeoutMS = timeoutMS < 0 ? PipePollMS : Min(timeoutMS, PipePollMS);
+			else if (!m_InputClosed && !m_InputIsConsole)
+				timeoutMS = 0; // Files and devices are always readable
+
+			HANDLE handles[2] = { m_WakeEvent, m_Input };
+			const DWORD count = (!m_InputClosed && m_InputIsConsole) ? 2 : 1;
+			const auto ret = WaitForMultipleObjects(count, handles, FALSE, timeoutMS < 0 ? INFINITE : (DWORD)timeoutMS);
+			if (ret == WAIT_FAILED)
+				return Result::CreateFailure(Format("Couldn't wait for the console, error: %lu.", GetLastError()));
+
+			if (m_InputClosed)
+				return Result::CreateSuccess();
+
+			if (m_InputIsConsole)
+			{
+				if (ret == WAIT_OBJECT_0 + 1)
+					ProcessConsoleInput();
+				readable = !m_ReadyInput.empty();
+			}
+			else
+			{
+				readable = pipeInput ? PipeHasInput() : true;
+			}
+			return Result::CreateSuccess();
+		}
+
+		// Returns the amount of bytes read, 0 once stdin is closed and negative on failure
+		INLINE ssizet Read(char* buffer, sizet size)noexcept
+		{
+			if (m_InputIsConsole)
+			{
+				const auto count = Min(size, m_ReadyInput.size());
+				if (count == 0)
+					return -1; // Nothing typed yet, 0 would close the input
+				memcpy(buffer, m_ReadyInput.data(), count);
+				m_ReadyInput.erase(0, count);
+				return (ssizet)count;
+			}
+
+			DWORD read = 0;
+			if (ReadFile(m_Input, buffer, (DWORD)Min(size, (sizet)0xFFFFFFFF), &read, nullptr) == FALSE)
+			{
+				const auto error = GetLastError();
+				if (error != ERROR_BROKEN_PIPE && error != ERROR_HANDLE_EOF)
+					return -1;
+				read = 0;
+			}
+			if (read == 0)
+				m_InputClosed = true; // It would be reported as readable forever
+			return (ssizet)read;
+		}
+
+		INLINE ssizet Write(const char* data, sizet size)noexcept
+		{
+			DWORD written = 0;
+			if (WriteFile(m_Output, data, (DWORD)Min(size, MaxAtomicWrite), &written, nullptr) == FALSE)
+				return -1;
+			return (ssizet)written;
+		}
+
+		NODISCARD INLINE bool IsInputClosed()const noexcept { return m_InputClosed; }
+
+		INLINE void Wake()noexcept
+		{
+			if (m_WakeEvent != nullptr)
+				SetEvent(m_WakeEvent);
+		}
+	};
+
+	using OSConsoleIO = WinConsoleIO;
+}
+
+#endif /* CORE_WIN_CONSOLE_IO_H */
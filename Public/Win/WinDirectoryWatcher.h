@@ -0,0 +1,46 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef CORE_WIN_DIRECTORY_WATCHER_H
+#define CORE_WIN_DIRECTORY_WATCHER_H 1
+
+#include "../PHAL.h"
+#include <filesystem>
+
+namespace greaper
+{
+	/*** Directory watching is not implemented on Windows yet
+	*	Open always fails, so the ConfigWatcher cannot be created.
+	*/
+	class WinDirectoryWatcher
+	{
+	public:
+		WinDirectoryWatcher()noexcept = default;
+		WinDirectoryWatcher(const WinDirectoryWatcher&) = delete;
+		WinDirectoryWatcher& operator=(const WinDirectoryWatcher&) = delete;
+
+		INLINE EmptyResult Open(UNUSED const std::filesystem::path& directory)noexcept
+		{
+			return Result::CreateFailure("Directory watching is not supported on Windows yet."sv);
+		}
+
+		INLINE void Close()noexcept { /* No-op */ }
+
+		NODISCARD INLINE bool IsOpen()const noexcept { return false; }
+
+		INLINE EmptyResult Wait(UNUSED Vector<String>& fileNames, UNUSED int32 timeoutMS)noexcept
+		{
+			return Result::CreateFailure("Directory watching is not supported on Windows yet."sv);
+		}
+
+		INLINE void Wake()noexcept { /* No-op */ }
+	};
+
+	using OSDirectoryWatcher = WinDirectoryWatcher;
+}
+
+#endif /* CORE_WIN_DIRECTORY_WATCHER_H */
@@ -25,7 +25,8 @@ namespace greaper
 		IInterface::ActivationEvt_t::HandlerType m_OnManagerActivation;
 		IApplication::OnInterfaceActivationEvent_t::HandlerType m_OnNewManager;
 		//PThread m_This;
-		Barrier m_Barier;
+		Gate m_StartGate;
+		String m_StartError;
 
 		static INLINE unsigned STDCALL RunFn(void* data)
 		{
@@ -37,23 +38,24 @@ namespace greaper
 			if (winThread == nullptr)
 				return EXIT_FAILURE;
 
-			if(!winThread->m_Manager.expired())
-			{
-				auto mgr = winThread->m_Manager.lock();
-				mgr->GetThreadCreationEvent().Trigger(winThread);
-			}
+			winThread->m_StartGate.Wait();
 
-			while (winThread->GetState() != ThreadState_t::RUNNING)
-				THREAD_YIELD();
-
-			winThread->m_Barier.sync();
+			// Discarded threads finish without being announced
+			const bool started = winThread->m_ThreadFn != nullptr;
+			if (started)
+			{
+				if (!winThread->m_Manager.expired())
+				{
+					auto mgr = winThread->m_Manager.lock();
+					mgr->GetThreadCreationEvent().Trigger(winThread);
+				}
 
-			if(winThread->m_ThreadFn != nullptr)
 				winThread->m_ThreadFn();
+			}
 
 			winThread->m_State = ThreadState_t::STOPPED;
 
-			if (!winThread->m_Manager.expired())
+			if (started && !winThread->m_Manager.expired())
 			{
 				auto mgr = winThread->m_Manager.lock();
 				mgr->GetThreadDestructionEvent().Trigger(winThread);
@@ -160,6 +162,27 @@ namespace greaper
 			m_OnNewManager.Disconnect();
 		}
 
+		// Windows has no scheduling policies, they and the nice value are mapped to relative priorities
+		static INLINE int GetNativePriority(const ThreadScheduling& scheduling)noexcept
+		{
+			switch (scheduling.Policy)
+			{
+			case ThreadSchedPolicy_t::Idle: return THREAD_PRIORITY_IDLE;
+			case ThreadSchedPolicy_t::FIFO:
+			case ThreadSchedPolicy_t::RoundRobin: return scheduling.Priority >= 50 ? THREAD_PRIORITY_TIME_CRITICAL : THREAD_PRIORITY_HIGHEST;
+			default: break;
+			}
+			if (scheduling.NiceValue >= 10)
+				return THREAD_PRIORITY_LOWEST;
+			if (scheduling.NiceValue > 0 || scheduling.Policy == ThreadSchedPolicy_t::Batch)
+				return THREAD_PRIORITY_BELOW_NORMAL;
+			if (scheduling.NiceValue <= -10)
+				return THREAD_PRIORITY_HIGHEST;
+			if (scheduling.NiceValue < 0)
+				return THREAD_PRIORITY_ABOVE_NORMAL;
+			return THREAD_PRIORITY_NORMAL;
+		}
+
 	public:
 		INLINE WinThreadImpl(WThreadManager manager, PThread self, const ThreadConfig& config)noexcept
 			:m_Manager(std::move(manager))
@@ -170,7 +193,6 @@ namespace greaper
 			,m_JoinsAtDestruction(config.JoinAtDestruction)
 			,m_Name(config.Name)
 			//,m_This(std::move(self))
-			,m_Barier(2)
 		{
 			if (m_Manager.expired() || m_ThreadFn == nullptr)
 			{
@@ -189,21 +211,32 @@ namespace greaper
 				const auto& wlib = mgr->GetLibrary();
 				VerifyNot(wlib.expired(), "Something went wrong trying to create a WinThread.");
 				auto lib = wlib.lock();
-				lib->LogError(
-					Format("Trying to create a thread named '%s', but something went wrong '%s'.", m_Name.c_str(), strerror(errno))
-				);
+				m_StartError = Format("Trying to create a thread named '%s', but something went wrong '%s'.", m_Name.c_str(), strerror(errno));
+				lib->LogError(m_StartError);
 				return;
 			}
 
-			SetName();
-
 			m_Handle = reinterpret_cast<HANDLE>(hnd);
-			if (!config.StartSuspended)
-				m_State = ThreadState_t::RUNNING;
+
+			const auto priority = GetNativePriority(config.Scheduling);
+			if (priority != THREAD_PRIORITY_NORMAL && !SetThreadPriority(m_Handle, priority))
+			{
+				m_StartError = Format("Trying to set the priority of the thread '%s', but something went wrong, error:'%d'.", m_Name.c_str(), (int32)GetLastError());
+				Discard();
+				return;
+			}
+
+			SetName();
 
 			auto mgr = m_Manager.lock();
 			mgr->GetActivationEvent().Connect(m_OnManagerActivation, [this](bool active, IInterface* oldManager, const PInterface& newManager) { OnManagerActivation(active, oldManager, newManager); });
-			m_Barier.sync();
+
+			// The thread doesn't need to be waited, it only waits for the gate to be opened
+			if (!config.StartSuspended)
+			{
+				m_State = ThreadState_t::RUNNING;
+				m_StartGate.Open();
+			}
 		}
 
 		INLINE WinThreadImpl(WThreadManager manager, ThreadHandle handle, ThreadID_t id, StringView name, bool setName = false)
@@ -300,7 +333,18 @@ namespace greaper
 
 			ResumeThread(m_Handle);
 			m_State = ThreadState_t::RUNNING;
-			m_Barier.sync();
+			m_StartGate.Open();
+		}
+
+		// A suspended thread finishes without running its function
+		INLINE void Discard()noexcept
+		{
+			if (GetState() != ThreadState_t::SUSPENDED)
+				return;
+
+			m_ThreadFn = nullptr;
+			m_JoinsAtDestruction = false;
+			Resume();
 		}
 
 		INLINE ThreadID_t GetID()const noexcept  { return m_ID; }
@@ -310,5 +354,37 @@ namespace greaper
 		INLINE const String& GetName()const noexcept  { return m_Name; }
 
 		INLINE ThreadState_t GetState()const noexcept  { return (ThreadState_t)m_State.load(); }
+
+		// Whether the thread was created with the requested configuration
+		INLINE EmptyResult GetStartResult()const noexcept
+		{
+			if (m_StartError.empty())
+				return Result::CreateSuccess();
+			return Result::CreateFailure(m_StartError);
+		}
+
+		/**
+		 * @brief Queries the user and system time of the thread, with GetThreadTimes precision.
+		 * The context switches and the last CPU are not given by Windows, so they are left unknown.
+		 */
+		INLINE TResult<ThreadStats> GetStats()const noexcept
+		{
+			if (GetState() == ThreadState_t::STOPPED)
+				return Result::CreateFailure<ThreadStats>(Format("Trying to get the stats of the thread '%s', but it has already stopped.", m_Name.c_str()));
+
+			FILETIME creationTime, exitTime, kernelTime, userTime;
+			if (!GetThreadTimes(m_Handle, &creationTime, &exitTime, &kernelTime, &userTime))
+				return Result::CreateFailure<ThreadStats>(Format("Trying to get the times of the thread '%s', but something went wrong, error:'%d'.", m_Name.c_str(), (int32)GetLastError()));
+
+			// FILETIME counts in 100 nanosecond intervals
+			const auto toNanoseconds = [](const FILETIME& time) { return std::chrono::nanoseconds((((uint64)time.dwHighDateTime << 32) | time.dwLowDateTime) * 100); };
+			ThreadStats stats;
+			stats.ID = m_ID;
+			stats.Name = m_Name;
+			stats.UserTime = toNanoseconds(userTime);
+			stats.SystemTime = toNanoseconds(kernelTime);
+			stats.CPUTime = stats.UserTime + stats.SystemTime;
+			return Result::CreateSuccess(stats);
+		}
 	};
 }
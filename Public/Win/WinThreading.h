@@ -10,6 +10,9 @@
 
 #include "../CorePrerequisites.h"
 #include "Win32Concurrency.h"
+#include <atomic>
+
+#pragma comment(lib, "Synchronization.lib")
 
 namespace greaper
 {
@@ -239,6 +242,24 @@ namespace greaper
 			}
 		};
 		using SignalImpl = WinSignalImpl;
+
+		struct WinAddressWaitImpl
+		{
+			// Blocks while the value at the address equals expected, it may return spuriously
+			INLINE static void Wait(const std::atomic<uint32>& value, uint32 expected) noexcept
+			{
+				WaitOnAddress((volatile VOID*)&value, &expected, sizeof(expected), INFINITE);
+			}
+			INLINE static void WakeOne(std::atomic<uint32>& value) noexcept
+			{
+				WakeByAddressSingle((PVOID)&value);
+			}
+			INLINE static void WakeAll(std::atomic<uint32>& value) noexcept
+			{
+				WakeByAddressAll((PVOID)&value);
+			}
+		};
+		using AddressWaitImpl = WinAddressWaitImpl;
 	}
 }
 